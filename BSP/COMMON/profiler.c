@@ -0,0 +1,142 @@
+#include "profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// 探针名称，与ProfilerProbeId_t顺序一致
+static const char *const probe_name[PROFILER_PROBE_COUNT] = {
+    "Uart_DataProcess",
+    "Key_Proc",
+    "Matrix_Key_Scan",
+    "PID_Compute",
+    "Vision_Filter",
+};
+
+static ProfilerProbe_t probe_table[PROFILER_PROBE_COUNT];
+// 两次连续读取计数器之间的周期数，记录时扣除
+static uint32_t profiler_overhead = 0;
+
+/**
+ * @brief 初始化：使能DWT周期计数器，测量探针本身的开销，清空统计
+ */
+void Profiler_Init(void)
+{
+    // 调度器的任务执行时间统计也使用该计数器，关闭探针时同样使能
+#ifdef PROFILER_USE_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+#if PROFILER_ENABLE
+    uint32_t start = PROFILER_GET_CYCLES();
+    profiler_overhead = PROFILER_GET_CYCLES() - start;
+#endif
+    Profiler_Reset();
+}
+
+/**
+ * @brief 清空所有探针的统计
+ */
+void Profiler_Reset(void)
+{
+#if PROFILER_ENABLE
+    PROFILER_ENTER_CRITICAL();
+    memset(probe_table, 0, sizeof(probe_table));
+    for (uint8_t i = 0; i < PROFILER_PROBE_COUNT; i++) {
+        probe_table[i].min = UINT32_MAX;
+    }
+    PROFILER_EXIT_CRITICAL();
+#endif
+}
+
+/**
+ * @brief 记录一次执行的周期数，由PROFILER_END调用
+ *        同一探针只应在一个上下文（主循环或某个中断）中记录
+ * @param id 探针编号
+ * @param cycles 周期数（含探针开销，内部扣除）
+ */
+void Profiler_Record(ProfilerProbeId_t id, uint32_t cycles)
+{
+    if (id >= PROFILER_PROBE_COUNT) {
+        return;
+    }
+    ProfilerProbe_t *probe = &probe_table[id];
+
+    cycles = (cycles > profiler_overhead) ? cycles - profiler_overhead : 0;
+    probe->count++;
+    probe->sum += cycles;
+    if (cycles < probe->min) {
+        probe->min = cycles;
+    }
+    if (cycles > probe->max) {
+        probe->max = cycles;
+    }
+
+    // 档位为log2(cycles)，0和1周期都计入第0档
+    uint32_t bin = 31U - (uint32_t)PROFILER_CLZ(cycles | 1U);
+    if (bin >= PROFILER_HIST_BINS) {
+        bin = PROFILER_HIST_BINS - 1;
+    }
+    probe->hist[bin]++;
+}
+
+/**
+ * @brief 复制一个探针的统计（关中断，与中断中的记录不冲突）
+ * @param id 探针编号
+ * @param probe 输出
+ * @return true 成功，false 编号无效或未启用
+ */
+bool Profiler_GetProbe(ProfilerProbeId_t id, ProfilerProbe_t *probe)
+{
+#if PROFILER_ENABLE
+    if (id >= PROFILER_PROBE_COUNT || probe == NULL) {
+        return false;
+    }
+    PROFILER_ENTER_CRITICAL();
+    *probe = probe_table[id];
+    PROFILER_EXIT_CRITICAL();
+    return true;
+#else
+    (void)id;
+    (void)probe;
+    return false;
+#endif
+}
+
+/**
+ * @brief 打印所有探针的统计：次数、最小/平均/最大周期数（及微秒）和非零的直方图档位
+ */
+void Profiler_Print(void)
+{
+#if PROFILER_ENABLE
+    uint32_t cycles_per_us = PROFILER_CYCLES_PER_US;
+    if (cycles_per_us == 0) {
+        cycles_per_us = 1;
+    }
+
+    printf("=== Profiler (cycles, %lu/us) ===\r\n", (unsigned long)cycles_per_us);
+    for (uint8_t i = 0; i < PROFILER_PROBE_COUNT; i++) {
+        ProfilerProbe_t probe;
+        Profiler_GetProbe((ProfilerProbeId_t)i, &probe);
+        if (probe.count == 0) {
+            printf("%s: -\r\n", probe_name[i]);
+            continue;
+        }
+
+        uint32_t mean = (uint32_t)(probe.sum / probe.count);
+        printf("%s: n=%lu min=%lu mean=%lu max=%lu (max %lu.%02luus)\r\n", probe_name[i],
+               (unsigned long)probe.count, (unsigned long)probe.min, (unsigned long)mean,
+               (unsigned long)probe.max, (unsigned long)(probe.max / cycles_per_us),
+               (unsigned long)(probe.max % cycles_per_us * 100U / cycles_per_us));
+        printf("  hist:");
+        for (uint8_t bin = 0; bin < PROFILER_HIST_BINS; bin++) {
+            if (probe.hist[bin] != 0) {
+                printf(" %lu:%lu", 1UL << bin, (unsigned long)probe.hist[bin]);
+            }
+        }
+        printf("\r\n");
+    }
+#else
+    printf("Profiler disabled\r\n");
+#endif
+}
@@ -0,0 +1,76 @@
+/**
+ * @file profiler.h
+ * @author Shiki
+ * @brief 基于DWT周期计数器的热点函数耗时统计
+ *        在函数首尾放置PROFILER_BEGIN(id)/PROFILER_END(id)，记录每次执行的CPU周期数，
+ *        按探针统计次数、最小/最大/平均值和以2为底的对数直方图，Profiler_Print()通过printf(USART2)输出
+ *        （按键S9或串口2的HOST_CMD_PROFILER_DUMP指令触发）。
+ *        PROFILER_ENABLE为0时所有探针宏为空，不产生任何代码。
+ *        主机上测试统计逻辑时，在包含本文件前定义PROFILER_GET_CYCLES()、PROFILER_CLZ(x)、
+ *        PROFILER_ENTER_CRITICAL()/PROFILER_EXIT_CRITICAL()和PROFILER_CYCLES_PER_US，替换DWT和CMSIS实现。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef PROFILER_ENABLE
+#define PROFILER_ENABLE 1
+#endif
+
+// 周期计数器和临界区，默认使用DWT->CYCCNT和PRIMASK
+#ifndef PROFILER_GET_CYCLES
+#include "main.h"
+#define PROFILER_USE_DWT 1
+#define PROFILER_GET_CYCLES() (DWT->CYCCNT)
+#define PROFILER_CLZ(x) __CLZ(x)
+#define PROFILER_ENTER_CRITICAL()               \
+    uint32_t profiler_primask = __get_PRIMASK(); \
+    __disable_irq()
+#define PROFILER_EXIT_CRITICAL() __set_PRIMASK(profiler_primask)
+#define PROFILER_CYCLES_PER_US (SystemCoreClock / 1000000U)
+#endif
+
+#define PROFILER_HIST_BINS 20  // 直方图档数：第i档为[2^i, 2^(i+1))周期，最后一档包含更大的值
+
+// 探针编号，增加探针时同时在profiler.c的名称表中添加
+typedef enum {
+    PROFILER_PROBE_UART_PROCESS = 0,  // Uart_DataProcess（TIM6中断）
+    PROFILER_PROBE_KEY_PROC,          // Key_Proc
+    PROFILER_PROBE_KEY_SCAN,          // Matrix_Key_Scan
+    PROFILER_PROBE_PID_COMPUTE,       // PID_Compute/PID_ComputeDt
+    PROFILER_PROBE_VISION_FILTER,     // Uart_DataProcess中一次坐标滤波（中值/卡尔曼，见S3）
+    PROFILER_PROBE_COUNT
+} ProfilerProbeId_t;
+
+typedef struct {
+    uint32_t count;                    // 执行次数
+    uint32_t min;                      // 最小周期数
+    uint32_t max;                      // 最大周期数
+    uint64_t sum;                      // 周期数之和
+    uint32_t hist[PROFILER_HIST_BINS];  // 对数直方图
+} ProfilerProbe_t;
+
+#if PROFILER_ENABLE
+// 同一函数中同一探针只能使用一次；函数有多个出口时需在每个return前调用PROFILER_END
+#define PROFILER_BEGIN(id) uint32_t profiler_start_##id = PROFILER_GET_CYCLES()
+#define PROFILER_END(id) \
+    Profiler_Record(PROFILER_PROBE_##id, PROFILER_GET_CYCLES() - profiler_start_##id)
+#else
+#define PROFILER_BEGIN(id) ((void)0)
+#define PROFILER_END(id) ((void)0)
+#endif
+
+void Profiler_Init(void);
+void Profiler_Reset(void);
+void Profiler_Record(ProfilerProbeId_t id, uint32_t cycles);
+bool Profiler_GetProbe(ProfilerProbeId_t id, ProfilerProbe_t *probe);  // 复制一个探针的统计
+void Profiler_Print(void);
+
+#endif
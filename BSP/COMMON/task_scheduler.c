@@ -16,12 +16,229 @@
  */
 
 #include "task_scheduler.h"
+#include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
+#include "profiler.h"
 
 /* 任务表 */
 static Task_t task_table[MAX_TASKS];
-static uint8_t task_count = 0;
+static uint16_t task_count = 0;
+
+/* 就绪堆：按下次释放时间排序的最小堆，存放任务表索引 */
+static uint16_t task_heap[MAX_TASKS];
+static uint16_t heap_size = 0;
+
+/* 任务表版本号，删除任务导致索引变化时递增 */
+static uint32_t table_generation = 0;
+
+/* 时间源，默认HAL_GetTick；主机仿真时可替换为虚拟时间，调度器和按键、Q3等任务随之加速运行 */
+static TaskTickSource_t tick_source = HAL_GetTick;
+
+/* 统计开始时刻(ms)，用于计算CPU占用率 */
+static uint32_t stats_start_time = 0;
+
+/**
+ * @brief 比较两个任务的释放顺序（考虑tick回绕）
+ * @retval true a应排在b之前
+ */
+static bool TaskHeap_Before(uint16_t a, uint16_t b)
+{
+    int32_t diff = (int32_t)(task_table[a].next_run_time - task_table[b].next_run_time);
+    if (diff != 0) {
+        return diff < 0;
+    }
+    /* 释放时间相同时高优先级在前 */
+    return task_table[a].priority > task_table[b].priority;
+}
+
+/**
+ * @brief 交换堆中两个位置并同步任务的堆索引
+ */
+static void TaskHeap_Swap(uint16_t i, uint16_t j)
+{
+    uint16_t tmp = task_heap[i];
+    task_heap[i] = task_heap[j];
+    task_heap[j] = tmp;
+    task_table[task_heap[i]].heap_index = i;
+    task_table[task_heap[j]].heap_index = j;
+}
+
+static void TaskHeap_SiftUp(uint16_t pos)
+{
+    while (pos > 0) {
+        uint16_t parent = (pos - 1) / 2;
+        if (!TaskHeap_Before(task_heap[pos], task_heap[parent])) {
+            break;
+        }
+        TaskHeap_Swap(pos, parent);
+        pos = parent;
+    }
+}
+
+static void TaskHeap_SiftDown(uint16_t pos)
+{
+    while (1) {
+        uint16_t left = 2 * pos + 1;
+        uint16_t right = left + 1;
+        uint16_t best = pos;
+        if (left < heap_size && TaskHeap_Before(task_heap[left], task_heap[best])) {
+            best = left;
+        }
+        if (right < heap_size && TaskHeap_Before(task_heap[right], task_heap[best])) {
+            best = right;
+        }
+        if (best == pos) {
+            break;
+        }
+        TaskHeap_Swap(pos, best);
+        pos = best;
+    }
+}
+
+/**
+ * @brief 将任务放入就绪堆，已在堆中则按新的释放时间调整位置
+ * @param idx 任务表索引
+ */
+static void TaskHeap_Schedule(uint16_t idx)
+{
+    uint16_t pos = task_table[idx].heap_index;
+    if (pos == TASK_HEAP_INVALID) {
+        pos = heap_size++;
+        task_heap[pos] = idx;
+        task_table[idx].heap_index = pos;
+    }
+    TaskHeap_SiftUp(pos);
+    TaskHeap_SiftDown(task_table[idx].heap_index);
+}
+
+/**
+ * @brief 从就绪堆中移除任务
+ * @param idx 任务表索引
+ */
+static void TaskHeap_Remove(uint16_t idx)
+{
+    uint16_t pos = task_table[idx].heap_index;
+    if (pos == TASK_HEAP_INVALID) {
+        return;
+    }
+    task_table[idx].heap_index = TASK_HEAP_INVALID;
+    heap_size--;
+    if (pos == heap_size) {
+        return;
+    }
+    /* 用堆尾元素填补空位后重新调整 */
+    task_heap[pos] = task_heap[heap_size];
+    task_table[task_heap[pos]].heap_index = pos;
+    TaskHeap_SiftUp(pos);
+    TaskHeap_SiftDown(task_table[task_heap[pos]].heap_index);
+}
+
+/**
+ * @brief 弹出堆顶任务
+ * @retval 任务表索引
+ */
+static uint16_t TaskHeap_Pop(void)
+{
+    uint16_t idx = task_heap[0];
+    TaskHeap_Remove(idx);
+    return idx;
+}
+
+/**
+ * @brief 根据任务表重建就绪堆（删除任务后索引变化时使用）
+ */
+static void TaskHeap_Rebuild(void)
+{
+    heap_size = 0;
+    for (uint16_t i = 0; i < task_count; i++) {
+        task_table[i].heap_index = TASK_HEAP_INVALID;
+    }
+    for (uint16_t i = 0; i < task_count; i++) {
+        if (task_table[i].enabled) {
+            TaskHeap_Schedule(i);
+        }
+    }
+}
+
+/**
+ * @brief 清零一个任务的运行统计
+ */
+static void TaskStats_Clear(TaskStats_t *stats)
+{
+    memset(stats, 0, sizeof(TaskStats_t));
+    stats->late_min = UINT32_MAX;
+}
+
+/**
+ * @brief 记录一次执行
+ * @param task 任务
+ * @param late 释放延迟(ms)
+ * @param cycles 执行周期数
+ */
+static void TaskStats_Record(Task_t *task, uint32_t late, uint32_t cycles)
+{
+    TaskStats_t *stats = &task->stats;
+    stats->run_count++;
+    stats->exec_last = cycles;
+    stats->exec_total += cycles;
+    if (cycles > stats->exec_max) {
+        stats->exec_max = cycles;
+    }
+    if (late < stats->late_min) {
+        stats->late_min = late;
+    }
+    if (late > stats->late_max) {
+        stats->late_max = late;
+    }
+    stats->late_total += late;
+    /* 执行时间超过周期 */
+    if ((uint64_t)cycles > (uint64_t)task->period * 1000U * PROFILER_CYCLES_PER_US) {
+        stats->exec_overruns++;
+    }
+}
+
+/**
+ * @brief 周期数转换为微秒
+ */
+static uint32_t TaskStats_CyclesToUs(uint64_t cycles)
+{
+    uint32_t cycles_per_us = PROFILER_CYCLES_PER_US;
+    return (uint32_t)(cycles / ((cycles_per_us != 0) ? cycles_per_us : 1U));
+}
+
+/**
+ * @brief 任务CPU占用率（0.01%），统计时长为0时返回0
+ */
+static uint32_t TaskStats_Utilization(const TaskStats_t *stats, uint32_t elapsed_ms)
+{
+    if (elapsed_ms == 0) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)TaskStats_CyclesToUs(stats->exec_total) * 10U / elapsed_ms);
+}
+
+/**
+ * @brief 小端写入
+ */
+static uint8_t *TaskStats_Put16(uint8_t *p, uint32_t value)
+{
+    if (value > UINT16_MAX) {
+        value = UINT16_MAX;
+    }
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+}
+
+static uint8_t *TaskStats_Put32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+    return p + 4;
+}
 
 /**
  * @brief 初始化任务调度器
@@ -32,6 +249,9 @@ HAL_StatusTypeDef TaskScheduler_Init(void)
     /* 清空任务表 */
     memset(task_table, 0, sizeof(task_table));
     task_count = 0;
+    heap_size = 0;
+    table_generation++;
+    stats_start_time = tick_source();
     return HAL_OK;
 }
 
@@ -50,7 +270,7 @@ HAL_StatusTypeDef TaskScheduler_AddTask(TaskFunction_t function, uint32_t period
         return HAL_ERROR;
     }
     /* 检查任务名称是否重复 */
-    for (uint8_t i = 0; i < task_count; i++) {
+    for (uint16_t i = 0; i < task_count; i++) {
         if (strcmp(task_table[i].taskName, name) == 0) {
             return HAL_ERROR; /* 任务名称重复 */
         }
@@ -59,10 +279,16 @@ HAL_StatusTypeDef TaskScheduler_AddTask(TaskFunction_t function, uint32_t period
     task_table[task_count].task_function = function;
     task_table[task_count].period = period;
     task_table[task_count].last_run_time = 0;
+    /* 从添加时刻起经过一个周期首次释放 */
+    task_table[task_count].next_run_time = tick_source() + period;
     task_table[task_count].priority = priority;
     task_table[task_count].state = TASK_READY;
     task_table[task_count].enabled = 1;
+    task_table[task_count].heap_index = TASK_HEAP_INVALID;
     task_table[task_count].taskName = name;
+    TaskStats_Clear(&task_table[task_count].stats);
+
+    TaskHeap_Schedule(task_count);
 
     task_count++;
     return HAL_OK;
@@ -70,34 +296,61 @@ HAL_StatusTypeDef TaskScheduler_AddTask(TaskFunction_t function, uint32_t period
 
 /**
  * @brief 任务调度器主循环
+ *        一次调用中执行所有已到期的任务，按优先级从高到低依次执行
  */
 void TaskScheduler_Run(void)
 {
-    uint32_t current_time = HAL_GetTick();
-    Task_t *ready_task = NULL;
-    TaskPriority_t highest_priority = TASK_PRIORITY_IDLE;
-    /* 查找最高优先级的就绪任务 */
-    for (uint8_t i = 0; i < task_count; i++) {
-        if (task_table[i].enabled && task_table[i].state == TASK_READY) {
-            /* 检查任务是否到达执行时间 */
-            if ((current_time - task_table[i].last_run_time) >= task_table[i].period) {
-                /* 选择优先级最高的任务 */
-                if (task_table[i].priority > highest_priority) {
-                    highest_priority = task_table[i].priority;
-                    ready_task = &task_table[i];
-                }
-            }
+    uint32_t current_time = tick_source();
+    uint16_t ready_list[MAX_TASKS];
+    uint16_t ready_count = 0;
+
+    /* 从堆顶取出所有已到期的任务，O(k log n) */
+    while (heap_size > 0 &&
+           (int32_t)(current_time - task_table[task_heap[0]].next_run_time) >= 0) {
+        uint16_t idx = TaskHeap_Pop();
+        /* 插入排序：优先级高的在前，同优先级保持释放时间顺序 */
+        uint16_t pos = ready_count++;
+        while (pos > 0 && task_table[ready_list[pos - 1]].priority < task_table[idx].priority) {
+            ready_list[pos] = ready_list[pos - 1];
+            pos--;
         }
+        ready_list[pos] = idx;
     }
-    /* 执行选中的任务 */
-    if (ready_task != NULL) {
-        ready_task->state = TASK_RUNNING;
-        ready_task->last_run_time = current_time;
+
+    uint32_t generation = table_generation;
+    for (uint16_t i = 0; i < ready_count; i++) {
+        Task_t *task = &task_table[ready_list[i]];
+        /* 本轮中被其他任务挂起的任务不再执行 */
+        if (!task->enabled) {
+            continue;
+        }
+        /* 释放延迟：同一轮中排在后面的任务要等前面的任务执行完 */
+        uint32_t late = tick_source() - task->next_run_time;
+        /* 先计算下次释放时间，落后超过一个周期时不补发，计为错过释放 */
+        task->next_run_time += task->period;
+        if ((int32_t)(current_time - task->next_run_time) >= 0) {
+            task->next_run_time = current_time + task->period;
+            task->stats.deadline_misses++;
+        }
+        task->state = TASK_RUNNING;
+        task->last_run_time = current_time;
         /* 执行任务函数 */
-        if (ready_task->task_function != NULL) {
-            ready_task->task_function();
+        uint32_t start_cycles = PROFILER_GET_CYCLES();
+        if (task->task_function != NULL) {
+            task->task_function();
+        }
+        uint32_t cycles = PROFILER_GET_CYCLES() - start_cycles;
+        /* 任务中删除了其他任务，索引已失效，堆已重建，剩余任务留到下一轮 */
+        if (generation != table_generation) {
+            break;
+        }
+        TaskStats_Record(task, late, cycles);
+        if (task->state == TASK_RUNNING) {
+            task->state = TASK_READY;
+        }
+        if (task->enabled) {
+            TaskHeap_Schedule(ready_list[i]);
         }
-        ready_task->state = TASK_READY;
     }
 }
 
@@ -109,10 +362,11 @@ void TaskScheduler_SuspendTask(const char* taskName)
 {
     if (taskName == NULL) return;
     
-    for (uint8_t i = 0; i < task_count; i++) {
+    for (uint16_t i = 0; i < task_count; i++) {
         if (strcmp(task_table[i].taskName, taskName) == 0) {
             task_table[i].enabled = 0;
             task_table[i].state = TASK_SUSPENDED;
+            TaskHeap_Remove(i);
             break;
         }
     }
@@ -126,11 +380,13 @@ void TaskScheduler_ResumeTask(const char* taskName)
 {
     if (taskName == NULL) return;
     
-    for (uint8_t i = 0; i < task_count; i++) {
+    for (uint16_t i = 0; i < task_count; i++) {
         if (strcmp(task_table[i].taskName, taskName) == 0) {
             task_table[i].enabled = 1;
             task_table[i].state = TASK_READY;
-            task_table[i].last_run_time = HAL_GetTick(); /* 重置执行时间 */
+            task_table[i].last_run_time = tick_source(); /* 重置执行时间 */
+            task_table[i].next_run_time = task_table[i].last_run_time + task_table[i].period;
+            TaskHeap_Schedule(i);
             break;
         }
     }
@@ -144,16 +400,19 @@ void TaskScheduler_DeleteTask(const char* taskName)
 {
     if (taskName == NULL) return;
     
-    for (uint8_t i = 0; i < task_count; i++) {
+    for (uint16_t i = 0; i < task_count; i++) {
         if (strcmp(task_table[i].taskName, taskName) == 0) {
             /* 将后面的任务前移 */
-            for (uint8_t j = i; j < task_count - 1; j++) {
+            for (uint16_t j = i; j < task_count - 1; j++) {
                 task_table[j] = task_table[j + 1];
             }
             task_count--;
             
             /* 清空最后一个任务 */
             memset(&task_table[task_count], 0, sizeof(Task_t));
+            /* 索引已变化，重建就绪堆 */
+            table_generation++;
+            TaskHeap_Rebuild();
             break;
         }
     }
@@ -165,29 +424,48 @@ void TaskScheduler_DeleteTask(const char* taskName)
  */
 uint32_t TaskScheduler_GetSystemTick(void)
 {
-    return HAL_GetTick();
+    return tick_source();
+}
+
+/**
+ * @brief 设置调度器时间源
+ * @param source: 返回毫秒计数的函数，NULL恢复为HAL_GetTick
+ * @note  切换时间源后已有任务的释放时间不变，应在添加任务前设置
+ */
+void TaskScheduler_SetTickSource(TaskTickSource_t source)
+{
+    tick_source = (source != NULL) ? source : HAL_GetTick;
 }
 
 /**
  * @brief 获取任务数量
  * @retval 当前任务数量
  */
-uint8_t TaskScheduler_GetTaskCount(void)
+uint16_t TaskScheduler_GetTaskCount(void)
 {
     return task_count;
 }
 
 /**
  * @brief 打印任务信息（调试用）
+ *        执行时间单位为us，释放延迟单位为ms，抖动 = 最大释放延迟 - 最小释放延迟
  */
 void TaskScheduler_PrintTaskInfo(void)
 {
+    uint32_t elapsed = tick_source() - stats_start_time;
+    uint32_t total_util = 0;
+
     printf("=== Task Scheduler Info ===\r\n");
     printf("Total Tasks: %d/%d\r\n", task_count, MAX_TASKS);
-    printf("Current Tick: %lu\r\n", HAL_GetTick());
+    printf("Current Tick: %lu\r\n", tick_source());
+    printf("Stats Window: %lu ms\r\n", elapsed);
     printf("------------------------\r\n");
     
-    for (uint8_t i = 0; i < task_count; i++) {
+    for (uint16_t i = 0; i < task_count; i++) {
+        const TaskStats_t *stats = &task_table[i].stats;
+        uint32_t util = TaskStats_Utilization(stats, elapsed);
+        total_util += util;
+
         printf("Task[%d]: %s\r\n", i, task_table[i].taskName);
         printf("  Period: %lu ms\r\n", task_table[i].period);
         printf("  Priority: %d\r\n", task_table[i].priority);
@@ -197,6 +475,85 @@ void TaskScheduler_PrintTaskInfo(void)
                task_table[i].state == TASK_BLOCKED ? "Blocked" : "Suspended");
         printf("  Enabled: %s\r\n", task_table[i].enabled ? "Yes" : "No");
         printf("  Last Run: %lu ms\r\n", task_table[i].last_run_time);
+        printf("  Next Run: %lu ms\r\n", task_table[i].next_run_time);
+        if (stats->run_count > 0) {
+            printf("  Runs: %lu, Deadline Misses: %lu, Exec Overruns: %lu\r\n",
+                   stats->run_count, stats->deadline_misses, stats->exec_overruns);
+            printf("  Exec: last %lu us, avg %lu us, max %lu us\r\n",
+                   TaskStats_CyclesToUs(stats->exec_last),
+                   TaskStats_CyclesToUs(stats->exec_total / stats->run_count),
+                   TaskStats_CyclesToUs(stats->exec_max));
+            printf("  Release Delay: avg %lu ms, max %lu ms, jitter %lu ms\r\n",
+                   stats->late_total / stats->run_count, stats->late_max,
+                   stats->late_max - stats->late_min);
+            printf("  CPU: %lu.%02lu%%\r\n", util / 100U, util % 100U);
+        }
         printf("------------------------\r\n");
     }
+    printf("Total CPU: %lu.%02lu%%\r\n", total_util / 100U, total_util % 100U);
+}
+
+/**
+ * @brief 清零所有任务的运行统计，重新开始统计时长
+ */
+void TaskScheduler_ResetStats(void)
+{
+    for (uint16_t i = 0; i < task_count; i++) {
+        TaskStats_Clear(&task_table[i].stats);
+    }
+    stats_start_time = tick_source();
+}
+
+/**
+ * @brief 生成二进制统计快照，便于上位机解析
+ *        头部(8字节)：magic, version, 任务数, 记录长度, 统计时长ms(u32)
+ *        记录(26字节)：序号(u8), 使能(u8), 周期ms(u16), 执行次数(u32), 最长执行us(u32),
+ *        平均执行us(u32), 最大释放延迟ms(u16), 抖动ms(u16), 错过释放次数(u16), 执行超时次数(u16),
+ *        CPU占用率0.01%(u16)
+ *        u16字段超出范围时饱和
+ * @param buffer: 输出缓冲区，TASK_STATS_SNAPSHOT_SIZE字节可容纳全部任务
+ * @param size: 缓冲区大小
+ * @retval 写入的字节数，缓冲区不足时只写入能容纳的完整记录，小于头部长度时返回0
+ */
+uint16_t TaskScheduler_GetStatsSnapshot(uint8_t* buffer, uint16_t size)
+{
+    if (buffer == NULL || size < TASK_STATS_HEADER_SIZE) {
+        return 0;
+    }
+
+    /* 记录数和序号为u8，超过255个任务时只导出前255个 */
+    uint16_t count = (task_count < UINT8_MAX) ? task_count : UINT8_MAX;
+    if ((uint16_t)(size - TASK_STATS_HEADER_SIZE) / TASK_STATS_RECORD_SIZE < count) {
+        count = (uint16_t)((size - TASK_STATS_HEADER_SIZE) / TASK_STATS_RECORD_SIZE);
+    }
+    uint32_t elapsed = tick_source() - stats_start_time;
+
+    uint8_t *p = buffer;
+    *p++ = TASK_STATS_MAGIC;
+    *p++ = TASK_STATS_VERSION;
+    *p++ = (uint8_t)count;
+    *p++ = TASK_STATS_RECORD_SIZE;
+    p = TaskStats_Put32(p, elapsed);
+
+    for (uint16_t i = 0; i < count; i++) {
+        const TaskStats_t *stats = &task_table[i].stats;
+        uint32_t avg = (stats->run_count > 0)
+                           ? TaskStats_CyclesToUs(stats->exec_total / stats->run_count)
+                           : 0;
+        uint32_t jitter = (stats->run_count > 0) ? stats->late_max - stats->late_min : 0;
+
+        *p++ = (uint8_t)i;
+        *p++ = task_table[i].enabled;
+        p = TaskStats_Put16(p, task_table[i].period);
+        p = TaskStats_Put32(p, stats->run_count);
+        p = TaskStats_Put32(p, TaskStats_CyclesToUs(stats->exec_max));
+        p = TaskStats_Put32(p, avg);
+        p = TaskStats_Put16(p, stats->late_max);
+        p = TaskStats_Put16(p, jitter);
+        p = TaskStats_Put16(p, stats->deadline_misses);
+        p = TaskStats_Put16(p, stats->exec_overruns);
+        p = TaskStats_Put16(p, TaskStats_Utilization(stats, elapsed));
+    }
+
+    return (uint16_t)(p - buffer);
 }
@@ -41,19 +41,50 @@ typedef enum {
 /* 任务函数类型定义 */
 typedef void (*TaskFunction_t)(void);
 
+/* 时间源函数类型定义，返回毫秒计数 */
+typedef uint32_t (*TaskTickSource_t)(void);
+
+/* 任务运行统计（执行时间以CPU周期计，由PROFILER_GET_CYCLES()测量） */
+typedef struct {
+    uint32_t run_count;            /* 执行次数 */
+    uint32_t exec_last;            /* 上次执行周期数 */
+    uint32_t exec_max;             /* 最长执行周期数 */
+    uint64_t exec_total;           /* 累计执行周期数 */
+    uint32_t late_min;             /* 最小释放延迟(ms)：开始执行时刻 - 释放时刻 */
+    uint32_t late_max;             /* 最大释放延迟(ms) */
+    uint32_t late_total;           /* 累计释放延迟(ms) */
+    uint32_t deadline_misses;      /* 错过释放次数：落后超过一个周期，跳过了至少一次释放 */
+    uint32_t exec_overruns;        /* 执行超时次数：单次执行时间超过周期 */
+} TaskStats_t;
+
 /* 任务控制块 */
 typedef struct {
     TaskFunction_t task_function;  /* 任务函数指针 */
     uint32_t period;               /* 任务执行周期(ms) */
     uint32_t last_run_time;          /* 上次执行时间 */
+    uint32_t next_run_time;        /* 下次释放时间(就绪堆的排序键) */
     TaskPriority_t priority;       /* 任务优先级 */
     TaskState_t state;             /* 任务状态 */
     uint8_t enabled;               /* 任务使能标志 */
+    uint16_t heap_index;           /* 在就绪堆中的位置，TASK_HEAP_INVALID表示不在堆中 */
     const char* taskName;          /* 任务名称 */
+    TaskStats_t stats;             /* 运行统计 */
 } Task_t;
 
-/* 最大任务数量 */
+/* 最大任务数量（不超过65534，堆索引使用uint16_t） */
+#ifndef MAX_TASKS
 #define MAX_TASKS 10
+#endif
+
+/* 任务不在就绪堆中的标记 */
+#define TASK_HEAP_INVALID 0xFFFF
+
+/* 统计快照格式：头部 + 每个任务一条记录，多字节字段均为小端 */
+#define TASK_STATS_MAGIC 0x54          /* 'T' */
+#define TASK_STATS_VERSION 2
+#define TASK_STATS_HEADER_SIZE 8       /* magic, version, 任务数, 记录长度, 统计时长(ms, u32) */
+#define TASK_STATS_RECORD_SIZE 26      /* 见TaskScheduler_GetStatsSnapshot() */
+#define TASK_STATS_SNAPSHOT_SIZE (TASK_STATS_HEADER_SIZE + MAX_TASKS * TASK_STATS_RECORD_SIZE)
 
 /* 任务调度器API */
 HAL_StatusTypeDef TaskScheduler_Init(void);
@@ -64,7 +95,10 @@ void TaskScheduler_SuspendTask(const char* taskName);
 void TaskScheduler_ResumeTask(const char* taskName);
 void TaskScheduler_DeleteTask(const char* taskName);
 uint32_t TaskScheduler_GetSystemTick(void);
-uint8_t TaskScheduler_GetTaskCount(void);
+void TaskScheduler_SetTickSource(TaskTickSource_t source);  // NULL恢复为HAL_GetTick
+uint16_t TaskScheduler_GetTaskCount(void);
 void TaskScheduler_PrintTaskInfo(void);
+void TaskScheduler_ResetStats(void);
+uint16_t TaskScheduler_GetStatsSnapshot(uint8_t* buffer, uint16_t size);
 
 #endif /* __TASK_SCHEDULER_H */
@@ -2,10 +2,15 @@
 
 #include "Emm_V5.h"
 #include "app_tasks.h"
+#include "command.h"
+#include "emm_feedback.h"
+#include "gimbal_motion.h"
 #include "oled_user.h"
+#include "profiler.h"
 #include "stdbool.h"
 #include "stdio.h"
 #include "tim.h"
+#include "uart_log.h"
 #include "uart_user.h"
 #include "usart.h"
 
@@ -15,9 +20,16 @@
  */
 void User_Init(void)
 {
-    // Uart 空闲中断接收使能并关闭 DMA 过半中断
-    HAL_UARTEx_ReceiveToIdle_DMA(&huart2, g_uart_command_buffer, UART_USER_BUFFER_SIZE);
-    __HAL_DMA_DISABLE_IT(&hdma_usart2_rx, DMA_IT_HT);
+    // printf输出缓冲区（USART2 DMA发送）
+    UartLog_Init();
+    // 使能DWT周期计数器，统计热点函数和各任务的执行时间（按键S9打印）
+    Profiler_Init();
+    // Uart 空闲中断 + DMA 循环接收，指令在接收缓冲区中原地解析
+    Command_StartReceive(&huart2);
+    // 初始化云台非阻塞运动接口
+    GimbalMotion_Init();
+    // 启动电机应答接收（USART1 DMA循环接收）
+    EmmFeedback_Init();
     // 初始化定时器
     HAL_TIM_Base_Start_IT(&htim6);  // 启动定时器6中断
     // 初始化应用任务
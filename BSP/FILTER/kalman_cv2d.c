@@ -0,0 +1,253 @@
+#include "kalman_cv2d.h"
+
+#include <string.h>
+
+// 初始化时速度的方差((像素/s)^2)，速度未知
+#define KALMAN_CV2D_VEL_VAR0 250000.0f
+
+#define N KALMAN_CV2D_STATES
+#define M KALMAN_CV2D_MEAS
+
+// 测量矩阵H及其转置，只测量位置
+static const float32_t H_data[M * N] = {
+    1.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 0.0f,
+};
+static const float32_t Ht_data[N * M] = {
+    1.0f, 0.0f,
+    0.0f, 1.0f,
+    0.0f, 0.0f,
+    0.0f, 0.0f,
+};
+
+/**
+ * @brief 浮点坐标转换为像素坐标，限制在uint16_t范围内
+ */
+static uint16_t KalmanCv2d_ToPixel(float32_t value)
+{
+    if (value <= 0.0f) {
+        return 0;
+    }
+    if (value >= 65535.0f) {
+        return 65535;
+    }
+    return (uint16_t)(value + 0.5f);
+}
+
+/**
+ * @brief 以测量值初始化状态，速度为0，协方差取初始值
+ */
+static void KalmanCv2d_Start(KalmanCv2d_t *kf, PixelPoint_t z, uint32_t tick)
+{
+    memset(kf->x, 0, sizeof(kf->x));
+    memset(kf->P, 0, sizeof(kf->P));
+    kf->x[0] = z.x;
+    kf->x[1] = z.y;
+    kf->P[0 * N + 0] = kf->r;
+    kf->P[1 * N + 1] = kf->r;
+    kf->P[2 * N + 2] = KALMAN_CV2D_VEL_VAR0;
+    kf->P[3 * N + 3] = KALMAN_CV2D_VEL_VAR0;
+    kf->innovation = 0.0f;
+    kf->mahalanobis = 0.0f;
+    kf->rejects = 0;
+    kf->last_tick = tick;
+    kf->initialized = true;
+}
+
+/**
+ * @brief 预测：x = F*x，P = F*P*F' + Q
+ * @param dt 距上次更新的时间(s)
+ */
+static void KalmanCv2d_Predict(KalmanCv2d_t *kf, float32_t dt)
+{
+    float32_t F_data[N * N] = {
+        1.0f, 0.0f, dt,   0.0f,
+        0.0f, 1.0f, 0.0f, dt,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f,
+    };
+    float32_t Ft_data[N * N], FP_data[N * N], FPFt_data[N * N], Q_data[N * N] = {0};
+    float32_t xn_data[N];
+    arm_matrix_instance_f32 F, Ft, P, FP, FPFt, Q, X, Xn;
+
+    arm_mat_init_f32(&F, N, N, F_data);
+    arm_mat_init_f32(&Ft, N, N, Ft_data);
+    arm_mat_init_f32(&P, N, N, kf->P);
+    arm_mat_init_f32(&FP, N, N, FP_data);
+    arm_mat_init_f32(&FPFt, N, N, FPFt_data);
+    arm_mat_init_f32(&Q, N, N, Q_data);
+    arm_mat_init_f32(&X, N, 1, kf->x);
+    arm_mat_init_f32(&Xn, N, 1, xn_data);
+
+    // 匀速模型，白噪声加速度的离散过程噪声
+    float32_t q = kf->q;
+    Q_data[0 * N + 0] = Q_data[1 * N + 1] = q * dt * dt * dt / 3.0f;
+    Q_data[0 * N + 2] = Q_data[2 * N + 0] = q * dt * dt / 2.0f;
+    Q_data[1 * N + 3] = Q_data[3 * N + 1] = q * dt * dt / 2.0f;
+    Q_data[2 * N + 2] = Q_data[3 * N + 3] = q * dt;
+
+    arm_mat_mult_f32(&F, &X, &Xn);
+    memcpy(kf->x, xn_data, sizeof(kf->x));
+
+    arm_mat_trans_f32(&F, &Ft);
+    arm_mat_mult_f32(&F, &P, &FP);
+    arm_mat_mult_f32(&FP, &Ft, &FPFt);
+    arm_mat_add_f32(&FPFt, &Q, &P);
+}
+
+/**
+ * @brief 初始化卡尔曼滤波器
+ * @param kf 滤波器指针
+ * @param q 过程噪声（加速度功率谱密度，像素^2/s^3），越大跟随越快
+ * @param r 测量噪声方差(像素^2)，越大越平滑
+ */
+void KalmanCv2d_Init(KalmanCv2d_t *kf, float32_t q, float32_t r)
+{
+    if (kf == NULL) {
+        return;
+    }
+    memset(kf, 0, sizeof(KalmanCv2d_t));
+    kf->q = q;
+    kf->r = r;
+}
+
+/**
+ * @brief 清除状态，下次测量重新初始化
+ */
+void KalmanCv2d_Reset(KalmanCv2d_t *kf)
+{
+    if (kf == NULL) {
+        return;
+    }
+    kf->initialized = false;
+    kf->rejects = 0;
+}
+
+/**
+ * @brief 用一次位置测量更新滤波器
+ * @param kf 滤波器指针
+ * @param z 测量的目标位置
+ * @param tick 测量时刻(ms)
+ * @return true 测量被采用，false 马氏距离超过门限，视为离群测量，只做预测
+ */
+bool KalmanCv2d_Update(KalmanCv2d_t *kf, PixelPoint_t z, uint32_t tick)
+{
+    if (kf == NULL) {
+        return false;
+    }
+
+    uint32_t dt_ms = tick - kf->last_tick;
+    if (!kf->initialized || dt_ms > KALMAN_CV2D_TIMEOUT_MS) {
+        KalmanCv2d_Start(kf, z, tick);
+        return true;
+    }
+    if (dt_ms > 0) {
+        KalmanCv2d_Predict(kf, (float32_t)dt_ms * 0.001f);
+    }
+    kf->last_tick = tick;
+
+    float32_t z_data[M] = {(float32_t)z.x, (float32_t)z.y};
+    float32_t hx_data[M], y_data[M], yt_data[M], pht_data[N * M], s_data[M * M];
+    float32_t s_tmp_data[M * M], s_inv_data[M * M], s_inv_y_data[M], d2_data[1];
+    float32_t k_data[N * M], ky_data[N], xn_data[N], hp_data[M * N], khp_data[N * N];
+    float32_t pn_data[N * N];
+    float32_t R_data[M * M] = {kf->r, 0.0f, 0.0f, kf->r};
+    arm_matrix_instance_f32 H, Ht, X, P, Z, HX, Y, Yt, PHt, S, S_tmp, S_inv, S_inv_Y, D2;
+    arm_matrix_instance_f32 K, KY, Xn, HP, KHP, Pn, R;
+
+    arm_mat_init_f32(&H, M, N, (float32_t *)H_data);
+    arm_mat_init_f32(&Ht, N, M, (float32_t *)Ht_data);
+    arm_mat_init_f32(&X, N, 1, kf->x);
+    arm_mat_init_f32(&P, N, N, kf->P);
+    arm_mat_init_f32(&Z, M, 1, z_data);
+    arm_mat_init_f32(&HX, M, 1, hx_data);
+    arm_mat_init_f32(&Y, M, 1, y_data);
+    arm_mat_init_f32(&Yt, 1, M, yt_data);
+    arm_mat_init_f32(&PHt, N, M, pht_data);
+    arm_mat_init_f32(&S, M, M, s_data);
+    arm_mat_init_f32(&S_tmp, M, M, s_tmp_data);
+    arm_mat_init_f32(&S_inv, M, M, s_inv_data);
+    arm_mat_init_f32(&S_inv_Y, M, 1, s_inv_y_data);
+    arm_mat_init_f32(&D2, 1, 1, d2_data);
+    arm_mat_init_f32(&K, N, M, k_data);
+    arm_mat_init_f32(&KY, N, 1, ky_data);
+    arm_mat_init_f32(&Xn, N, 1, xn_data);
+    arm_mat_init_f32(&HP, M, N, hp_data);
+    arm_mat_init_f32(&KHP, N, N, khp_data);
+    arm_mat_init_f32(&Pn, N, N, pn_data);
+    arm_mat_init_f32(&R, M, M, R_data);
+
+    // 新息y = z - H*x，新息协方差S = H*P*H' + R
+    arm_mat_mult_f32(&H, &X, &HX);
+    arm_mat_sub_f32(&Z, &HX, &Y);
+    arm_mat_mult_f32(&P, &Ht, &PHt);
+    arm_mat_mult_f32(&H, &PHt, &S_tmp);
+    arm_mat_add_f32(&S_tmp, &R, &S);
+
+    // arm_mat_inverse_f32会改写输入矩阵，用副本求逆
+    memcpy(s_tmp_data, s_data, sizeof(s_data));
+    if (arm_mat_inverse_f32(&S_tmp, &S_inv) != ARM_MATH_SUCCESS) {
+        KalmanCv2d_Start(kf, z, tick);
+        return true;
+    }
+
+    // 马氏距离平方d2 = y' * S^-1 * y
+    arm_mat_mult_f32(&S_inv, &Y, &S_inv_Y);
+    arm_mat_trans_f32(&Y, &Yt);
+    arm_mat_mult_f32(&Yt, &S_inv_Y, &D2);
+    kf->mahalanobis = d2_data[0];
+    arm_sqrt_f32(y_data[0] * y_data[0] + y_data[1] * y_data[1], &kf->innovation);
+
+    // 超过门限的测量视为离群，连续多次则认为目标确实跳变
+    if (kf->mahalanobis > KALMAN_CV2D_GATE) {
+        kf->outliers++;
+        if (++kf->rejects > KALMAN_CV2D_MAX_REJECT) {
+            KalmanCv2d_Start(kf, z, tick);
+            return true;
+        }
+        return false;
+    }
+    kf->rejects = 0;
+
+    // 卡尔曼增益K = P*H'*S^-1，x = x + K*y，P = P - K*H*P
+    arm_mat_mult_f32(&PHt, &S_inv, &K);
+    arm_mat_mult_f32(&K, &Y, &KY);
+    arm_mat_add_f32(&X, &KY, &Xn);
+    memcpy(kf->x, xn_data, sizeof(kf->x));
+
+    arm_mat_mult_f32(&H, &P, &HP);
+    arm_mat_mult_f32(&K, &HP, &KHP);
+    arm_mat_sub_f32(&P, &KHP, &Pn);
+    memcpy(kf->P, pn_data, sizeof(kf->P));
+    return true;
+}
+
+/**
+ * @brief 获取滤波后的位置，限制在uint16_t范围内
+ */
+PixelPoint_t KalmanCv2d_GetPosition(const KalmanCv2d_t *kf)
+{
+    PixelPoint_t point = {0, 0};
+    if (kf == NULL || !kf->initialized) {
+        return point;
+    }
+    point.x = KalmanCv2d_ToPixel(kf->x[0]);
+    point.y = KalmanCv2d_ToPixel(kf->x[1]);
+    return point;
+}
+
+/**
+ * @brief 获取滤波后的速度(像素/s)
+ */
+void KalmanCv2d_GetVelocity(const KalmanCv2d_t *kf, float32_t *vx, float32_t *vy)
+{
+    if (kf == NULL) {
+        return;
+    }
+    if (vx != NULL) {
+        *vx = kf->x[2];
+    }
+    if (vy != NULL) {
+        *vy = kf->x[3];
+    }
+}
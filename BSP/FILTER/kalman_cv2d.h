@@ -0,0 +1,47 @@
+/**
+ * @file kalman_cv2d.h
+ * @author Shiki
+ * @brief 二维匀速模型卡尔曼滤波，用于视觉坐标平滑
+ *        状态为[x, y, vx, vy]，测量为[x, y]，矩阵运算使用CMSIS-DSP（arm_mat_*_f32）。
+ *        按马氏距离门限拒绝离群测量，离群时只做预测，比中值滤波少一个采样的延迟。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __KALMAN_CV2D_H
+#define __KALMAN_CV2D_H
+
+#include "arm_math.h"
+#include "laser_shot_common.h"
+
+#define KALMAN_CV2D_STATES 4
+#define KALMAN_CV2D_MEAS 2
+
+#define KALMAN_CV2D_Q 20000.0f       // 过程噪声（加速度功率谱密度，像素^2/s^3）
+#define KALMAN_CV2D_R 4.0f           // 测量噪声方差(像素^2)
+#define KALMAN_CV2D_GATE 13.8f       // 马氏距离平方门限（2自由度卡方分布99.9%）
+#define KALMAN_CV2D_MAX_REJECT 3     // 连续拒绝超过该次数认为目标确实跳变，重新初始化
+#define KALMAN_CV2D_TIMEOUT_MS 300   // 超过该时间没有测量则重新初始化
+
+typedef struct {
+    float32_t x[KALMAN_CV2D_STATES];                       // 状态[x, y, vx, vy]，速度单位像素/s
+    float32_t P[KALMAN_CV2D_STATES * KALMAN_CV2D_STATES];  // 状态协方差
+    float32_t q;                                           // 过程噪声
+    float32_t r;                                           // 测量噪声方差
+    float32_t innovation;   // 最近一次新息的模(像素)
+    float32_t mahalanobis;  // 最近一次新息的马氏距离平方
+    uint32_t last_tick;     // 最近一次更新的时刻(ms)
+    uint32_t outliers;      // 被拒绝的测量数
+    uint8_t rejects;        // 连续拒绝次数
+    bool initialized;       // 是否已用测量初始化
+} KalmanCv2d_t;
+
+void KalmanCv2d_Init(KalmanCv2d_t *kf, float32_t q, float32_t r);
+void KalmanCv2d_Reset(KalmanCv2d_t *kf);
+bool KalmanCv2d_Update(KalmanCv2d_t *kf, PixelPoint_t z, uint32_t tick);  // false为离群测量被拒绝
+PixelPoint_t KalmanCv2d_GetPosition(const KalmanCv2d_t *kf);
+void KalmanCv2d_GetVelocity(const KalmanCv2d_t *kf, float32_t *vx, float32_t *vy);
+
+#endif
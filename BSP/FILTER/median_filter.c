@@ -0,0 +1,159 @@
+#include "median_filter.h"
+
+#include <string.h>
+
+// MAD换算为正态分布标准差的系数
+#define MEDIAN_FILTER_MAD_SCALE 1.4826f
+
+/**
+ * @brief 在有序窗口中二分查找第一个不小于value的位置
+ */
+static uint8_t MedianFilter_LowerBound(const MedianFilter_t *filter, uint16_t value)
+{
+    uint8_t lo = 0, hi = filter->count;
+    while (lo < hi) {
+        uint8_t mid = (uint8_t)((lo + hi) / 2);
+        if (filter->sorted[mid] < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief 从有序窗口中删除一个值为value的样本
+ */
+static void MedianFilter_Remove(MedianFilter_t *filter, uint16_t value)
+{
+    uint8_t pos = MedianFilter_LowerBound(filter, value);
+    memmove(&filter->sorted[pos], &filter->sorted[pos + 1],
+            (filter->count - pos - 1) * sizeof(uint16_t));
+    filter->count--;
+}
+
+/**
+ * @brief 向有序窗口中插入一个样本
+ */
+static void MedianFilter_Insert(MedianFilter_t *filter, uint16_t value)
+{
+    uint8_t pos = MedianFilter_LowerBound(filter, value);
+    memmove(&filter->sorted[pos + 1], &filter->sorted[pos],
+            (filter->count - pos) * sizeof(uint16_t));
+    filter->sorted[pos] = value;
+    filter->count++;
+}
+
+/**
+ * @brief 计算中位数绝对偏差MAD
+ *        有序窗口中中值左侧的偏差向左递增、右侧的偏差向右递增，
+ *        从中值向两侧归并即可按从小到大的顺序得到偏差，取第count/2个，O(w)
+ */
+static uint16_t MedianFilter_Mad(const MedianFilter_t *filter, uint16_t median)
+{
+    int16_t left = (int16_t)(filter->count / 2) - 1;
+    uint8_t right = filter->count / 2;
+    uint16_t dev = 0;
+
+    for (uint8_t k = 0; k <= filter->count / 2; k++) {
+        uint16_t dl = (left >= 0) ? (uint16_t)(median - filter->sorted[left]) : UINT16_MAX;
+        uint16_t dr = (right < filter->count) ? (uint16_t)(filter->sorted[right] - median)
+                                              : UINT16_MAX;
+        if (dl <= dr) {
+            dev = dl;
+            left--;
+        } else {
+            dev = dr;
+            right++;
+        }
+    }
+    return dev;
+}
+
+/**
+ * @brief 初始化滤波器
+ * @param filter 滤波器指针
+ * @param window 窗口大小，奇数，1~MEDIAN_FILTER_MAX_WINDOW
+ * @param hampel true为Hampel离群值替换模式，false为中值滤波
+ * @param hampel_k Hampel门限（MAD的倍数），常用3
+ * @return true 初始化成功，false 参数不合法
+ */
+bool MedianFilter_Init(MedianFilter_t *filter, uint8_t window, bool hampel, float hampel_k)
+{
+    if (filter == NULL || window == 0 || window > MEDIAN_FILTER_MAX_WINDOW || (window % 2) == 0) {
+        return false;
+    }
+    memset(filter, 0, sizeof(MedianFilter_t));
+    filter->window = window;
+    filter->hampel = hampel;
+    filter->hampel_k = hampel_k;
+    return true;
+}
+
+/**
+ * @brief 清空窗口
+ */
+void MedianFilter_Reset(MedianFilter_t *filter)
+{
+    if (filter == NULL) {
+        return;
+    }
+    filter->count = 0;
+    filter->head = 0;
+}
+
+/**
+ * @brief 输入一个样本，返回滤波结果
+ *        窗口未填满时直接返回输入值
+ * @param filter 滤波器指针
+ * @param value 新样本
+ * @return 中值滤波模式返回窗口中值；Hampel模式下离群样本返回中值，否则返回输入值
+ */
+uint16_t MedianFilter_Update(MedianFilter_t *filter, uint16_t value)
+{
+    if (filter == NULL || filter->window == 0) {
+        return value;
+    }
+
+    // 窗口已满时先删除最旧的样本
+    if (filter->count == filter->window) {
+        MedianFilter_Remove(filter, filter->ring[filter->head]);
+    }
+    MedianFilter_Insert(filter, value);
+    filter->ring[filter->head] = value;
+    filter->head = (filter->head + 1) % filter->window;
+
+    if (filter->count < filter->window) {
+        return value;
+    }
+
+    uint16_t median = filter->sorted[filter->count / 2];
+    if (!filter->hampel) {
+        return median;
+    }
+
+    // 偏离中值超过k倍标准差估计（不低于最小门限）的样本替换为中值
+    uint16_t dev = (value > median) ? value - median : median - value;
+    float limit = filter->hampel_k * MEDIAN_FILTER_MAD_SCALE *
+                  (float)MedianFilter_Mad(filter, median);
+    if (limit < MEDIAN_FILTER_HAMPEL_MIN) {
+        limit = MEDIAN_FILTER_HAMPEL_MIN;
+    }
+    if ((float)dev > limit) {
+        filter->replaced++;
+        return median;
+    }
+    return value;
+}
+
+/**
+ * @brief 获取当前窗口的中值，窗口为空时返回0
+ */
+uint16_t MedianFilter_GetMedian(const MedianFilter_t *filter)
+{
+    if (filter == NULL || filter->count == 0) {
+        return 0;
+    }
+    return filter->sorted[filter->count / 2];
+}
@@ -0,0 +1,42 @@
+/**
+ * @file median_filter.h
+ * @author Shiki
+ * @brief 滑动窗口中值滤波 / Hampel离群值替换
+ *        窗口按大小保持有序，每个新样本用二分查找定位，删除最旧样本、插入新样本各一次memmove，
+ *        不再对整个窗口排序；窗口大小在初始化时设置（奇数，最大MEDIAN_FILTER_MAX_WINDOW）。
+ *        Hampel模式下只有偏离中值超过k倍MAD（中位数绝对偏差）的样本被替换为中值，其余样本原样输出，
+ *        没有中值滤波的延迟。窗口中过半样本相同时MAD为0，门限不低于MEDIAN_FILTER_HAMPEL_MIN，
+ *        避免1像素的抖动也被当作离群值。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __MEDIAN_FILTER_H
+#define __MEDIAN_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MEDIAN_FILTER_MAX_WINDOW 15    // 最大窗口大小
+#define MEDIAN_FILTER_HAMPEL_K 3.0f    // Hampel默认门限（MAD的倍数）
+#define MEDIAN_FILTER_HAMPEL_MIN 2.0f  // Hampel最小门限（像素）
+
+typedef struct {
+    uint16_t ring[MEDIAN_FILTER_MAX_WINDOW];    // 按到达顺序保存的样本
+    uint16_t sorted[MEDIAN_FILTER_MAX_WINDOW];  // 按大小排序的样本
+    uint8_t window;                             // 窗口大小
+    uint8_t count;                              // 当前样本数
+    uint8_t head;                               // ring中下一个写入位置（即最旧样本）
+    bool hampel;                                // Hampel模式
+    float hampel_k;                             // Hampel门限（MAD的倍数）
+    uint32_t replaced;                          // Hampel模式下被替换的样本数
+} MedianFilter_t;
+
+bool MedianFilter_Init(MedianFilter_t *filter, uint8_t window, bool hampel, float hampel_k);
+void MedianFilter_Reset(MedianFilter_t *filter);
+uint16_t MedianFilter_Update(MedianFilter_t *filter, uint16_t value);
+uint16_t MedianFilter_GetMedian(const MedianFilter_t *filter);
+
+#endif
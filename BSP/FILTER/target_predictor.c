@@ -0,0 +1,284 @@
+#include "target_predictor.h"
+
+#include <string.h>
+
+#include "aim_calibration.h"
+#include "main.h"
+
+Predictor_t g_target_predictor = {
+    .alpha = PREDICTOR_ALPHA,
+    .beta = PREDICTOR_BETA,
+    .latency_ms = PREDICTOR_LATENCY_MS,
+    .enable = true,
+};
+
+/**
+ * @brief 浮点坐标转换为像素坐标，限制在uint16_t范围内
+ */
+static uint16_t Predictor_ToPixel(float value)
+{
+    if (value <= 0.0f) {
+        return 0;
+    }
+    if (value >= 65535.0f) {
+        return 65535;
+    }
+    return (uint16_t)(value + 0.5f);
+}
+
+/**
+ * @brief 一条命令在开始后elapsed毫秒时已完成的比例（梯形速度曲线）
+ */
+static float Predictor_MotionDone(int32_t elapsed, uint16_t duration_ms, uint16_t ramp_ms)
+{
+    if (elapsed >= (int32_t)duration_ms) {
+        return 1.0f;
+    }
+    float t = (float)elapsed;
+    float total = (float)duration_ms;
+    float ramp = (2U * ramp_ms > duration_ms) ? total * 0.5f : (float)ramp_ms;
+    float span = total - ramp;  // 行程 = 峰值速度 * (总时间 - 加速段时间)
+    if (t < ramp) {
+        return t * t / (2.0f * ramp * span);
+    }
+    if (t <= total - ramp) {
+        return (t - 0.5f * ramp) / span;
+    }
+    return 1.0f - (total - t) * (total - t) / (2.0f * ramp * span);
+}
+
+/**
+ * @brief tick时刻云台位置命令引起的累计图像位移
+ *        各命令按梯形速度曲线计算已转过的脉冲数，按像素-脉冲模型（未标定时为默认模型）换算为像素
+ */
+static void Predictor_MotionShift(const Predictor_t *pred, uint32_t tick, float *dx, float *dy)
+{
+    float clk[2] = {pred->motion_base[0], pred->motion_base[1]};
+    for (uint8_t n = 0; n < pred->motion_count; n++) {
+        const PredictorMotion_t *m = &pred->motion[(pred->motion_head + n) % PREDICTOR_MOTION_LEN];
+        int32_t elapsed = (int32_t)(tick - m->start_tick);
+        if (elapsed <= 0) {
+            continue;
+        }
+        for (uint8_t axis = 0; axis < 2; axis++) {
+            clk[axis] +=
+                (float)m->clk[axis] * Predictor_MotionDone(elapsed, m->duration_ms[axis], m->ramp_ms[axis]);
+        }
+    }
+
+    const float(*k)[2] = g_aim_cal_model.px_per_clk;
+    *dx = k[0][0] * clk[0] + k[0][1] * clk[1];
+    *dy = k[1][0] * clk[0] + k[1][1] * clk[1];
+}
+
+/**
+ * @brief 初始化预测器
+ * @param pred 预测器指针
+ * @param alpha 位置修正系数(0~1]
+ * @param beta 速度修正系数(0~alpha]
+ * @param latency_ms 接收时刻相对测量时刻的固定延迟(ms)
+ */
+void Predictor_Init(Predictor_t *pred, float alpha, float beta, uint16_t latency_ms)
+{
+    if (pred == NULL) {
+        return;
+    }
+    memset(pred, 0, sizeof(Predictor_t));
+    pred->alpha = alpha;
+    pred->beta = beta;
+    pred->latency_ms = latency_ms;
+    pred->enable = true;
+}
+
+/**
+ * @brief 清除估计状态，目标丢失时调用，下次测量重新初始化
+ */
+void Predictor_Reset(Predictor_t *pred)
+{
+    if (pred == NULL) {
+        return;
+    }
+    pred->x = 0.0f;
+    pred->y = 0.0f;
+    pred->vx = 0.0f;
+    pred->vy = 0.0f;
+    pred->samples = 0;
+}
+
+/**
+ * @brief 使能或关闭预测，关闭时Predictor_GetTarget直接返回测量值
+ */
+void Predictor_Enable(Predictor_t *pred, bool enable)
+{
+    if (pred == NULL) {
+        return;
+    }
+    pred->enable = enable;
+    Predictor_Reset(pred);
+}
+
+/**
+ * @brief 记录一条云台位置命令（相对运动），在命令实际发出时调用
+ *        记录已满时最早的一条视为已完成，计入累计脉冲数
+ * @param pred 预测器指针
+ * @param motion 发出时刻、各轴脉冲数（逆时针为正）和预计转动时间
+ */
+void Predictor_AddMotion(Predictor_t *pred, const PredictorMotion_t *motion)
+{
+    if (pred == NULL || motion == NULL) {
+        return;
+    }
+
+    // 预测器在TIM6中断中更新，关中断修改
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (pred->motion_count >= PREDICTOR_MOTION_LEN) {
+        const PredictorMotion_t *oldest = &pred->motion[pred->motion_head];
+        pred->motion_base[0] += (float)oldest->clk[0];
+        pred->motion_base[1] += (float)oldest->clk[1];
+        pred->motion_head = (pred->motion_head + 1) % PREDICTOR_MOTION_LEN;
+        pred->motion_count--;
+    }
+    pred->motion[(pred->motion_head + pred->motion_count) % PREDICTOR_MOTION_LEN] = *motion;
+    pred->motion_count++;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 用一次测量更新位置和速度估计
+ * @param pred 预测器指针
+ * @param point 测量的目标位置
+ * @param rx_tick 数据包接收时刻(ms)，测量时刻 = rx_tick - latency_ms
+ */
+void Predictor_Update(Predictor_t *pred, PixelPoint_t point, uint32_t rx_tick)
+{
+    if (pred == NULL) {
+        return;
+    }
+
+    uint32_t tick = rx_tick - pred->latency_ms;
+    uint32_t dt = tick - pred->last_tick;
+
+    // 减去测量时刻的云台位移，估计的位置和速度只反映目标运动
+    // GimbalMotion可能在USART1发送完成中断中记录新命令，关中断读取
+    float shift_x, shift_y;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Predictor_MotionShift(pred, tick, &shift_x, &shift_y);
+    __set_PRIMASK(primask);
+    float meas_x = (float)point.x - shift_x;
+    float meas_y = (float)point.y - shift_y;
+
+    // 第一次测量或长时间没有测量，直接以测量值初始化
+    if (pred->samples == 0 || dt > PREDICTOR_TIMEOUT_MS) {
+        pred->x = meas_x;
+        pred->y = meas_y;
+        pred->vx = 0.0f;
+        pred->vy = 0.0f;
+        pred->last_tick = tick;
+        pred->samples = 1;
+        return;
+    }
+
+    // 同一时刻到达的多个数据包（同一次轮询中接收）没有时间差，无法估计速度，只修正位置
+    if (dt == 0) {
+        pred->x += pred->alpha * (meas_x - pred->x);
+        pred->y += pred->alpha * (meas_y - pred->y);
+        return;
+    }
+
+    // 第二次测量用差分初始化速度
+    if (pred->samples == 1) {
+        pred->vx = (meas_x - pred->x) / (float)dt;
+        pred->vy = (meas_y - pred->y) / (float)dt;
+        pred->x = meas_x;
+        pred->y = meas_y;
+        pred->last_tick = tick;
+        pred->samples = 2;
+        return;
+    }
+
+    // 按匀速模型预测到测量时刻，再用残差修正位置和速度
+    float pred_x = pred->x + pred->vx * (float)dt;
+    float pred_y = pred->y + pred->vy * (float)dt;
+    float res_x = meas_x - pred_x;
+    float res_y = meas_y - pred_y;
+
+    pred->x = pred_x + pred->alpha * res_x;
+    pred->y = pred_y + pred->alpha * res_y;
+    pred->vx += pred->beta * res_x / (float)dt;
+    pred->vy += pred->beta * res_y / (float)dt;
+    pred->last_tick = tick;
+}
+
+/**
+ * @brief 将目标位置外推到指定时刻
+ * @param pred 预测器指针
+ * @param now 目标时刻(ms)
+ * @param point 预测的目标位置
+ * @return true 预测有效，false 还没有测量或已超时
+ */
+bool Predictor_Predict(const Predictor_t *pred, uint32_t now, PixelPoint_t *point)
+{
+    if (pred == NULL || point == NULL || pred->samples == 0) {
+        return false;
+    }
+
+    uint32_t horizon = now - pred->last_tick;
+    if (horizon > PREDICTOR_TIMEOUT_MS) {
+        return false;
+    }
+    if (horizon > PREDICTOR_MAX_HORIZON_MS) {
+        horizon = PREDICTOR_MAX_HORIZON_MS;
+    }
+
+    // 加上当前时刻的云台位移，包括已发出但还没有反映在测量中的转动
+    float shift_x, shift_y;
+    Predictor_MotionShift(pred, now, &shift_x, &shift_y);
+    point->x = Predictor_ToPixel(pred->x + pred->vx * (float)horizon + shift_x);
+    point->y = Predictor_ToPixel(pred->y + pred->vy * (float)horizon + shift_y);
+    return true;
+}
+
+/**
+ * @brief 获取当前时刻的目标位置
+ *        预测有效时返回外推结果，否则返回g_curr_center_point（未检测到目标时为(0,0)）
+ */
+PixelPoint_t Predictor_GetTarget(void)
+{
+    // 预测器在TIM6中断中更新，关中断复制一份
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Predictor_t pred = g_target_predictor;
+    PixelPoint_t target = g_curr_center_point;
+    __set_PRIMASK(primask);
+
+    if (pred.enable && (target.x != 0 || target.y != 0)) {
+        Predictor_Predict(&pred, HAL_GetTick(), &target);
+    }
+    return target;
+}
+
+/**
+ * @brief 获取目标在图像中的估计速度，已扣除记录的云台位置命令（速度命令不记录，其转动包含在内）
+ * @param vx X方向速度输出(像素/s)
+ * @param vy Y方向速度输出(像素/s)
+ * @return true 速度估计有效，false 预测器关闭、测量不足两次或已超时（输出为0）
+ */
+bool Predictor_GetVelocity(float *vx, float *vy)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Predictor_t pred = g_target_predictor;
+    __set_PRIMASK(primask);
+
+    bool valid = pred.enable && pred.samples >= 2 &&
+                 (HAL_GetTick() - pred.last_tick) <= PREDICTOR_TIMEOUT_MS;
+    if (vx != NULL) {
+        *vx = valid ? pred.vx * 1000.0f : 0.0f;
+    }
+    if (vy != NULL) {
+        *vy = valid ? pred.vy * 1000.0f : 0.0f;
+    }
+    return valid;
+}
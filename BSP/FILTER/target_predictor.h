@@ -0,0 +1,65 @@
+/**
+ * @file target_predictor.h
+ * @author Shiki
+ * @brief 目标位置预测（alpha-beta滤波）
+ *        视觉坐标到达时已经落后于实际位置（相机一帧 + 串口传输 + 最多10ms轮询），
+ *        按测量时刻（接收时刻 - 固定延迟）更新位置和速度估计，再外推到当前时刻供追踪任务使用，
+ *        减少追踪滞后和高增益时的振荡。
+ *        相机随云台转动，图像中的运动包含云台自身的转动：GimbalMotion发出位置命令时调用
+ *        Predictor_AddMotion()记录各轴脉冲数和预计转动时间，按像素-脉冲模型换算为图像位移，
+ *        测量先减去测量时刻的云台位移再估计（速度只反映目标运动），外推时再加上当前时刻的位移，
+ *        已发出但还没有反映在视觉坐标中的转动也计入，避免位置追踪在视觉延迟下过冲振荡。
+ *        Remember to call Predictor_Update() in Uart_DataProcess() when a target is detected!!!
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __TARGET_PREDICTOR_H
+#define __TARGET_PREDICTOR_H
+
+#include "laser_shot_common.h"
+
+#define PREDICTOR_LATENCY_MS 40      // 相机采集到数据包接收的固定延迟(ms)，含一帧曝光和滤波延迟
+#define PREDICTOR_ALPHA 0.5f         // 位置修正系数
+#define PREDICTOR_BETA 0.15f         // 速度修正系数
+#define PREDICTOR_MAX_HORIZON_MS 100 // 最大外推时间(ms)，超过后不再外推
+#define PREDICTOR_TIMEOUT_MS 300     // 超过该时间没有新测量则重新初始化
+#define PREDICTOR_MOTION_LEN 8       // 记录的云台位置命令数，更早的命令视为已完成
+
+// 一条云台位置命令
+typedef struct {
+    uint32_t start_tick;      // 发出时刻(ms)
+    uint16_t duration_ms[2];  // 各轴预计转动时间(ms)
+    uint16_t ramp_ms[2];      // 各轴加速段（等于减速段）时间(ms)，0为匀速
+    int32_t clk[2];           // 各轴脉冲数，逆时针为正
+} PredictorMotion_t;
+
+typedef struct {
+    float x, y;            // 估计位置(像素)，对应last_tick时刻
+    float vx, vy;          // 估计速度(像素/ms)
+    uint32_t last_tick;    // 最近一次测量对应的时刻(ms)
+    float alpha;           // 位置修正系数
+    float beta;            // 速度修正系数
+    uint16_t latency_ms;   // 测量延迟(ms)
+    uint8_t samples;       // 已使用的测量数（最多计到2），第二次测量后才有速度估计
+    bool enable;           // 使能标志，关闭时直接使用测量值
+    float motion_base[2];  // 已移出记录的命令的累计脉冲数，逆时针为正
+    PredictorMotion_t motion[PREDICTOR_MOTION_LEN];  // 最近的云台位置命令（环形）
+    uint8_t motion_head;   // 最早一条命令的位置
+    uint8_t motion_count;  // 记录的命令数
+} Predictor_t;
+
+extern Predictor_t g_target_predictor;
+
+void Predictor_Init(Predictor_t *pred, float alpha, float beta, uint16_t latency_ms);
+void Predictor_Reset(Predictor_t *pred);
+void Predictor_Enable(Predictor_t *pred, bool enable);
+void Predictor_AddMotion(Predictor_t *pred, const PredictorMotion_t *motion);  // 记录一条云台位置命令
+void Predictor_Update(Predictor_t *pred, PixelPoint_t point, uint32_t rx_tick);
+bool Predictor_Predict(const Predictor_t *pred, uint32_t now, PixelPoint_t *point);
+PixelPoint_t Predictor_GetTarget(void);  // 当前时刻的目标位置，供追踪任务使用
+bool Predictor_GetVelocity(float *vx, float *vy);  // 目标自身在图像中的速度(像素/s)
+
+#endif
@@ -1,9 +1,12 @@
 #include "key.h"
 
 #include "Emm_V5.h"
+#include "host_command.h"
 #include "laser_shot_common.h"
 #include "oled_user.h"
+#include "profiler.h"
 #include "task_scheduler.h"
+#include "uart_user.h"
 
 // GPIO端口和引脚宏定义兼容
 #define ROW1_PORT ROW1_GPIO_Port
@@ -61,7 +64,9 @@ static KeyDebounce_t key_debounce;
 KeyValue_t Key_GetDebounced(void)
 {
     uint32_t current_tick = TaskScheduler_GetSystemTick();
+    PROFILER_BEGIN(KEY_SCAN);
     KeyValue_t raw_key = Matrix_Key_Scan();
+    PROFILER_END(KEY_SCAN);
     switch (key_debounce.state) {
         case KEY_STATE_IDLE:
             if (raw_key != KEY_NONE) {
@@ -233,9 +238,29 @@ KeyValue_t Matrix_Key_Scan(void)
     }
 }
 
+/**
+ * @brief 打印视觉坐标滤波方式，卡尔曼滤波时附带最近一次新息和离群测量数
+ */
+static void Key_PrintFilterInfo(void)
+{
+    static const char *const mode_name[] = {"None", "Median", "Kalman"};
+    UartFilterMode_t mode = Uart_GetFilterMode();
+
+    printf("Vision filter: %s\r\n", mode_name[mode]);
+    if (mode == UART_FILTER_KALMAN) {
+        const KalmanCv2d_t *kf = Uart_GetKalman();
+        printf("  innovation=%.2fpx d2=%.2f outliers=%lu\r\n", kf->innovation, kf->mahalanobis,
+               (unsigned long)kf->outliers);
+    }
+}
+
 void Key_Proc(void)
 {
     static KeyValue_t key_val_old = KEY_NONE;
+    bool profiler_dump = false;
+    bool filter_report = false;
+
+    PROFILER_BEGIN(KEY_PROC);
 
     /* 获取经过消抖的按键值 */
     KeyValue_t key_val = Key_GetDebounced();
@@ -248,6 +273,10 @@ void Key_Proc(void)
             // Emm_V5_Origin_Set_O(STEP_MOTOR_X, true);
             // Emm_V5_Origin_Trigger_Return(STEP_MOTOR_Y, 1, false);
         } else if (key_val == KEY_S3) {
+            // 切换视觉坐标滤波方式：中值滤波 <-> 卡尔曼滤波（切换后清空滤波状态）
+            Uart_SetFilterMode((Uart_GetFilterMode() == UART_FILTER_KALMAN) ? UART_FILTER_MEDIAN
+                                                                             : UART_FILTER_KALMAN);
+            filter_report = true;
         } else if (key_val == KEY_S4) {
             if (Laser_TrackAimPoint_IsRunning()) {
                 Laser_TrackAimPoint_Stop();
@@ -267,13 +296,26 @@ void Key_Proc(void)
             // S8任务：135度左转
             Task_Q3_Key_S8_Start();
         } else if (key_val == KEY_S9) {
-            // 处理KEY_S9按键逻辑
+            // 打印耗时统计和任务运行统计后清零（在本次Key_Proc计时结束后执行，打印耗时不计入）
+            profiler_dump = true;
         } else if (key_val == KEY_S10) {
-            // 处理KEY_S10按键逻辑
+            // 激光追踪PID自整定，完成后自动切换到PID模式
+            Laser_TrackAimPoint_SetMode(TRACK_MODE_AUTOTUNE);
+            if (!Laser_TrackAimPoint_IsRunning()) {
+                Laser_TrackAimPoint_Start();
+            }
         } else if (key_val == KEY_S11) {
-            // 处理KEY_S11按键逻辑
+            // 激光速度追踪（前馈跟随运动目标）
+            Laser_TrackAimPoint_SetMode(TRACK_MODE_VELOCITY);
+            if (!Laser_TrackAimPoint_IsRunning()) {
+                Laser_TrackAimPoint_Start();
+            }
         } else if (key_val == KEY_S12) {
-            // 处理KEY_S12按键逻辑
+            // 像素-脉冲标定（目标需静止），完成后自动切换到快速瞄准模式
+            Laser_TrackAimPoint_SetMode(TRACK_MODE_CALIBRATE);
+            if (!Laser_TrackAimPoint_IsRunning()) {
+                Laser_TrackAimPoint_Start();
+            }
         } else if (key_val == KEY_S13) {
             // 处理KEY_S13按键逻辑
             Emm_V5_Origin_Set_O(STEP_MOTOR_X, true);
@@ -292,4 +334,20 @@ void Key_Proc(void)
     if (key_val == KEY_NONE) {
         key_val_old = KEY_NONE;
     }
+    // 串口2的HOST_CMD_PROFILER_DUMP指令与S9相同
+    if (HostCommand_TakeDumpRequest()) {
+        profiler_dump = true;
+    }
+    PROFILER_END(KEY_PROC);
+
+    if (filter_report) {
+        Key_PrintFilterInfo();
+    }
+    if (profiler_dump) {
+        Key_PrintFilterInfo();
+        Profiler_Print();
+        Profiler_Reset();
+        TaskScheduler_PrintTaskInfo();
+        TaskScheduler_ResetStats();
+    }
 }
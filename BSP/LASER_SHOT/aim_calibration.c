@@ -0,0 +1,265 @@
+#include "aim_calibration.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "Emm_V5.h"
+#include "gimbal_motion.h"
+
+#define AIM_CAL_AXIS_X 0
+#define AIM_CAL_AXIS_Y 1
+
+typedef struct {
+    AimCalState_t state;           // 标定状态
+    uint8_t axis;                  // 当前标定的电机轴
+    uint8_t index;                 // 当前采样点序号
+    uint8_t samples;               // 当前点已平均的坐标数
+    bool moved;                    // 当前点的转动命令是否已下发
+    uint32_t start_tick;           // 开始时刻(ms)
+    uint32_t move_tick;            // 当前点转动命令下发时刻(ms)
+    float sum_x, sum_y;            // 当前点坐标累加
+    float point_x[AIM_CAL_POINTS];  // 各点平均坐标
+    float point_y[AIM_CAL_POINTS];
+    AimCalModel_t model;           // 拟合中的模型，全部轴成功后才替换g_aim_cal_model
+} AimCalibration_t;
+
+AimCalModel_t g_aim_cal_model = {
+    .px_per_clk = {{-AIM_CAL_DEFAULT_PX_PER_CLK, 0.0f}, {0.0f, -AIM_CAL_DEFAULT_PX_PER_CLK}},
+    .valid = false,
+};
+static AimCalibration_t g_aim_cal;
+
+/**
+ * @brief 第index个采样点的偏移档数：0→+N→-N→0
+ */
+static int32_t AimCal_SweepPosition(uint8_t index)
+{
+    if (index <= AIM_CAL_STEPS) {
+        return index;
+    }
+    if (index <= 3 * AIM_CAL_STEPS) {
+        return 2 * AIM_CAL_STEPS - index;
+    }
+    return index - 4 * AIM_CAL_STEPS;
+}
+
+/**
+ * @brief 当前轴采样完成，最小二乘拟合每脉冲像素位移
+ *        偏移档数对称分布，均值为0，斜率 = Σ(p*u)/Σ(p²)
+ */
+static void AimCal_FitAxis(AimCalibration_t *cal)
+{
+    float mean_x = 0.0f, mean_y = 0.0f;
+    for (uint8_t i = 0; i < AIM_CAL_POINTS; i++) {
+        mean_x += cal->point_x[i];
+        mean_y += cal->point_y[i];
+    }
+    mean_x /= (float)AIM_CAL_POINTS;
+    mean_y /= (float)AIM_CAL_POINTS;
+
+    float spp = 0.0f, spx = 0.0f, spy = 0.0f;
+    for (uint8_t i = 0; i < AIM_CAL_POINTS; i++) {
+        float p = (float)(AimCal_SweepPosition(i) * AIM_CAL_STEP_CLK);
+        spp += p * p;
+        spx += p * (cal->point_x[i] - mean_x);
+        spy += p * (cal->point_y[i] - mean_y);
+    }
+
+    float kx = spx / spp;
+    float ky = spy / spp;
+    cal->model.px_per_clk[0][cal->axis] = kx;
+    cal->model.px_per_clk[1][cal->axis] = ky;
+
+    // 主方向残差
+    float k = (cal->axis == AIM_CAL_AXIS_X) ? kx : ky;
+    const float *points = (cal->axis == AIM_CAL_AXIS_X) ? cal->point_x : cal->point_y;
+    float mean = (cal->axis == AIM_CAL_AXIS_X) ? mean_x : mean_y;
+    float sse = 0.0f;
+    for (uint8_t i = 0; i < AIM_CAL_POINTS; i++) {
+        float r = points[i] - mean - k * (float)(AimCal_SweepPosition(i) * AIM_CAL_STEP_CLK);
+        sse += r * r;
+    }
+    cal->model.residual[cal->axis] = sqrtf(sse / (float)AIM_CAL_POINTS);
+}
+
+/**
+ * @brief 两轴拟合完成，检查模型有效后替换当前模型
+ */
+static void AimCal_Finish(AimCalibration_t *cal)
+{
+    const float(*k)[2] = cal->model.px_per_clk;
+    float det = k[0][0] * k[1][1] - k[0][1] * k[1][0];
+
+    if (fabsf(k[0][0]) < AIM_CAL_MIN_PX_PER_CLK || fabsf(k[1][1]) < AIM_CAL_MIN_PX_PER_CLK ||
+        fabsf(det) < AIM_CAL_MIN_PX_PER_CLK * AIM_CAL_MIN_PX_PER_CLK) {
+        cal->state = AIM_CAL_FAILED;
+        return;
+    }
+
+    cal->model.valid = true;
+    g_aim_cal_model = cal->model;
+    cal->state = AIM_CAL_DONE;
+}
+
+/**
+ * @brief 开始标定，调用前目标需静止且在视野中
+ * @param tick 当前时刻(ms)
+ */
+void AimCal_Start(uint32_t tick)
+{
+    memset(&g_aim_cal, 0, sizeof(AimCalibration_t));
+    g_aim_cal.start_tick = tick;
+    g_aim_cal.state = AIM_CAL_RUNNING;
+}
+
+/**
+ * @brief 中止标定，已有的模型不变
+ */
+void AimCal_Stop(void)
+{
+    if (g_aim_cal.state == AIM_CAL_RUNNING) {
+        g_aim_cal.state = AIM_CAL_IDLE;
+    }
+}
+
+/**
+ * @brief 标定状态机，每个控制周期调用一次
+ *        每个点：下发转动 → 等待AIM_CAL_SETTLE_MS → 平均AIM_CAL_SAMPLES个坐标；
+ *        目标丢失（坐标为(0, 0)）时暂停采样
+ * @param point 当前目标坐标（原始测量值，不使用外推）
+ * @param tick 当前时刻(ms)
+ * @return 标定状态
+ */
+AimCalState_t AimCal_Update(PixelPoint_t point, uint32_t tick)
+{
+    AimCalibration_t *cal = &g_aim_cal;
+    if (cal->state != AIM_CAL_RUNNING) {
+        return cal->state;
+    }
+
+    if (tick - cal->start_tick > AIM_CAL_TIMEOUT_MS) {
+        cal->state = AIM_CAL_FAILED;
+        return cal->state;
+    }
+
+    // 下发到当前点的转动，邮箱忙时下个周期重试
+    if (!cal->moved) {
+        int32_t delta = 0;
+        if (cal->index > 0) {
+            delta = (AimCal_SweepPosition(cal->index) - AimCal_SweepPosition(cal->index - 1)) *
+                    AIM_CAL_STEP_CLK;
+        }
+        if (delta != 0) {
+            uint8_t dir = (delta > 0) ? DIR_CCW : DIR_CW;
+            uint32_t clk = (uint32_t)abs(delta);
+            bool ok = (cal->axis == AIM_CAL_AXIS_X)
+                          ? GimbalMotion_MoveXY(dir, clk, DIR_CW, 0, AIM_CAL_VELOCITY,
+                                                AIM_CAL_ACCELERATION, false)
+                          : GimbalMotion_MoveXY(DIR_CW, 0, dir, clk, AIM_CAL_VELOCITY,
+                                                AIM_CAL_ACCELERATION, false);
+            if (!ok) {
+                return cal->state;
+            }
+        }
+        cal->moved = true;
+        cal->move_tick = tick;
+        return cal->state;
+    }
+
+    if (tick - cal->move_tick < AIM_CAL_SETTLE_MS || (point.x == 0 && point.y == 0)) {
+        return cal->state;
+    }
+
+    cal->sum_x += (float)point.x;
+    cal->sum_y += (float)point.y;
+    if (++cal->samples < AIM_CAL_SAMPLES) {
+        return cal->state;
+    }
+
+    cal->point_x[cal->index] = cal->sum_x / (float)AIM_CAL_SAMPLES;
+    cal->point_y[cal->index] = cal->sum_y / (float)AIM_CAL_SAMPLES;
+    cal->sum_x = 0.0f;
+    cal->sum_y = 0.0f;
+    cal->samples = 0;
+    cal->moved = false;
+
+    if (++cal->index < AIM_CAL_POINTS) {
+        return cal->state;
+    }
+
+    // 当前轴完成（已回到起点），换下一轴
+    AimCal_FitAxis(cal);
+    cal->index = 0;
+    if (++cal->axis > AIM_CAL_AXIS_Y) {
+        AimCal_Finish(cal);
+    }
+    return cal->state;
+}
+
+/**
+ * @brief 获取标定状态
+ */
+AimCalState_t AimCal_GetState(void)
+{
+    return g_aim_cal.state;
+}
+
+/**
+ * @brief 计算使目标在图像中移动(dx, dy)像素所需的两轴脉冲数（求解2x2模型）
+ * @param dx 图像x方向位移(像素)
+ * @param dy 图像y方向位移(像素)
+ * @param clk_x X轴脉冲数输出，逆时针为正
+ * @param clk_y Y轴脉冲数输出，逆时针为正
+ * @return true 计算成功，false 未标定
+ */
+bool AimCal_PixelToClk(float dx, float dy, int32_t *clk_x, int32_t *clk_y)
+{
+    if (!g_aim_cal_model.valid || clk_x == NULL || clk_y == NULL) {
+        return false;
+    }
+
+    const float(*k)[2] = g_aim_cal_model.px_per_clk;
+    float det = k[0][0] * k[1][1] - k[0][1] * k[1][0];
+
+    *clk_x = (int32_t)lrintf((k[1][1] * dx - k[0][1] * dy) / det);
+    *clk_y = (int32_t)lrintf((k[0][0] * dy - k[1][0] * dx) / det);
+    return true;
+}
+
+/**
+ * @brief 计算抵消图像速度(vx, vy)所需的两轴转速（求解2x2模型，保留符号和交叉耦合）
+ *        未标定时使用默认模型（两轴独立，每脉冲AIM_CAL_DEFAULT_PX_PER_CLK像素）
+ * @param vx 图像x方向速度(像素/s)
+ * @param vy 图像y方向速度(像素/s)
+ * @param clk_vel 两轴转速输出(脉冲/s)，逆时针为正
+ * @return true 计算成功，false 模型奇异
+ */
+bool AimCal_PixelVelToClkVel(float vx, float vy, float clk_vel[2])
+{
+    const float(*k)[2] = g_aim_cal_model.px_per_clk;
+    float det = k[0][0] * k[1][1] - k[0][1] * k[1][0];
+
+    if (clk_vel == NULL || fabsf(det) < AIM_CAL_MIN_PX_PER_CLK * AIM_CAL_MIN_PX_PER_CLK) {
+        return false;
+    }
+    clk_vel[AIM_CAL_AXIS_X] = (k[1][1] * vx - k[0][1] * vy) / det;
+    clk_vel[AIM_CAL_AXIS_Y] = (k[0][0] * vy - k[1][0] * vx) / det;
+    return true;
+}
+
+/**
+ * @brief 打印标定结果
+ */
+void AimCal_Print(void)
+{
+    static const char axis_name[2] = {'X', 'Y'};
+
+    if (g_aim_cal.state == AIM_CAL_FAILED) {
+        printf("AimCal failed\r\n");
+    }
+    for (uint8_t axis = AIM_CAL_AXIS_X; axis <= AIM_CAL_AXIS_Y; axis++) {
+        printf("AimCal %c: dx=%.3f dy=%.3f px/clk rms=%.2fpx%s\r\n", axis_name[axis],
+               g_aim_cal_model.px_per_clk[0][axis], g_aim_cal_model.px_per_clk[1][axis],
+               g_aim_cal_model.residual[axis], g_aim_cal_model.valid ? "" : " (default)");
+    }
+}
@@ -0,0 +1,55 @@
+/**
+ * @file aim_calibration.h
+ * @author Shiki
+ * @brief 像素-脉冲标定
+ *        目标静止时，逐轴按已知脉冲数来回转动（0→+N→-N→0），每个位置稳定后取若干帧目标坐标的平均，
+ *        用最小二乘拟合每脉冲的像素位移，得到2x2模型（含两轴与图像坐标轴不正交时的交叉耦合），
+ *        来回两个方向的数据一起拟合，抵消回程间隙。
+ *        标定结果用于由像素误差直接计算所需脉冲数（一到两次转动对准），以及速度追踪的RPM换算。
+ *        每个控制周期调用一次AimCal_Update()，不阻塞；结果保存在RAM中，掉电不保存，完成时打印。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __AIM_CALIBRATION_H
+#define __AIM_CALIBRATION_H
+
+#include "laser_shot_common.h"
+
+#define AIM_CAL_STEP_CLK 20                      // 每档偏移的脉冲数
+#define AIM_CAL_STEPS 3                          // 单方向最大偏移档数
+#define AIM_CAL_POINTS (4 * AIM_CAL_STEPS + 1)   // 每轴采样点数
+#define AIM_CAL_SETTLE_MS 200                    // 转动后等待稳定的时间（含视觉延迟）
+#define AIM_CAL_SAMPLES 4                        // 每个点平均的坐标数
+#define AIM_CAL_VELOCITY 20                      // 标定转动速度(RPM)
+#define AIM_CAL_ACCELERATION 10                  // 标定转动加速度档位
+#define AIM_CAL_TIMEOUT_MS 20000                 // 超时时间
+#define AIM_CAL_MIN_PX_PER_CLK 0.05f             // 主方向每脉冲像素位移下限，低于此值认为标定无效
+#define AIM_CAL_DEFAULT_PX_PER_CLK 0.5f          // 未标定时使用的估计值
+
+typedef enum {
+    AIM_CAL_IDLE = 0,  // 未运行
+    AIM_CAL_RUNNING,   // 标定中
+    AIM_CAL_DONE,      // 标定完成
+    AIM_CAL_FAILED     // 超时或拟合结果无效
+} AimCalState_t;
+
+typedef struct {
+    float px_per_clk[2][2];  // 每脉冲像素位移[像素轴x/y][电机轴X/Y]，脉冲以逆时针为正
+    float residual[2];       // 各电机轴拟合残差RMS(像素)
+    bool valid;              // 是否已标定
+} AimCalModel_t;
+
+extern AimCalModel_t g_aim_cal_model;
+
+void AimCal_Start(uint32_t tick);
+void AimCal_Stop(void);
+AimCalState_t AimCal_Update(PixelPoint_t point, uint32_t tick);
+AimCalState_t AimCal_GetState(void);
+bool AimCal_PixelToClk(float dx, float dy, int32_t *clk_x, int32_t *clk_y);
+bool AimCal_PixelVelToClkVel(float vx, float vy, float clk_vel[2]);
+void AimCal_Print(void);
+
+#endif
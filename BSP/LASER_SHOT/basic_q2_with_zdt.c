@@ -1,5 +1,7 @@
 #include "Emm_V5.h"
+#include "gimbal_motion.h"
 #include "laser_shot_common.h"
+#include "target_predictor.h"
 #include "task_scheduler.h"
 
 bool g_task_basic_q2_with_zdt_running = false;
@@ -46,9 +48,10 @@ static void BasicQ2_Using_Positon(void)
     const uint8_t acc = 5;
     // 定义死区范围，当误差小于这个值时不再调整，防止抖动
     const uint16_t DEADZONE = 2;
-    // 计算误差
-    int16_t error_x = g_curr_center_point.x - q2_sensor_aim_x;
-    int16_t error_y = g_curr_center_point.y - q2_sensor_aim_y;
+    // 计算误差（使用外推到当前时刻的目标位置）
+    PixelPoint_t target = Predictor_GetTarget();
+    int16_t error_x = target.x - q2_sensor_aim_x;
+    int16_t error_y = target.y - q2_sensor_aim_y;
 
     // 如果误差在死区内，不做调整
     if (abs(error_x) < DEADZONE && abs(error_y) < DEADZONE
@@ -79,17 +82,11 @@ static void BasicQ2_Using_Positon(void)
         step_y = CLK_STEP_LARGE;  // 大误差，大步进
     }
 
-    if (error_x > 0) {
-        Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CCW, vel, acc, step_x, false, false);  // 目标在右侧，舵机右转
-    } else if (error_x < 0) {
-        Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CW, vel, acc, step_x, false, false);  // 目标在左侧，舵机左转
-    }
-    HAL_Delay(20);
-    if (error_y > 0) {
-        Emm_V5_Pos_Control(STEP_MOTOR_Y, DIR_CCW, vel, acc, step_y, false, false);  // 目标在下方，舵机下转
-    } else if (error_y < 0) {
-        Emm_V5_Pos_Control(STEP_MOTOR_Y, DIR_CW, vel, acc, step_y, false, false);  // 目标在上方，舵机上转
-    }
+    // 非阻塞发送，X/Y命令打包为一帧后同步启动
+    // 目标在右侧舵机右转，在左侧左转；目标在下方舵机下转，在上方上转
+    GimbalMotion_MoveXY((error_x > 0) ? DIR_CCW : DIR_CW, (error_x != 0) ? step_x : 0,
+                        (error_y > 0) ? DIR_CCW : DIR_CW, (error_y != 0) ? step_y : 0, vel, acc,
+                        false);
 }
 
 void Task_BasicQ2_WithZDT_Execute(void)
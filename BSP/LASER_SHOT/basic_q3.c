@@ -1,14 +1,18 @@
 #include "Emm_V5.h"
+#include "gimbal_motion.h"
 #include "gpio.h"
 #include "laser_shot_common.h"
+#include "target_predictor.h"
 #include "task_scheduler.h"
 #include "uart_user.h"
+#include "vision_packet.h"
 
 // 状态定义
 typedef enum {
     Q3_STATE_INIT,       // 初始化状态
     Q3_STATE_HOMING,     // 回零状态
     Q3_STATE_SEARCHING,  // 搜索状态
+    Q3_STATE_STOPPING,   // 找到目标后等待电机停止
     Q3_STATE_TRACKING,   // 追踪状态
     Q3_STATE_COMPLETE    // 完成状态
 } Q3State_t;
@@ -38,12 +42,13 @@ typedef enum {
 #define X_SEARCH_DIR DIR_CCW      // 固定搜索方向
 #define X_SEARCH_STEP 100         // 每次搜索步长(脉冲数)
 #define X_SEARCH_MAX_PULSES 3000  // 最大搜索角度(约半圈)
+#define X_SEARCH_SETTLE_MS 20     // 每次步进命令发出后等待视觉稳定的时间(ms)
+#define Q3_STOP_SETTLE_MS 20      // 找到目标停止电机后等待的时间(ms)
 
 // 追踪控制参数
 #define Q3_TRACK_VELOCITY 20      // 追踪时的电机速度
 #define Q3_TRACK_ACC 10           // 追踪时的电机加速度
 #define Q3_TRACK_DEADZONE 5       // 追踪死区范围
-#define Q3_MOTOR_CMD_DELAY_MS 20  // 电机命令之间的延时(ms)
 
 // 追踪步进参数
 #define CLK_STEP_SMALL 5    // 小步进值
@@ -59,6 +64,7 @@ static uint32_t q3_last_time = 0;
 static bool search_started = false;           // 搜索启动标志
 static uint16_t current_search_position = 0;  // 当前搜索位置
 static uint32_t q3_total_start_time = 0;      // 任务总运行时间计时器
+static uint32_t q3_wait_start = 0;            // 步进/停止命令发出时刻，按系统时刻等待
 
 // 检查矩形是否被检测到
 static bool IsRectangleDetected(void)
@@ -68,8 +74,8 @@ static bool IsRectangleDetected(void)
     static uint8_t consecutive_detections = 0;  // 连续检测到矩形的次数
     uint32_t current_time = TaskScheduler_GetSystemTick();
 
-    // 处理视觉模块返回的坐标
-    if (g_curr_center_point.x != 0 || g_curr_center_point.y != 0) {
+    // 处理视觉模块返回的数据包（v2格式使用有效标志位，旧格式由(0,0)判断）
+    if (VisionPacket_TargetDetected()) {
         // 检测到矩形，重置连续零计数，增加连续检测计数
         consecutive_zeros = 0;
         consecutive_detections++;
@@ -109,8 +115,9 @@ static void TrackRectangle(void)
     const uint16_t DEADZONE = Q3_TRACK_DEADZONE;  // 使用配置的死区范围
 
     // 计算误差
-    int16_t error_x = g_curr_center_point.x - g_sensor_aim_x;
-    int16_t error_y = g_curr_center_point.y - g_sensor_aim_y;
+    PixelPoint_t target = Predictor_GetTarget();
+    int16_t error_x = target.x - g_sensor_aim_x;
+    int16_t error_y = target.y - g_sensor_aim_y;
 
     // 如果误差在死区内，任务完成
     if (abs(error_x) < DEADZONE && abs(error_y) < DEADZONE) {
@@ -132,25 +139,10 @@ static void TrackRectangle(void)
         step_y = CLK_STEP_MEDIUM;
     }
 
-    // 同时控制X和Y轴，确保命令间有延时
-    bool y_adjusted = false;
-
-    if (abs(error_x) > DEADZONE) {
-        Emm_V5_Pos_Control(STEP_MOTOR_X, (error_x > 0) ? DIR_CCW : DIR_CW, vel, acc, step_x, false,
-                           false);
-        HAL_Delay(Q3_MOTOR_CMD_DELAY_MS);  // 使用配置的命令延时
-    }
-
-    if (abs(error_y) > DEADZONE) {
-        Emm_V5_Pos_Control(STEP_MOTOR_Y, (error_y > 0) ? DIR_CCW : DIR_CW, vel, acc, step_y, false,
-                           false);
-        y_adjusted = true;
-    }
-
-    // Y轴调整后的延时
-    if (y_adjusted) {
-        HAL_Delay(Q3_MOTOR_CMD_DELAY_MS);  // 使用配置的命令延时
-    }
+    // 同时控制X和Y轴，非阻塞发送，两轴命令打包为一帧后同步启动
+    GimbalMotion_MoveXY((error_x > 0) ? DIR_CCW : DIR_CW, (abs(error_x) > DEADZONE) ? step_x : 0,
+                        (error_y > 0) ? DIR_CCW : DIR_CW, (abs(error_y) > DEADZONE) ? step_y : 0,
+                        vel, acc, false);
 }
 
 void Task_BasicQ3_Start(void)
@@ -178,9 +170,8 @@ void Task_BasicQ3_Stop(void)
     Uart_SetFilterEnabled(true);
 
     // 停止电机
-    Emm_V5_Stop_Now(STEP_MOTOR_X, false);
-    HAL_Delay(20);
-    Emm_V5_Stop_Now(STEP_MOTOR_Y, false);
+    GimbalMotion_StopNow(STEP_MOTOR_X, false);
+    GimbalMotion_StopNow(STEP_MOTOR_Y, false);
     // 重置所有状态变量
     q3_state = Q3_STATE_INIT;
     homing_phase = HOMING_PHASE_Y;  // 重置回零阶段
@@ -265,8 +256,8 @@ void Task_BasicQ3_Execute(void)
                 init_detection_start = 0;  // 重置计时器
 
                 // 矩形不可见，需要X轴回零后搜索
+                // 回零命令经发送队列发出，HOMING_PHASE_X阶段按系统时刻等待回零完成
                 Emm_V5_Origin_Trigger_Return(STEP_MOTOR_X, 1, false);
-                HAL_Delay(100);                 // 确保命令发送
                 homing_phase = HOMING_PHASE_X;  // 设置为X轴回零阶段
                 q3_state = Q3_STATE_HOMING;
             }
@@ -315,16 +306,17 @@ void Task_BasicQ3_Execute(void)
         }
 
         case Q3_STATE_SEARCHING:
+            // 步进命令发出后短暂等待，以便视觉系统可以稳定
+            if (search_started && current_time - q3_wait_start < X_SEARCH_SETTLE_MS) {
+                break;
+            }
+
             // 检查是否已检测到矩形
             if (IsRectangleDetected()) {
-                // 找到矩形，停止电机
-                Emm_V5_Stop_Now(STEP_MOTOR_X, false);
-                HAL_Delay(20);  // 短暂等待电机停止
-
-                // 进入追踪状态时重新启用滤波，提高追踪精度
-                Uart_SetFilterEnabled(true);
-
-                q3_state = Q3_STATE_TRACKING;
+                // 找到矩形，停止电机，在STOPPING状态等待电机停止
+                GimbalMotion_StopNow(STEP_MOTOR_X, false);
+                q3_wait_start = current_time;
+                q3_state = Q3_STATE_STOPPING;
                 search_started = false;
                 break;
             }
@@ -343,19 +335,17 @@ void Task_BasicQ3_Execute(void)
                 current_search_position += X_SEARCH_STEP;
 
                 // 使用位置模式控制，向指定方向移动一步
-                Emm_V5_Pos_Control(STEP_MOTOR_X, X_SEARCH_DIR, X_SEARCH_VELOCITY, X_SEARCH_ACC,
-                                   current_search_position, false, false);
+                GimbalMotion_PosControl(STEP_MOTOR_X, X_SEARCH_DIR, X_SEARCH_VELOCITY, X_SEARCH_ACC,
+                                        current_search_position, false, false);
 
                 // 标记搜索已启动，等待一段时间后检查结果
                 search_started = true;
+                q3_wait_start = current_time;
 
                 // 确保搜索计时器已设置
                 if (q3_last_time == 0 || current_search_position == X_SEARCH_STEP) {
                     q3_last_time = current_time;  // 设置搜索起始时间
                 }
-
-                // 确保电机命令执行后有短暂等待，以便视觉系统可以稳定
-                HAL_Delay(20);
             } else {
                 // 等待电机到位或一定时间后，重置搜索标志，进行下一步搜索
                 if (current_time - q3_last_time > 200) {
@@ -364,15 +354,23 @@ void Task_BasicQ3_Execute(void)
             }
             break;
 
+        case Q3_STATE_STOPPING:
+            // 等待电机停止后进入追踪状态
+            if (current_time - q3_wait_start >= Q3_STOP_SETTLE_MS) {
+                // 进入追踪状态时重新启用滤波，提高追踪精度
+                Uart_SetFilterEnabled(true);
+                q3_state = Q3_STATE_TRACKING;
+            }
+            break;
+
         case Q3_STATE_TRACKING:
             if (IsRectangleDetected()) {
                 // 找到目标，进行追踪
                 TrackRectangle();
             } else {
                 // 丢失目标，立即停止电机
-                Emm_V5_Stop_Now(STEP_MOTOR_X, false);
-                HAL_Delay(20);
-                Emm_V5_Stop_Now(STEP_MOTOR_Y, false);
+                GimbalMotion_StopNow(STEP_MOTOR_X, false);
+                GimbalMotion_StopNow(STEP_MOTOR_Y, false);
 
                 // 重新禁用滤波以提高搜索响应速度
                 Uart_SetFilterEnabled(false);
@@ -1,10 +1,15 @@
 #include "Emm_V5.h"
+#include "gimbal_motion.h"
 #include "gpio.h"
 #include "laser_shot_common.h"
 #include "pid_controller.h"
+#include "target_predictor.h"
 #include "task_scheduler.h"
+#include "trajectory.h"
 #include "uart_user.h"  // 添加串口用户函数头文件
 
+#include <math.h>
+
 uint16_t g_sensor_aim_x = 150;
 uint16_t g_sensor_aim_y = 130;
 
@@ -15,6 +20,9 @@ uint16_t g_sensor_aim_y = 130;
 #define Q3_KEY_PID_KP_VALUE 1.2f   // X轴PID比例系数（针对4秒限制优化）
 #define Q3_KEY_PID_KI_VALUE 0.05f  // X轴PID积分系数
 #define Q3_KEY_PID_KD_VALUE 0.1f   // X轴PID微分系数
+#define Q3_KEY_PID_D_FILTER 0.5f   // 微分低通系数（0~1）：增大可抑制像素噪声引起的步进抖动
+#define Q3_KEY_PID_KAW 0.5f        // 反算抗饱和系数：输出限幅后积分回退，减小大误差后的超调
+#define Q3_KEY_PID_SAMPLE_TIME 0.03f  // 整定参数时的控制周期(s)，与Track_Task周期一致
 
 // PID输出限制 - 控制最大步进数，影响追踪速度
 #define Q3_KEY_PID_OUTPUT_MAX 15.0f     // 最大输出步进数
@@ -31,16 +39,13 @@ uint16_t g_sensor_aim_y = 130;
 #define Q3_KEY_MIN_STEP 1   // 最小步进数
 #define Q3_KEY_MAX_STEP 20  // 最大步进数（增大以提高大误差时的追踪速度）
 
-// 控制延时 - 影响系统响应速度
-#define Q3_KEY_MOTOR_DELAY_MS 20  // 电机命令延时（ms，减小以提高响应速度）
-
 // 任务超时控制
 #define Q3_KEY_TIMEOUT_MS 5000  // 总超时时间4秒
 
 
 // 初始转角配置（45度为基准）
-#define Q3_KEY_TURN_VEL 40      // 初始转动电机速度
-#define Q3_KEY_TURN_ACC 20      // 初始转动电机加速度
+#define Q3_KEY_TURN_MAX_VEL 100      // 初始转动最大速度(RPM)
+#define Q3_KEY_TURN_MAX_ACC 400.0f   // 初始转动最大加速度(RPM/s)，按云台惯量设置，过大会过冲
 #define Q3_KEY_TURN_45_CLK 400  // 45度转动所需的时钟脉冲数
 // =================================================================
 
@@ -58,8 +63,11 @@ typedef struct {
     bool is_running;            // 任务运行标志
     bool pid_initialized;       // PID初始化标志
     uint32_t start_time;        // 任务开始时间
+    uint32_t pid_tick;          // 上次执行PID控制的时刻(ms)，0为尚未执行
+    uint32_t settle_tick;       // 最近一次精调转完且图像跟上的时刻(ms)，此前不判断对准
     Q3KeyTaskType_t task_type;  // 任务类型
     PidController_t pid_x;      // X轴PID控制器
+    Trajectory_t turn;          // 初始转动规划，转动完成前不做PID精调
 } Q3KeyTaskState_t;
 
 // 全局任务状态（只运行一个任务）
@@ -77,6 +85,11 @@ static void Q3_Key_PID_Init(void)
     PID_SetOutputLimit(&g_q3_key_task_state.pid_x, Q3_KEY_PID_OUTPUT_MIN, Q3_KEY_PID_OUTPUT_MAX);
     PID_SetIntegralLimit(&g_q3_key_task_state.pid_x, Q3_KEY_PID_INTEGRAL_MIN,
                          Q3_KEY_PID_INTEGRAL_MAX);
+    PID_SetDerivativeFilter(&g_q3_key_task_state.pid_x, Q3_KEY_PID_D_FILTER);
+    PID_SetAntiWindup(&g_q3_key_task_state.pid_x, Q3_KEY_PID_KAW);
+    PID_SetSampleTime(&g_q3_key_task_state.pid_x, Q3_KEY_PID_SAMPLE_TIME);
+    g_q3_key_task_state.pid_tick = 0;
+    g_q3_key_task_state.settle_tick = 0;
 
     g_q3_key_task_state.pid_initialized = true;
 }
@@ -101,41 +114,41 @@ static bool Q3_Key_PID_Control_X(void)
     const uint8_t acc = Q3_KEY_MOTOR_ACCELERATION;
     const uint16_t DEADZONE = Q3_KEY_DEADZONE;
 
+    // 实测控制周期，积分、微分项按实际周期缩放
+    uint32_t now = HAL_GetTick();
+    float dt = (g_q3_key_task_state.pid_tick != 0)
+                   ? (float)(now - g_q3_key_task_state.pid_tick) * 0.001f
+                   : 0.0f;
+    g_q3_key_task_state.pid_tick = now;
+
     // 计算X轴误差（目标位置 - 当前位置）
-    float error_x = (float)(g_sensor_aim_x - g_curr_center_point.x);
+    float error_x = (float)(g_sensor_aim_x - Predictor_GetTarget().x);
 
     // 如果X轴误差在死区内，认为已对准
+    // 预测坐标已计入转动中的精调，等精调转完再确认，避免停止任务时打断最后一次精调
     if (abs(error_x) < DEADZONE) {
-        return true;  // 已对准
+        return (int32_t)(now - g_q3_key_task_state.settle_tick) >= 0;
     }
 
     // 设置PID目标值为0（即消除误差）
     PID_SetTarget(&g_q3_key_task_state.pid_x, 0.0f);
 
     // 计算PID输出（步进数），将误差作为当前值输入
-    float pid_output_x = PID_Compute(&g_q3_key_task_state.pid_x, -error_x);  // 负号使得输出方向正确
-    // 限制步进值范围
-    uint16_t step_x = (uint16_t)abs(pid_output_x);
+    float pid_output_x = PID_ComputeDt(&g_q3_key_task_state.pid_x, -error_x, dt);  // 负号使得输出方向正确
+    // 输出为正时顺时针转动，步数取输出的绝对值并四舍五入
+    uint16_t step_x = (uint16_t)fminf(fabsf(pid_output_x) + 0.5f, (float)Q3_KEY_MAX_STEP);
 
     if (step_x > 0 && step_x < Q3_KEY_MIN_STEP)
         step_x = Q3_KEY_MIN_STEP;
 
-    if (step_x > Q3_KEY_MAX_STEP)
-        step_x = Q3_KEY_MAX_STEP;
-
-    // 控制X轴电机（根据误差方向直接判断）
-    if (abs(error_x) > DEADZONE) {
-        if (error_x > 0) {
-            // 目标在右侧，需要右转
-            Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CW, vel, acc, step_x, false, false);
-        } else {
-            // 目标在左侧，需要左转
-            Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CCW, vel, acc, step_x, false, false);
-        }
+    // 控制X轴电机，方向和步数都来自带符号的PID输出
+    if (fabsf(error_x) > DEADZONE && step_x > 0) {
+        GimbalMotion_PosControl(STEP_MOTOR_X, (pid_output_x > 0.0f) ? DIR_CW : DIR_CCW, vel, acc,
+                                step_x, false, false);
+        g_q3_key_task_state.settle_tick =
+            now + Trajectory_MoveTimeMs(step_x, vel, acc, NULL) + g_target_predictor.latency_ms;
     }
 
-    HAL_Delay(Q3_KEY_MOTOR_DELAY_MS);
-
     return false;  // 仍在调整中
 }
 
@@ -149,7 +162,7 @@ static void Q3_Key_Task_Stop(void)
     g_q3_key_task_state.start_time = 0;
     
     // 停止X轴电机
-    Emm_V5_Stop_Now(STEP_MOTOR_X, false);
+    GimbalMotion_StopNow(STEP_MOTOR_X, false);
 
     // 恢复串口中值滤波
     Uart_SetFilterEnabled(true);
@@ -184,31 +197,31 @@ static void Q3_Key_Task_Start_Common(Q3KeyTaskType_t task_type)
     HAL_Delay(1000);
     // 计算转角（以45度为基准）
     uint32_t turn_angle_clk = 0;
+    uint8_t turn_dir = DIR_CW;
     switch (task_type) {
         case Q3_KEY_TASK_S5:
             turn_angle_clk = Q3_KEY_TURN_45_CLK * 2;  // 90度
-            Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CW, Q3_KEY_TURN_VEL, Q3_KEY_TURN_ACC, turn_angle_clk,
-                       false, false);
             break;
         case Q3_KEY_TASK_S6:
             turn_angle_clk = (uint32_t)(Q3_KEY_TURN_45_CLK / 45.0f * 30.0f);
-            Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CW, Q3_KEY_TURN_VEL, Q3_KEY_TURN_ACC, turn_angle_clk,
-                       false, false);
             break;
         case Q3_KEY_TASK_S7:
             turn_angle_clk = Q3_KEY_TURN_45_CLK * 2;  // 90度
-            Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CCW, Q3_KEY_TURN_VEL, Q3_KEY_TURN_ACC, turn_angle_clk,
-                       false, false);
+            turn_dir = DIR_CCW;
             break;
         case Q3_KEY_TASK_S8:
             turn_angle_clk = (uint32_t)(Q3_KEY_TURN_45_CLK / 45.0f * 160.0f);  // 135度
-            Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CW, Q3_KEY_TURN_VEL, Q3_KEY_TURN_ACC, turn_angle_clk,
-                       false, false);
             break;
         default:
             break;
     }
 
+    // 按最大速度、加速度规划时间最短的梯形转动，一条位置命令下发
+    if (Trajectory_Plan(&g_q3_key_task_state.turn, turn_angle_clk, Q3_KEY_TURN_MAX_VEL,
+                        Q3_KEY_TURN_MAX_ACC)) {
+        Trajectory_Start(&g_q3_key_task_state.turn, STEP_MOTOR_X, turn_dir, HAL_GetTick());
+    }
+
     // 初始化PID控制器
     Q3_Key_PID_Init();
 }
@@ -266,6 +279,11 @@ void Task_Q3_Key_Execute(void)
         return;
     }
 
+    // 初始转动完成前不做精调，避免精调命令打断转动
+    if (!Trajectory_IsDone(&g_q3_key_task_state.turn, HAL_GetTick())) {
+        return;
+    }
+
     // 如果当前坐标为(0, 0)，则不执行任何操作
     if (g_curr_center_point.x == 0 && g_curr_center_point.y == 0) {
         return;
@@ -12,7 +12,11 @@
 // 激光追踪控制模式
 typedef enum {
     TRACK_MODE_STEP = 0,    // 步进控制模式（原始方式）
-    TRACK_MODE_PID          // PID控制模式
+    TRACK_MODE_PID,         // PID控制模式
+    TRACK_MODE_AUTOTUNE,    // PID自整定模式（继电振荡，完成后自动切换到PID模式）
+    TRACK_MODE_VELOCITY,    // 速度追踪模式（速度PID + 目标速度前馈，电机连续转动）
+    TRACK_MODE_CALIBRATE,   // 像素-脉冲标定模式（目标需静止，完成后自动切换到快速瞄准模式）
+    TRACK_MODE_SNAP         // 快速瞄准模式（按标定结果一次转到位，未标定时使用步进控制）
 } TrackMode_t;
 
 extern uint16_t g_sensor_width;
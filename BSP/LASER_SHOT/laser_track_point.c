@@ -1,22 +1,35 @@
 #include "Emm_V5.h"
+#include "aim_calibration.h"
+#include "emm_feedback.h"
+#include "gimbal_motion.h"
 #include "gpio.h"
 #include "laser_shot_common.h"
-#include "pid_controller.h"
+#include "pid_autotune.h"
+#include "pid_bank.h"
+#include "target_predictor.h"
 #include "task_scheduler.h"
+#include "track_metrics.h"
+#include "trajectory.h"
+
+#include <math.h>
+#include <string.h>
 
 // ==================== PID追踪参数配置区域 ====================
 // 以下参数影响PID追踪的响应速度和精度，可根据实际效果调整
 
 // PID控制器参数 - 影响追踪响应速度和稳定性
-#define PID_KP_VALUE 1.5f   // 比例系数：增大可提高响应速度，过大会振荡
+#define PID_KP_VALUE 1.0f   // 比例系数：增大可提高响应速度，过大会振荡
 #define PID_KI_VALUE 0.02f  // 积分系数：消除稳态误差，过大会超调
-#define PID_KD_VALUE 0.15f  // 微分系数：改善动态性能，减少超调
+#define PID_KD_VALUE 0.1f   // 微分系数：改善动态性能，减少超调
 
 // PID输出限制 - 控制最大步进数，影响追踪速度
 #define PID_OUTPUT_MAX 50.0f     // 最大输出步进数（增大可提高追踪速度）
 #define PID_OUTPUT_MIN -50.0f    // 最小输出步进数
 #define PID_INTEGRAL_MAX 25.0f   // 积分限幅上限（防止积分饱和）
 #define PID_INTEGRAL_MIN -25.0f  // 积分限幅下限
+#define PID_SAMPLE_TIME 0.03f    // 整定参数时的控制周期(s)，与Track_Task周期一致
+#define PID_D_FILTER 0.5f        // 微分低通滤波系数(0~1)：增大可抑制坐标噪声引起的步进抖动
+#define PID_ANTIWINDUP 0.5f      // 反算抗饱和系数：0为只用积分限幅
 
 // 电机控制参数 - 影响实际执行速度
 #define PID_MOTOR_VELOCITY 30      // PID模式电机速度（增大可提高追踪速度）
@@ -27,14 +40,36 @@
 #define PID_MIN_STEP 1   // 最小步进数：减小提高精度
 #define PID_MAX_STEP 20  // 最大步进数：增大提高大误差时的追踪速度
 
-// 控制延时 - 影响系统响应速度
-#define PID_MOTOR_DELAY_MS 10  // 电机命令间延时（ms）：减小可提高响应速度
+// PID自整定参数 - 继电振荡测量临界增益和周期，结果替换上面的PID参数（掉电不保存）
+#define AUTOTUNE_RELAY_STEP 5.0f             // 继电输出步进数：需使云台明显振荡
+#define AUTOTUNE_HYSTERESIS 2.0f             // 继电滞环（像素）：略大于视觉坐标噪声
+#define AUTOTUNE_RULE AUTOTUNE_RULE_TL       // 整定规则：AUTOTUNE_RULE_TL较保守，AUTOTUNE_RULE_ZN响应更快
+
+// 速度追踪参数 - 速度PID + 目标速度前馈，电机连续转动跟随运动目标
+#define VEL_KP_VALUE 0.1f           // 比例系数(RPM/像素)
+#define VEL_KI_VALUE 0.0f           // 积分系数：前馈负责跟随运动，一般不需要
+#define VEL_KD_VALUE 0.0f           // 微分系数
+#define VEL_MAX_RPM 60.0f           // 最大速度(RPM)
+#define VEL_FF_GAIN 1.0f            // 前馈系数：0为纯PID
+#define VEL_FF_FILTER 0.3f          // 前馈低通系数(0~1)：越小越平滑
+#define VEL_FF_DELAY_MS 100         // 速度估计相对当前时刻的滞后（视觉延迟 + 滤波滞后）
+#define VEL_MOTOR_ACCELERATION 240  // 速度模式加速度档位
+#define VEL_DEADZONE 2              // 死区大小（像素）：死区内只保留前馈
+#define VEL_CMD_DEADBAND 1          // 速度变化小于该值(RPM)时不重发命令
+#define VEL_FB_MAX_AGE_MS 60        // 电机定时返回超过该时间(ms)未更新时改用速度命令
+
+// 快速瞄准参数 - 按像素-脉冲标定结果直接计算转动量
+#define SNAP_DEADZONE 3                             // 死区大小（像素）
+#define SNAP_MAX_VELOCITY 100                       // 最大速度(RPM)
+#define SNAP_MAX_ACCELERATION 400.0f                // 最大加速度(RPM/s)
+#define SNAP_MAX_CLK 800                            // 单次最大脉冲数，防止标定异常时大幅转动
+#define SNAP_SETTLE_MS (PREDICTOR_LATENCY_MS + 60)  // 转动结束后等待新坐标的时间
 
 // 调整建议：
 // 1. 追踪太慢：增大PID_KP_VALUE、PID_MOTOR_VELOCITY、PID_MAX_STEP
-// 2. 追踪振荡：减小PID_KP_VALUE、PID_KD_VALUE，检查PID_MOTOR_DELAY_MS
+// 2. 追踪振荡：减小PID_KP_VALUE、PID_KD_VALUE
 // 3. 精度不够：减小PID_DEADZONE、PID_MIN_STEP
-// 4. 响应迟钝：减小PID_MOTOR_DELAY_MS，增大PID_MOTOR_ACCELERATION
+// 4. 响应迟钝：增大PID_MOTOR_ACCELERATION
 // =============================================================
 
 // 激光追踪任务相关变量
@@ -46,38 +81,180 @@ static TrackMode_t g_track_mode = TRACK_MODE_STEP;  // 默认使用步进控制
 #define LASER_CLK_STEP_MEDIUM 5  // 中等步进值
 #define LASER_CLK_STEP_LARGE 10  // 大步进值，快速调整用
 
-// PID控制器实例
-static PidController_t g_laser_track_pid_x;  // X轴PID控制器
-static PidController_t g_laser_track_pid_y;  // Y轴PID控制器
+// PID控制器组，X、Y轴两个通道一次计算
+#define LASER_PID_CH_X 0
+#define LASER_PID_CH_Y 1
+static PidBank_t g_laser_track_pid;
+static uint32_t g_laser_track_pid_tick = 0;  // 上次执行PID追踪的时刻(ms)，0为尚未执行
+
+// 各轴PID参数{kp, ki, kd}，初始为配置值，自整定完成后更新
+static float g_laser_track_gains[2][3] = {
+    {PID_KP_VALUE, PID_KI_VALUE, PID_KD_VALUE},
+    {PID_KP_VALUE, PID_KI_VALUE, PID_KD_VALUE},
+};
+static PidAutotune_t g_laser_autotune[2];  // 各轴自整定器
+
+// 速度追踪状态
+#define VEL_HISTORY_LEN 8  // 速度命令历史长度（控制周期数），需覆盖VEL_FF_DELAY_MS
+typedef struct {
+    float rpm[VEL_HISTORY_LEN];      // 速度命令历史(RPM，正为逆时针)
+    uint32_t tick[VEL_HISTORY_LEN];  // 对应时刻(ms)
+    uint8_t head;                    // 最新记录位置
+    float ff;                        // 滤波后的前馈(RPM)
+    int16_t sent;                    // 最近一次下发的速度(RPM，正为逆时针)
+} VelTrackAxis_t;
+static const uint8_t g_laser_vel_addr[2] = {STEP_MOTOR_X, STEP_MOTOR_Y};
+static PidBank_t g_laser_vel_pid;
+static VelTrackAxis_t g_laser_vel_axis[2];
+static uint32_t g_laser_vel_tick = 0;  // 上次执行速度追踪的时刻(ms)，0为尚未执行
+
+// 追踪性能统计，每次开始/停止或切换模式时重新统计
+static TrackMetrics_t g_laser_track_metrics;
+
+// 快速瞄准状态
+static uint32_t g_laser_snap_ready_tick = 0;  // 上次转动（含稳定时间）预计结束的时刻(ms)
 
 /**
  * @brief 初始化激光追踪PID控制器
  */
 static void Laser_TrackPID_Init(void)
 {
-    // 初始化X轴PID控制器
-    PID_Init(&g_laser_track_pid_x, PID_TYPE_POSITIONAL);
-    PID_SetParam(&g_laser_track_pid_x, PID_KP_VALUE, PID_KI_VALUE, PID_KD_VALUE);
-    PID_SetOutputLimit(&g_laser_track_pid_x, PID_OUTPUT_MIN, PID_OUTPUT_MAX);
-    PID_SetIntegralLimit(&g_laser_track_pid_x, PID_INTEGRAL_MIN, PID_INTEGRAL_MAX);
-
-    // 初始化Y轴PID控制器
-    PID_Init(&g_laser_track_pid_y, PID_TYPE_POSITIONAL);
-    PID_SetParam(&g_laser_track_pid_y, PID_KP_VALUE, PID_KI_VALUE, PID_KD_VALUE);
-    PID_SetOutputLimit(&g_laser_track_pid_y, PID_OUTPUT_MIN, PID_OUTPUT_MAX);
-    PID_SetIntegralLimit(&g_laser_track_pid_y, PID_INTEGRAL_MIN, PID_INTEGRAL_MAX);
+    PidBank_Init(&g_laser_track_pid, 2);
+    PidBank_SetSampleTime(&g_laser_track_pid, PID_SAMPLE_TIME);
+    g_laser_track_pid_tick = 0;
+
+    for (uint8_t ch = LASER_PID_CH_X; ch <= LASER_PID_CH_Y; ch++) {
+        PidBank_SetParam(&g_laser_track_pid, ch, g_laser_track_gains[ch][0],
+                         g_laser_track_gains[ch][1], g_laser_track_gains[ch][2]);
+        PidBank_SetOutputLimit(&g_laser_track_pid, ch, PID_OUTPUT_MIN, PID_OUTPUT_MAX);
+        PidBank_SetIntegralLimit(&g_laser_track_pid, ch, PID_INTEGRAL_MIN, PID_INTEGRAL_MAX);
+        PidBank_SetDerivativeFilter(&g_laser_track_pid, ch, PID_D_FILTER);
+        PidBank_SetAntiWindup(&g_laser_track_pid, ch, PID_ANTIWINDUP);
+    }
+}
+
+/**
+ * @brief 两轴同时开始继电自整定
+ */
+static void Laser_TrackAutotune_Start(void)
+{
+    uint32_t now = HAL_GetTick();
+    for (uint8_t ch = LASER_PID_CH_X; ch <= LASER_PID_CH_Y; ch++) {
+        PidAutotune_Start(&g_laser_autotune[ch], AUTOTUNE_RELAY_STEP, AUTOTUNE_HYSTERESIS,
+                          AUTOTUNE_RULE, now);
+    }
+}
+
+/**
+ * @brief 初始化速度追踪：速度PID和前馈状态清零，开启X/Y轴定时返回
+ */
+static void Laser_TrackVel_Init(void)
+{
+    PidBank_Init(&g_laser_vel_pid, 2);
+    PidBank_SetSampleTime(&g_laser_vel_pid, PID_SAMPLE_TIME);
+    for (uint8_t ch = LASER_PID_CH_X; ch <= LASER_PID_CH_Y; ch++) {
+        PidBank_SetParam(&g_laser_vel_pid, ch, VEL_KP_VALUE, VEL_KI_VALUE, VEL_KD_VALUE);
+        PidBank_SetOutputLimit(&g_laser_vel_pid, ch, -VEL_MAX_RPM, VEL_MAX_RPM);
+    }
+    memset(g_laser_vel_axis, 0, sizeof(g_laser_vel_axis));
+    g_laser_vel_tick = 0;
+    EmmFeedback_StartStreaming(EMM_FB_STREAM_PERIOD_MS);
+}
+
+/**
+ * @brief 下发某轴的速度命令，与上次下发的值相差小于VEL_CMD_DEADBAND时不重发
+ * @param ch 通道（轴）
+ * @param rpm 速度(RPM)，正为逆时针（使误差减小的方向，与步进控制相同）
+ */
+static void Laser_TrackVel_Send(uint8_t ch, int16_t rpm)
+{
+    VelTrackAxis_t *axis = &g_laser_vel_axis[ch];
+
+    if (abs(rpm - axis->sent) < VEL_CMD_DEADBAND && !(rpm == 0 && axis->sent != 0)) {
+        return;
+    }
+    if (GimbalMotion_VelControl(g_laser_vel_addr[ch], (rpm > 0) ? DIR_CCW : DIR_CW,
+                                (uint16_t)abs(rpm), VEL_MOTOR_ACCELERATION, false)) {
+        axis->sent = rpm;
+    }
+}
+
+/**
+ * @brief 某轴在now - VEL_FF_DELAY_MS时刻的实测转速：定时返回历史中相邻两个位置样本的差分，
+ *        取中点不晚于该时刻的最新一对（实时转速应答以1RPM为单位，低速跟随时分辨率不够）
+ * @param ch 通道（轴）
+ * @param rpm 实测转速(RPM，正为逆时针；电机应答以顺时针为正，取反)
+ * @return false 没有新鲜的定时返回样本或历史未覆盖该时刻
+ */
+static bool Laser_TrackVel_MeasuredRpm(uint8_t ch, uint32_t now, float *rpm)
+{
+    EmmFeedbackSample_t samples[EMM_FB_HISTORY_LEN];
+
+    if (!EmmFeedback_IsFresh(g_laser_vel_addr[ch], VEL_FB_MAX_AGE_MS)) {
+        return false;
+    }
+    uint8_t count = EmmFeedback_GetHistory(g_laser_vel_addr[ch], samples, EMM_FB_HISTORY_LEN);
+    for (uint8_t i = 0; i + 1 < count; i++) {
+        uint32_t span = samples[i].tick - samples[i + 1].tick;
+        if (now - samples[i].tick + span / 2 < VEL_FF_DELAY_MS) {
+            continue;
+        }
+        if (span == 0 || span > VEL_FB_MAX_AGE_MS) {
+            return false;
+        }
+        int32_t delta = samples[i].position - samples[i + 1].position;
+        *rpm = -(float)delta / (float)EMM_FB_POS_PER_REV * 60000.0f / (float)span;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 两轴减速停止（速度追踪丢失目标、停止或切换模式时）
+ */
+static void Laser_TrackVel_Halt(void)
+{
+    for (uint8_t ch = LASER_PID_CH_X; ch <= LASER_PID_CH_Y; ch++) {
+        g_laser_vel_axis[ch].ff = 0.0f;
+        Laser_TrackVel_Send(ch, 0);
+    }
 }
 
 /**
  * @brief 设置激光追踪控制模式
- * @param mode 控制模式：TRACK_MODE_STEP(步进) 或 TRACK_MODE_PID(PID)
+ * @param mode 控制模式：TRACK_MODE_STEP(步进)、TRACK_MODE_PID(PID)、TRACK_MODE_AUTOTUNE(PID自整定)
+ *             TRACK_MODE_VELOCITY(速度追踪)、TRACK_MODE_CALIBRATE(像素-脉冲标定)
+ *             或 TRACK_MODE_SNAP(快速瞄准)
  */
 void Laser_TrackAimPoint_SetMode(TrackMode_t mode)
 {
+    // 追踪中切换模式时结束上一模式的统计
+    if (TrackMetrics_Stop(&g_laser_track_metrics, HAL_GetTick())) {
+        TrackMetrics_Print(&g_laser_track_metrics);
+        TrackMetrics_Start(&g_laser_track_metrics, mode, HAL_GetTick());
+    }
+
+    // 离开速度模式时停止连续转动，关闭定时返回
+    if (g_track_mode == TRACK_MODE_VELOCITY && mode != TRACK_MODE_VELOCITY) {
+        Laser_TrackVel_Halt();
+        EmmFeedback_StopStreaming();
+    }
+    if (g_track_mode == TRACK_MODE_CALIBRATE && mode != TRACK_MODE_CALIBRATE) {
+        AimCal_Stop();
+    }
+
     g_track_mode = mode;
     if (mode == TRACK_MODE_PID) {
         // 切换到PID模式时初始化PID控制器
         Laser_TrackPID_Init();
+    } else if (mode == TRACK_MODE_AUTOTUNE) {
+        Laser_TrackAutotune_Start();
+    } else if (mode == TRACK_MODE_VELOCITY) {
+        Laser_TrackVel_Init();
+    } else if (mode == TRACK_MODE_CALIBRATE) {
+        AimCal_Start(HAL_GetTick());
+    } else if (mode == TRACK_MODE_SNAP) {
+        g_laser_snap_ready_tick = HAL_GetTick();
     }
 }
 
@@ -91,7 +268,16 @@ void Laser_TrackAimPoint_Start(void)
     // 初始化PID控制器（如果使用PID模式）
     if (g_track_mode == TRACK_MODE_PID) {
         Laser_TrackPID_Init();
+    } else if (g_track_mode == TRACK_MODE_AUTOTUNE) {
+        Laser_TrackAutotune_Start();
+    } else if (g_track_mode == TRACK_MODE_VELOCITY) {
+        Laser_TrackVel_Init();
+    } else if (g_track_mode == TRACK_MODE_CALIBRATE) {
+        AimCal_Start(HAL_GetTick());
+    } else if (g_track_mode == TRACK_MODE_SNAP) {
+        g_laser_snap_ready_tick = HAL_GetTick();
     }
+    TrackMetrics_Start(&g_laser_track_metrics, g_track_mode, HAL_GetTick());
 
     // 立即打开激光指示器
     HAL_GPIO_WritePin(OUTPUT_TEST_GPIO_Port, OUTPUT_TEST_Pin, GPIO_PIN_SET);
@@ -106,8 +292,15 @@ void Laser_TrackAimPoint_Stop(void)
 
     // 重置PID控制器（如果使用PID模式）
     if (g_track_mode == TRACK_MODE_PID) {
-        PID_Reset(&g_laser_track_pid_x);
-        PID_Reset(&g_laser_track_pid_y);
+        PidBank_Reset(&g_laser_track_pid);
+    } else if (g_track_mode == TRACK_MODE_VELOCITY) {
+        Laser_TrackVel_Halt();
+        EmmFeedback_StopStreaming();
+    } else if (g_track_mode == TRACK_MODE_CALIBRATE) {
+        AimCal_Stop();
+    }
+    if (TrackMetrics_Stop(&g_laser_track_metrics, HAL_GetTick())) {
+        TrackMetrics_Print(&g_laser_track_metrics);
     }
 
     // 关闭激光指示器
@@ -132,9 +325,10 @@ static bool Laser_Track_StepControl(void)
     const uint8_t acc = 10;       // 电机加速度
     const uint16_t DEADZONE = 3;  // 死区范围
 
-    // 计算误差
-    int16_t error_x = g_curr_center_point.x - g_sensor_aim_x;
-    int16_t error_y = g_curr_center_point.y - g_sensor_aim_y;
+    // 计算误差（使用外推到当前时刻的目标位置）
+    PixelPoint_t target = Predictor_GetTarget();
+    int16_t error_x = target.x - g_sensor_aim_x;
+    int16_t error_y = target.y - g_sensor_aim_y;
 
     // 如果误差在死区内，不做调整
     if (abs(error_x) < DEADZONE && abs(error_y) < DEADZONE) {
@@ -162,21 +356,10 @@ static bool Laser_Track_StepControl(void)
         step_y = LASER_CLK_STEP_LARGE;
     }
 
-    // 控制X轴电机
-    if (error_x > 0) {
-        Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CCW, vel, acc, step_x, false, false);
-    } else if (error_x < 0) {
-        Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CW, vel, acc, step_x, false, false);
-    }
-
-    HAL_Delay(20);  // 延时避免指令冲突
-
-    // 控制Y轴电机
-    if (error_y > 0) {
-        Emm_V5_Pos_Control(STEP_MOTOR_Y, DIR_CCW, vel, acc, step_y, false, false);
-    } else if (error_y < 0) {
-        Emm_V5_Pos_Control(STEP_MOTOR_Y, DIR_CW, vel, acc, step_y, false, false);
-    }
+    // X/Y轴同步运动（非阻塞，一帧多电机命令发出后两轴同时启动）
+    GimbalMotion_MoveXY((error_x > 0) ? DIR_CCW : DIR_CW, (error_x != 0) ? step_x : 0,
+                        (error_y > 0) ? DIR_CCW : DIR_CW, (error_y != 0) ? step_y : 0, vel, acc,
+                        false);
 
     return false;  // 仍在调整中
 }
@@ -191,9 +374,16 @@ static bool Laser_Track_PIDControl(void)
     const uint8_t acc = PID_MOTOR_ACCELERATION;  // 使用配置的电机加速度
     const uint16_t DEADZONE = PID_DEADZONE;      // 使用配置的死区
 
-    // 计算误差（目标位置 - 当前位置）
-    float error_x = (float)(g_sensor_aim_x - g_curr_center_point.x);
-    float error_y = (float)(g_sensor_aim_y - g_curr_center_point.y);
+    // 实测控制周期，积分、微分项按实际周期缩放
+    uint32_t now = HAL_GetTick();
+    float dt = (g_laser_track_pid_tick != 0) ? (float)(now - g_laser_track_pid_tick) * 0.001f
+                                             : 0.0f;
+    g_laser_track_pid_tick = now;
+
+    // 误差方向与步进控制相同：误差为正时逆时针转动使误差减小
+    PixelPoint_t target = Predictor_GetTarget();
+    float error_x = (float)(target.x - g_sensor_aim_x);
+    float error_y = (float)(target.y - g_sensor_aim_y);
 
     // 如果误差在死区内，不做调整
     if (abs(error_x) < DEADZONE && abs(error_y) < DEADZONE) {
@@ -201,58 +391,228 @@ static bool Laser_Track_PIDControl(void)
     }
 
     // 设置PID目标值为0（即消除误差）
-    PID_SetTarget(&g_laser_track_pid_x, 0.0f);
-    PID_SetTarget(&g_laser_track_pid_y, 0.0f);
+    PidBank_SetTarget(&g_laser_track_pid, LASER_PID_CH_X, 0.0f);
+    PidBank_SetTarget(&g_laser_track_pid, LASER_PID_CH_Y, 0.0f);
 
-    // 计算PID输出（步进数），将误差作为当前值输入
-    float pid_output_x = PID_Compute(&g_laser_track_pid_x, -error_x);  // 负号使得输出方向正确
-    float pid_output_y = PID_Compute(&g_laser_track_pid_y, -error_y);
+    // 计算PID输出（步进数），将误差作为当前值输入，两轴一次计算
+    const float current[2] = {-error_x, -error_y};  // 负号使得输出方向正确
+    const float *pid_output = PidBank_ComputeDt(&g_laser_track_pid, current, dt);
+    float pid_output_x = pid_output[LASER_PID_CH_X];
+    float pid_output_y = pid_output[LASER_PID_CH_Y];
 
-    // 限制步进值范围
-    uint16_t step_x = (uint16_t)abs(pid_output_x);
-    uint16_t step_y = (uint16_t)abs(pid_output_y);
+    // 输出为正时逆时针转动，步数取输出的绝对值并四舍五入
+    uint16_t step_x = (uint16_t)fminf(fabsf(pid_output_x) + 0.5f, (float)PID_MAX_STEP);
+    uint16_t step_y = (uint16_t)fminf(fabsf(pid_output_y) + 0.5f, (float)PID_MAX_STEP);
 
     if (step_x > 0 && step_x < PID_MIN_STEP)
         step_x = PID_MIN_STEP;  // 使用配置的最小步进
     if (step_y > 0 && step_y < PID_MIN_STEP)
         step_y = PID_MIN_STEP;
 
-    if (step_x > PID_MAX_STEP)
-        step_x = PID_MAX_STEP;  // 使用配置的最大步进限制
-    if (step_y > PID_MAX_STEP)
-        step_y = PID_MAX_STEP;
+    // X/Y轴同步运动，方向和步数都来自带符号的PID输出，死区内的轴不动
+    GimbalMotion_MoveXY((pid_output_x > 0.0f) ? DIR_CCW : DIR_CW,
+                        (fabsf(error_x) > DEADZONE) ? step_x : 0,
+                        (pid_output_y > 0.0f) ? DIR_CCW : DIR_CW,
+                        (fabsf(error_y) > DEADZONE) ? step_y : 0, vel, acc, false);
+
+    return false;  // 仍在调整中
+}
 
-    // 控制X轴电机（根据误差方向直接判断）
-    if (abs(error_x) > DEADZONE) {
-        if (error_x > 0) {
-            // 目标在右侧，需要右转
-            Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CCW, vel, acc, step_x, false, false);
+/**
+ * @brief 两轴自整定结束：成功的轴更新PID参数，然后切换到PID模式
+ */
+static void Laser_TrackAutotune_Finish(void)
+{
+    static const char axis_name[2] = {'X', 'Y'};
+
+    for (uint8_t ch = LASER_PID_CH_X; ch <= LASER_PID_CH_Y; ch++) {
+        const PidAutotune_t *at = &g_laser_autotune[ch];
+        float *gains = g_laser_track_gains[ch];
+        if (PidAutotune_GetGains(at, PID_SAMPLE_TIME, &gains[0], &gains[1], &gains[2])) {
+            printf("Autotune %c: Ku=%.3f Pu=%.3fs -> Kp=%.3f Ki=%.4f Kd=%.3f\r\n", axis_name[ch],
+                   at->ku, at->pu, gains[0], gains[1], gains[2]);
         } else {
-            // 目标在左侧，需要左转
-            Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CW, vel, acc, step_x, false, false);
+            printf("Autotune %c failed, keep Kp=%.3f Ki=%.4f Kd=%.3f\r\n", axis_name[ch], gains[0],
+                   gains[1], gains[2]);
         }
     }
 
-    HAL_Delay(PID_MOTOR_DELAY_MS);  // 使用配置的延时
+    Laser_TrackAimPoint_SetMode(TRACK_MODE_PID);
+}
 
-    // 控制Y轴电机（根据误差方向直接判断）
-    if (abs(error_y) > DEADZONE) {
-        if (error_y > 0) {
-            // 目标在上方，需要上转
-            Emm_V5_Pos_Control(STEP_MOTOR_Y, DIR_CCW, vel, acc, step_y, false, false);
+/**
+ * @brief PID自整定方式的运动追踪
+ *        两轴各自以±AUTOTUNE_RELAY_STEP步的继电输出围绕目标振荡，两轴都结束后切换到PID模式
+ * @return false 自整定期间不认为已对准
+ */
+static bool Laser_Track_AutotuneControl(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    // 误差方向与步进控制相同：误差为正时逆时针转动使误差减小
+    PixelPoint_t target = Predictor_GetTarget();
+    float error_x = (float)(target.x - g_sensor_aim_x);
+    float error_y = (float)(target.y - g_sensor_aim_y);
+
+    float relay_x = PidAutotune_Update(&g_laser_autotune[LASER_PID_CH_X], error_x, now);
+    float relay_y = PidAutotune_Update(&g_laser_autotune[LASER_PID_CH_Y], error_y, now);
+
+    if (PidAutotune_GetState(&g_laser_autotune[LASER_PID_CH_X]) != AUTOTUNE_RUNNING &&
+        PidAutotune_GetState(&g_laser_autotune[LASER_PID_CH_Y]) != AUTOTUNE_RUNNING) {
+        Laser_TrackAutotune_Finish();
+        return false;
+    }
+
+    GimbalMotion_MoveXY((relay_x > 0) ? DIR_CCW : DIR_CW, (uint16_t)fabsf(relay_x),
+                        (relay_y > 0) ? DIR_CCW : DIR_CW, (uint16_t)fabsf(relay_y),
+                        PID_MOTOR_VELOCITY, PID_MOTOR_ACCELERATION, false);
+
+    return false;
+}
+
+/**
+ * @brief 速度追踪：速度命令 = 前馈 + PID(像素误差)
+ *        相机随云台转动，图像中的目标速度是目标运动与云台转动之差，
+ *        目标运动对应的转速 = 标定模型的逆（含符号和交叉耦合）抵消图像速度所需的转速 + 测量时刻的云台转速；
+ *        速度估计滞后约VEL_FF_DELAY_MS，取该时刻电机定时返回的实测转速与之对应（没有时取该时刻的速度命令），
+ *        否则前馈会与自身的转动形成正反馈
+ * @return true 在死区内（已对准），false 仍在调整中
+ */
+static bool Laser_Track_VelocityControl(void)
+{
+    uint32_t now = HAL_GetTick();
+    float dt = (g_laser_vel_tick != 0) ? (float)(now - g_laser_vel_tick) * 0.001f : 0.0f;
+    g_laser_vel_tick = now;
+
+    // 误差方向与步进控制相同：误差为正时逆时针转动使误差减小
+    PixelPoint_t target = Predictor_GetTarget();
+    float error[2] = {(float)(target.x - g_sensor_aim_x), (float)(target.y - g_sensor_aim_y)};
+    float image_vel[2];
+    bool vel_valid = Predictor_GetVelocity(&image_vel[0], &image_vel[1]);
+
+    // 图像速度换算为两轴转速(脉冲/s)：转动使目标在图像中的速度为-image_vel时抵消目标运动
+    float image_clk_vel[2];
+    if (vel_valid) {
+        vel_valid = AimCal_PixelVelToClkVel(-image_vel[0], -image_vel[1], image_clk_vel);
+    }
+
+    const float current[2] = {-error[0], -error[1]};
+    const float *pid_output = PidBank_ComputeDt(&g_laser_vel_pid, current, dt);
+    bool aligned = fabsf(error[0]) < VEL_DEADZONE && fabsf(error[1]) < VEL_DEADZONE;
+
+    for (uint8_t ch = LASER_PID_CH_X; ch <= LASER_PID_CH_Y; ch++) {
+        VelTrackAxis_t *axis = &g_laser_vel_axis[ch];
+
+        // 找到速度估计对应时刻的云台转速：优先用实测值，否则用速度命令
+        float rpm_then = 0.0f;
+        if (!Laser_TrackVel_MeasuredRpm(ch, now, &rpm_then)) {
+            for (uint8_t n = 0; n < VEL_HISTORY_LEN; n++) {
+                uint8_t i = (axis->head + VEL_HISTORY_LEN - n) % VEL_HISTORY_LEN;
+                rpm_then = axis->rpm[i];
+                if (now - axis->tick[i] >= VEL_FF_DELAY_MS) {
+                    break;
+                }
+            }
+        }
+
+        if (vel_valid) {
+            float ff = image_clk_vel[ch] * 60.0f / (float)TRAJ_PULSES_PER_REV + rpm_then;
+            axis->ff += VEL_FF_FILTER * (ff - axis->ff);
         } else {
-            // 目标在下方，需要下转
-            Emm_V5_Pos_Control(STEP_MOTOR_Y, DIR_CW, vel, acc, step_y, false, false);
+            axis->ff = 0.0f;
+        }
+
+        float rpm = VEL_FF_GAIN * axis->ff;
+        if (fabsf(error[ch]) >= VEL_DEADZONE) {
+            rpm += pid_output[ch];
         }
+        if (rpm > VEL_MAX_RPM) {
+            rpm = VEL_MAX_RPM;
+        } else if (rpm < -VEL_MAX_RPM) {
+            rpm = -VEL_MAX_RPM;
+        }
+
+        axis->head = (axis->head + 1) % VEL_HISTORY_LEN;
+        axis->rpm[axis->head] = rpm;
+        axis->tick[axis->head] = now;
+
+        Laser_TrackVel_Send(ch, (int16_t)lrintf(rpm));
     }
 
-    return false;  // 仍在调整中
+    return aligned;
+}
+
+/**
+ * @brief 像素-脉冲标定，结束后打印结果并切换到快速瞄准模式
+ * @return false 标定期间不认为已对准
+ */
+static bool Laser_Track_CalibrateControl(void)
+{
+    // 使用原始坐标：外推的位置包含云台转动引起的速度估计
+    AimCalState_t state = AimCal_Update(g_curr_center_point, HAL_GetTick());
+    if (state == AIM_CAL_DONE || state == AIM_CAL_FAILED) {
+        AimCal_Print();
+        Laser_TrackAimPoint_SetMode(TRACK_MODE_SNAP);
+    }
+    return false;
+}
+
+/**
+ * @brief 快速瞄准：按标定模型由像素误差直接计算两轴脉冲数，一次转到位，
+ *        等待转动结束和新的视觉坐标后再根据剩余误差修正，通常一到两次转动对准
+ * @return true 在死区内（已对准），false 仍在调整中
+ */
+static bool Laser_Track_SnapControl(void)
+{
+    if (!g_aim_cal_model.valid) {
+        return Laser_Track_StepControl();
+    }
+
+    // 上次转动和视觉延迟结束前的坐标不可用
+    uint32_t now = HAL_GetTick();
+    if ((int32_t)(now - g_laser_snap_ready_tick) < 0) {
+        return false;
+    }
+
+    // 使用原始坐标：转动期间预测器的速度估计不代表目标运动
+    float dx = (float)g_sensor_aim_x - (float)g_curr_center_point.x;
+    float dy = (float)g_sensor_aim_y - (float)g_curr_center_point.y;
+    if (fabsf(dx) < SNAP_DEADZONE && fabsf(dy) < SNAP_DEADZONE) {
+        return true;  // 已对准
+    }
+
+    int32_t clk_x, clk_y;
+    AimCal_PixelToClk(dx, dy, &clk_x, &clk_y);
+
+    // 超过单次最大脉冲数时两轴按比例缩小，保持方向
+    uint32_t clk_max = (uint32_t)((abs(clk_x) > abs(clk_y)) ? abs(clk_x) : abs(clk_y));
+    if (clk_max == 0) {
+        return true;
+    }
+    if (clk_max > SNAP_MAX_CLK) {
+        clk_x = clk_x * SNAP_MAX_CLK / (int32_t)clk_max;
+        clk_y = clk_y * SNAP_MAX_CLK / (int32_t)clk_max;
+        clk_max = SNAP_MAX_CLK;
+    }
+
+    // 按行程较长的轴规划速度和加速度，两轴使用相同参数同时启动
+    Trajectory_t traj;
+    if (!Trajectory_Plan(&traj, clk_max, SNAP_MAX_VELOCITY, SNAP_MAX_ACCELERATION)) {
+        return false;
+    }
+    if (GimbalMotion_MoveXY((clk_x > 0) ? DIR_CCW : DIR_CW, (uint32_t)abs(clk_x),
+                            (clk_y > 0) ? DIR_CCW : DIR_CW, (uint32_t)abs(clk_y), traj.vel,
+                            traj.acc, false)) {
+        g_laser_snap_ready_tick = now + traj.duration_ms + SNAP_SETTLE_MS;
+    }
+
+    return false;
 }
 
 /**
  * @brief 激光追踪瞄准点功能实现
  * 区别于Q2：先打开激光，然后持续追踪目标点（无超时限制）
- * 支持两种控制模式：步进控制和PID控制
+ * 支持六种控制模式：步进控制、PID控制、PID自整定、速度追踪、像素-脉冲标定和快速瞄准
  */
 void Laser_TrackAimPoint(void)
 {
@@ -261,8 +621,12 @@ void Laser_TrackAimPoint(void)
         return;
     }
 
-    // 如果当前坐标为(0, 0)，则不执行任何操作
+    // 如果当前坐标为(0, 0)，则不执行任何操作（速度模式下先停止连续转动）
     if (g_curr_center_point.x == 0 && g_curr_center_point.y == 0) {
+        TrackMetrics_Lost(&g_laser_track_metrics);
+        if (g_track_mode == TRACK_MODE_VELOCITY) {
+            Laser_TrackVel_Halt();
+        }
         return;
     }
 
@@ -278,13 +642,31 @@ void Laser_TrackAimPoint(void)
             is_aligned = Laser_Track_PIDControl();
             break;
 
+        case TRACK_MODE_AUTOTUNE:
+            is_aligned = Laser_Track_AutotuneControl();
+            break;
+
+        case TRACK_MODE_VELOCITY:
+            is_aligned = Laser_Track_VelocityControl();
+            break;
+
+        case TRACK_MODE_CALIBRATE:
+            is_aligned = Laser_Track_CalibrateControl();
+            break;
+
+        case TRACK_MODE_SNAP:
+            is_aligned = Laser_Track_SnapControl();
+            break;
+
         default:
             // 默认使用步进控制
             is_aligned = Laser_Track_StepControl();
             break;
     }
 
-    // 可以在这里添加对准状态的处理逻辑
-    // 例如：记录对准时间、状态指示等
-    (void)is_aligned;  // 暂时不使用，避免编译警告
+    // 记录对准状态和实际指向误差
+    TrackMetrics_Update(&g_laser_track_metrics,
+                        (float)g_curr_center_point.x - (float)g_sensor_aim_x,
+                        (float)g_curr_center_point.y - (float)g_sensor_aim_y, is_aligned,
+                        HAL_GetTick());
 }
@@ -0,0 +1,113 @@
+#include "track_metrics.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "gimbal_motion.h"
+
+/**
+ * @brief 开始统计
+ * @param metrics 统计数据
+ * @param mode 控制模式
+ * @param tick 当前时刻(ms)
+ */
+void TrackMetrics_Start(TrackMetrics_t *metrics, TrackMode_t mode, uint32_t tick)
+{
+    if (metrics == NULL) {
+        return;
+    }
+    memset(metrics, 0, sizeof(TrackMetrics_t));
+    metrics->mode = mode;
+    metrics->start_tick = tick;
+    metrics->cmd_start = GimbalMotion_GetSentCount();
+    metrics->running = true;
+}
+
+/**
+ * @brief 每个有目标的控制周期调用一次
+ * @param metrics 统计数据
+ * @param error_x X方向误差(像素)
+ * @param error_y Y方向误差(像素)
+ * @param aligned 控制器是否认为已对准
+ * @param tick 当前时刻(ms)
+ */
+void TrackMetrics_Update(TrackMetrics_t *metrics, float error_x, float error_y, bool aligned,
+                         uint32_t tick)
+{
+    if (metrics == NULL || !metrics->running) {
+        return;
+    }
+
+    float error_sq = error_x * error_x + error_y * error_y;
+    metrics->samples++;
+    metrics->sum_sq += error_sq;
+
+    if (!metrics->locked) {
+        metrics->aligned_run = aligned ? metrics->aligned_run + 1 : 0;
+        if (metrics->aligned_run == 1) {
+            metrics->lock_tick = tick;
+        }
+        if (metrics->aligned_run >= TRACK_METRICS_LOCK_FRAMES) {
+            metrics->locked = true;
+        }
+        return;
+    }
+
+    metrics->locked_samples++;
+    metrics->locked_sum_sq += error_sq;
+    float error = sqrtf(error_sq);
+    if (error > metrics->locked_max) {
+        metrics->locked_max = error;
+    }
+}
+
+/**
+ * @brief 目标丢失的控制周期调用
+ */
+void TrackMetrics_Lost(TrackMetrics_t *metrics)
+{
+    if (metrics == NULL || !metrics->running) {
+        return;
+    }
+    metrics->lost++;
+}
+
+/**
+ * @brief 结束统计
+ * @param metrics 统计数据
+ * @param tick 当前时刻(ms)
+ * @return true 已结束，false 未在统计
+ */
+bool TrackMetrics_Stop(TrackMetrics_t *metrics, uint32_t tick)
+{
+    if (metrics == NULL || !metrics->running) {
+        return false;
+    }
+    metrics->stop_tick = tick;
+    metrics->cmd_count = GimbalMotion_GetSentCount() - metrics->cmd_start;
+    metrics->running = false;
+    return true;
+}
+
+/**
+ * @brief 打印统计结果（结束后调用）
+ *        lock: 锁定时间(ms)，未锁定为-1；rms: 全程RMS误差；lock_rms/lock_max: 锁定后的RMS/最大误差
+ */
+void TrackMetrics_Print(const TrackMetrics_t *metrics)
+{
+    if (metrics == NULL || metrics->samples == 0) {
+        return;
+    }
+
+    long lock_ms = metrics->locked ? (long)(metrics->lock_tick - metrics->start_tick) : -1L;
+    float rms = sqrtf(metrics->sum_sq / (float)metrics->samples);
+    float locked_rms = (metrics->locked_samples > 0)
+                           ? sqrtf(metrics->locked_sum_sq / (float)metrics->locked_samples)
+                           : 0.0f;
+
+    printf("Track mode=%d time=%lums lock=%ldms rms=%.2fpx lock_rms=%.2fpx lock_max=%.2fpx "
+           "lost=%lu cmd=%lu\r\n",
+           (int)metrics->mode, (unsigned long)(metrics->stop_tick - metrics->start_tick), lock_ms,
+           rms, locked_rms, metrics->locked_max, (unsigned long)metrics->lost,
+           (unsigned long)metrics->cmd_count);
+}
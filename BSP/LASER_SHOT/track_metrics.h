@@ -0,0 +1,46 @@
+/**
+ * @file track_metrics.h
+ * @author Shiki
+ * @brief 追踪性能统计
+ *        每次追踪（开始到停止或切换模式）统计锁定时间、锁定前后的RMS指向误差、最大误差、
+ *        目标丢失次数和下发的云台命令数，结束时打印一行，便于在同一场景下比较不同版本和参数。
+ *        误差使用原始视觉坐标（不外推），即激光实际偏离目标的像素数。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __TRACK_METRICS_H
+#define __TRACK_METRICS_H
+
+#include "laser_shot_common.h"
+
+#define TRACK_METRICS_LOCK_FRAMES 3  // 连续对准的周期数，达到后认为锁定
+
+typedef struct {
+    bool running;             // 是否正在统计
+    TrackMode_t mode;         // 控制模式
+    uint32_t start_tick;      // 开始时刻(ms)
+    uint32_t lock_tick;       // 锁定时刻(ms)，首次连续对准的第一个周期
+    uint32_t stop_tick;       // 结束时刻(ms)
+    bool locked;              // 是否已锁定
+    uint8_t aligned_run;      // 当前连续对准的周期数
+    uint32_t samples;         // 有目标的周期数
+    uint32_t lost;            // 目标丢失的周期数
+    uint32_t locked_samples;  // 锁定后的周期数
+    float sum_sq;             // 误差平方和(像素²)
+    float locked_sum_sq;      // 锁定后的误差平方和(像素²)
+    float locked_max;         // 锁定后的最大误差(像素)
+    uint32_t cmd_start;       // 开始时已发出的云台命令数
+    uint32_t cmd_count;       // 统计期间发出的云台命令数
+} TrackMetrics_t;
+
+void TrackMetrics_Start(TrackMetrics_t *metrics, TrackMode_t mode, uint32_t tick);
+void TrackMetrics_Update(TrackMetrics_t *metrics, float error_x, float error_y, bool aligned,
+                         uint32_t tick);
+void TrackMetrics_Lost(TrackMetrics_t *metrics);
+bool TrackMetrics_Stop(TrackMetrics_t *metrics, uint32_t tick);
+void TrackMetrics_Print(const TrackMetrics_t *metrics);
+
+#endif
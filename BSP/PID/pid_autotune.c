@@ -0,0 +1,162 @@
+#include "pid_autotune.h"
+
+#include <math.h>
+#include <string.h>
+
+#define PID_AUTOTUNE_PI 3.14159265f
+
+/**
+ * @brief 完成整定：由平均周期和幅值计算临界增益和临界周期
+ */
+static void PidAutotune_Finish(PidAutotune_t *at)
+{
+    float amplitude = at->amplitude_sum / (float)at->cycles;
+    float a2 = amplitude * amplitude - at->hysteresis * at->hysteresis;
+
+    // 滞环大于振荡幅值时无法得到有效的临界增益
+    if (a2 <= 0.0f) {
+        at->state = AUTOTUNE_FAILED;
+        at->output = 0.0f;
+        return;
+    }
+
+    at->ku = 4.0f * at->relay / (PID_AUTOTUNE_PI * sqrtf(a2));
+    at->pu = at->period_sum / (float)at->cycles * 0.001f;
+    at->state = AUTOTUNE_DONE;
+    at->output = 0.0f;
+}
+
+/**
+ * @brief 开始继电反馈整定
+ * @param at 整定器指针
+ * @param relay 继电输出幅值d（控制器输出单位），需足以使被控对象明显振荡
+ * @param hysteresis 继电滞环ε（误差单位），应略大于测量噪声，防止噪声引起继电抖动
+ * @param rule 参数整定规则
+ * @param tick 当前时刻(ms)
+ */
+void PidAutotune_Start(PidAutotune_t *at, float relay, float hysteresis, AutotuneRule_t rule,
+                       uint32_t tick)
+{
+    if (at == NULL) {
+        return;
+    }
+    memset(at, 0, sizeof(PidAutotune_t));
+    at->rule = rule;
+    at->relay = relay;
+    at->hysteresis = hysteresis;
+    at->start_tick = tick;
+    at->output = relay;
+    at->state = AUTOTUNE_RUNNING;
+}
+
+/**
+ * @brief 中止整定
+ */
+void PidAutotune_Stop(PidAutotune_t *at)
+{
+    if (at == NULL) {
+        return;
+    }
+    at->state = AUTOTUNE_IDLE;
+    at->output = 0.0f;
+}
+
+/**
+ * @brief 输入当前误差，返回继电输出
+ *        误差超过+ε时输出+d，低于-ε时输出-d，其间保持；输出由负变正记为一个周期，
+ *        第一个周期为过渡过程不计入，测满PID_AUTOTUNE_CYCLES个周期后完成
+ * @param at 整定器指针
+ * @param error 误差（目标值 - 当前值，与PID_Compute()相同的符号）
+ * @param tick 当前时刻(ms)
+ * @return 继电输出，整定未运行时返回0
+ */
+float PidAutotune_Update(PidAutotune_t *at, float error, uint32_t tick)
+{
+    if (at == NULL || at->state != AUTOTUNE_RUNNING) {
+        return 0.0f;
+    }
+
+    if (tick - at->start_tick > PID_AUTOTUNE_TIMEOUT_MS) {
+        at->state = AUTOTUNE_FAILED;
+        at->output = 0.0f;
+        return 0.0f;
+    }
+
+    if (error > at->error_max) {
+        at->error_max = error;
+    }
+    if (error < at->error_min) {
+        at->error_min = error;
+    }
+
+    if (at->output < 0.0f && error > at->hysteresis) {
+        at->output = at->relay;
+
+        // 第一次由负变正之前的数据为过渡过程，第二次起每次得到一个完整周期
+        if (at->rises >= 2) {
+            at->period_sum += (float)(tick - at->rise_tick);
+            at->amplitude_sum += (at->error_max - at->error_min) * 0.5f;
+            at->cycles++;
+        }
+        if (at->rises < UINT8_MAX) {
+            at->rises++;
+        }
+        at->rise_tick = tick;
+        at->error_max = error;
+        at->error_min = error;
+
+        if (at->cycles >= PID_AUTOTUNE_CYCLES) {
+            PidAutotune_Finish(at);
+        }
+    } else if (at->output > 0.0f && error < -at->hysteresis) {
+        at->output = -at->relay;
+    }
+
+    return at->output;
+}
+
+/**
+ * @brief 获取整定状态
+ */
+AutotuneState_t PidAutotune_GetState(const PidAutotune_t *at)
+{
+    if (at == NULL) {
+        return AUTOTUNE_IDLE;
+    }
+    return at->state;
+}
+
+/**
+ * @brief 按整定规则计算离散PID参数（与PID_Compute()相同的每采样周期增益）
+ *        ki = Kp*Ts/Ti，kd = Kp*Td/Ts
+ * @param at 整定器指针
+ * @param sample_time PID的采样周期(s)
+ * @param kp 比例系数输出
+ * @param ki 积分系数输出
+ * @param kd 微分系数输出
+ * @return true 计算成功，false 整定未完成
+ */
+bool PidAutotune_GetGains(const PidAutotune_t *at, float sample_time, float *kp, float *ki,
+                          float *kd)
+{
+    if (at == NULL || at->state != AUTOTUNE_DONE || sample_time <= 0.0f || kp == NULL ||
+        ki == NULL || kd == NULL) {
+        return false;
+    }
+
+    float gain, ti, td;
+    if (at->rule == AUTOTUNE_RULE_TL) {
+        gain = at->ku / 2.2f;
+        ti = 2.2f * at->pu;
+        td = at->pu / 6.3f;
+    } else {
+        gain = 0.6f * at->ku;
+        ti = 0.5f * at->pu;
+        td = 0.125f * at->pu;
+    }
+
+    *kp = gain;
+    *ki = gain * sample_time / ti;
+    *kd = gain * td / sample_time;
+    return true;
+}
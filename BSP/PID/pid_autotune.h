@@ -0,0 +1,61 @@
+/**
+ * @file pid_autotune.h
+ * @author Shiki
+ * @brief 继电反馈（Åström–Hägglund）PID自整定
+ *        以±d的继电（带滞环）输出驱动被控对象，使误差产生等幅振荡，测量振荡周期Pu和幅值a，
+ *        得到临界增益Ku = 4d/(π*sqrt(a²-ε²))，再按Ziegler–Nichols或Tyreus–Luyben规则计算PID参数。
+ *        每个控制周期调用一次PidAutotune_Update()，不阻塞。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __PID_AUTOTUNE_H
+#define __PID_AUTOTUNE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PID_AUTOTUNE_CYCLES 3           // 参与平均的振荡周期数（不含第一个过渡周期）
+#define PID_AUTOTUNE_TIMEOUT_MS 15000   // 超时时间
+
+typedef enum {
+    AUTOTUNE_IDLE = 0,  // 未运行
+    AUTOTUNE_RUNNING,   // 继电振荡中
+    AUTOTUNE_DONE,      // 整定完成
+    AUTOTUNE_FAILED     // 超时或振荡无效
+} AutotuneState_t;
+
+typedef enum {
+    AUTOTUNE_RULE_ZN = 0,  // Ziegler–Nichols：Kp=0.6Ku, Ti=Pu/2, Td=Pu/8，响应快、超调较大
+    AUTOTUNE_RULE_TL       // Tyreus–Luyben：Kp=Ku/2.2, Ti=2.2Pu, Td=Pu/6.3，更保守
+} AutotuneRule_t;
+
+typedef struct {
+    AutotuneState_t state;  // 整定状态
+    AutotuneRule_t rule;    // 参数整定规则
+    float relay;            // 继电输出幅值d
+    float hysteresis;       // 继电滞环ε（误差单位）
+    float output;           // 当前继电输出
+    float error_max;        // 当前周期的误差最大值
+    float error_min;        // 当前周期的误差最小值
+    float period_sum;       // 已测周期之和(ms)
+    float amplitude_sum;    // 已测幅值之和
+    uint32_t start_tick;    // 开始时刻(ms)
+    uint32_t rise_tick;     // 上一次继电输出由负变正的时刻(ms)
+    uint8_t rises;          // 继电输出由负变正的次数
+    uint8_t cycles;         // 已测周期数
+    float ku;               // 临界增益
+    float pu;               // 临界周期(s)
+} PidAutotune_t;
+
+void PidAutotune_Start(PidAutotune_t *at, float relay, float hysteresis, AutotuneRule_t rule,
+                       uint32_t tick);
+void PidAutotune_Stop(PidAutotune_t *at);
+float PidAutotune_Update(PidAutotune_t *at, float error, uint32_t tick);
+AutotuneState_t PidAutotune_GetState(const PidAutotune_t *at);
+bool PidAutotune_GetGains(const PidAutotune_t *at, float sample_time, float *kp, float *ki,
+                          float *kd);
+
+#endif
@@ -0,0 +1,255 @@
+#include "pid_bank.h"
+
+#include <string.h>
+
+/**
+ * @brief 检查通道号是否有效
+ */
+static bool PidBank_ValidChannel(const PidBank_t *bank, uint8_t ch)
+{
+    return bank != NULL && ch < bank->size;
+}
+
+/**
+ * @brief 限制数值在指定范围内（与PID_Limit()相同）
+ */
+static float PidBank_Limit(float value, float min, float max)
+{
+    if (value > max) {
+        return max;
+    }
+    if (value < min) {
+        return min;
+    }
+    return value;
+}
+
+/**
+ * @brief 初始化控制器组，各通道默认参数与PID_Init()相同
+ * @param bank 控制器组指针
+ * @param size 通道数，1~PID_BANK_MAX
+ * @return true 初始化成功，false 参数不合法
+ */
+bool PidBank_Init(PidBank_t *bank, uint8_t size)
+{
+    if (bank == NULL || size == 0 || size > PID_BANK_MAX) {
+        return false;
+    }
+
+    memset(bank, 0, sizeof(PidBank_t));
+    bank->size = size;
+    for (uint8_t i = 0; i < size; i++) {
+        bank->output_max[i] = 1000.0f;
+        bank->output_min[i] = -1000.0f;
+        bank->integral_max[i] = 100.0f;
+        bank->integral_min[i] = -100.0f;
+        bank->weight_p[i] = 1.0f;
+        bank->weight_d[i] = 1.0f;
+    }
+    bank->enable = true;
+    return true;
+}
+
+/**
+ * @brief 设置某一通道的PID参数
+ */
+void PidBank_SetParam(PidBank_t *bank, uint8_t ch, float kp, float ki, float kd)
+{
+    if (!PidBank_ValidChannel(bank, ch)) {
+        return;
+    }
+    bank->kp[ch] = kp;
+    bank->ki[ch] = ki;
+    bank->kd[ch] = kd;
+}
+
+/**
+ * @brief 设置某一通道的目标值
+ */
+void PidBank_SetTarget(PidBank_t *bank, uint8_t ch, float target)
+{
+    if (!PidBank_ValidChannel(bank, ch)) {
+        return;
+    }
+    bank->target[ch] = target;
+}
+
+/**
+ * @brief 设置某一通道的输出限制
+ */
+void PidBank_SetOutputLimit(PidBank_t *bank, uint8_t ch, float min, float max)
+{
+    if (!PidBank_ValidChannel(bank, ch)) {
+        return;
+    }
+    bank->output_min[ch] = min;
+    bank->output_max[ch] = max;
+}
+
+/**
+ * @brief 设置某一通道的积分限制
+ */
+void PidBank_SetIntegralLimit(PidBank_t *bank, uint8_t ch, float min, float max)
+{
+    if (!PidBank_ValidChannel(bank, ch)) {
+        return;
+    }
+    bank->integral_min[ch] = min;
+    bank->integral_max[ch] = max;
+}
+
+/**
+ * @brief 设置某一通道的设定值权重，见PID_SetSetpointWeight()
+ */
+void PidBank_SetSetpointWeight(PidBank_t *bank, uint8_t ch, float weight_p, float weight_d)
+{
+    if (!PidBank_ValidChannel(bank, ch)) {
+        return;
+    }
+    bank->weight_p[ch] = weight_p;
+    bank->weight_d[ch] = weight_d;
+}
+
+/**
+ * @brief 设置某一通道的微分低通滤波系数，见PID_SetDerivativeFilter()
+ */
+void PidBank_SetDerivativeFilter(PidBank_t *bank, uint8_t ch, float alpha)
+{
+    if (!PidBank_ValidChannel(bank, ch)) {
+        return;
+    }
+    bank->d_alpha[ch] = PidBank_Limit(alpha, 0.0f, 1.0f);
+}
+
+/**
+ * @brief 设置某一通道的反算抗饱和系数，见PID_SetAntiWindup()
+ */
+void PidBank_SetAntiWindup(PidBank_t *bank, uint8_t ch, float kaw)
+{
+    if (!PidBank_ValidChannel(bank, ch)) {
+        return;
+    }
+    bank->kaw[ch] = kaw;
+}
+
+/**
+ * @brief 设置标称采样周期，见PID_SetSampleTime()
+ */
+void PidBank_SetSampleTime(PidBank_t *bank, float sample_time)
+{
+    if (bank == NULL) {
+        return;
+    }
+    bank->sample_time = sample_time;
+}
+
+/**
+ * @brief 使能/禁用整个控制器组，禁用时清零输出和积分（与PID_Enable()相同）
+ */
+void PidBank_Enable(PidBank_t *bank, bool enable)
+{
+    if (bank == NULL) {
+        return;
+    }
+    bank->enable = enable;
+    if (!enable) {
+        memset(bank->output, 0, sizeof(bank->output));
+        memset(bank->error_sum, 0, sizeof(bank->error_sum));
+    }
+}
+
+/**
+ * @brief 重置所有通道的误差历史和输出
+ */
+void PidBank_Reset(PidBank_t *bank)
+{
+    if (bank == NULL) {
+        return;
+    }
+    memset(bank->error, 0, sizeof(bank->error));
+    memset(bank->error_prev, 0, sizeof(bank->error_prev));
+    memset(bank->error_sum, 0, sizeof(bank->error_sum));
+    memset(bank->d_filtered, 0, sizeof(bank->d_filtered));
+    memset(bank->output, 0, sizeof(bank->output));
+    PID_DtStatsReset(&bank->dt_stats);
+}
+
+/**
+ * @brief 所有通道的位置式PID核心计算，积分增量乘以ratio，微分量除以ratio
+ *        求值顺序与PID_Update()位置式相同，默认配置下权重乘1、不滤波、不反算，结果与原算法一致
+ */
+static const float *PidBank_Update(PidBank_t *bank, const float *current, float ratio)
+{
+    for (uint8_t i = 0; i < bank->size; i++) {
+        float error = bank->target[i] - current[i];
+        float error_p = bank->weight_p[i] * bank->target[i] - current[i];
+        float error_d = bank->weight_d[i] * bank->target[i] - current[i];
+
+        // 积分项累加并限幅
+        float sum = PidBank_Limit(bank->error_sum[i] + error * ratio, bank->integral_min[i],
+                                  bank->integral_max[i]);
+
+        // 微分量一阶低通滤波
+        float delta = (error_d - bank->error_prev[i]) / ratio;
+        float d = (bank->d_alpha[i] > 0.0f)
+                      ? bank->d_alpha[i] * bank->d_filtered[i] + (1.0f - bank->d_alpha[i]) * delta
+                      : delta;
+
+        float output = bank->kp[i] * error_p + bank->ki[i] * sum + bank->kd[i] * d;
+        float limited = PidBank_Limit(output, bank->output_min[i], bank->output_max[i]);
+
+        // 反算抗饱和：输出被限幅时回退积分
+        if (bank->kaw[i] != 0.0f && bank->ki[i] != 0.0f && limited != output) {
+            sum = PidBank_Limit(sum + bank->kaw[i] * (limited - output) / bank->ki[i],
+                                bank->integral_min[i], bank->integral_max[i]);
+        }
+
+        bank->current[i] = current[i];
+        bank->error[i] = error;
+        bank->error_sum[i] = sum;
+        bank->d_filtered[i] = d;
+        bank->output[i] = limited;
+        bank->error_prev[i] = error_d;
+    }
+
+    return bank->output;
+}
+
+/**
+ * @brief 同时计算所有通道的位置式PID
+ *        u(k) = Kp*e_p(k) + Ki*∑e(k) + Kd*(e_d(k)-e_d(k-1))，求值顺序与PID_Compute()一致
+ * @param bank 控制器组指针
+ * @param current 各通道的当前反馈值，长度为size
+ * @return 各通道的输出（指向bank->output），禁用时全为0；参数无效时返回NULL
+ */
+const float *PidBank_Compute(PidBank_t *bank, const float *current)
+{
+    if (bank == NULL || current == NULL) {
+        return NULL;
+    }
+    if (!bank->enable) {
+        return bank->output;
+    }
+    return PidBank_Update(bank, current, 1.0f);
+}
+
+/**
+ * @brief 按实测采样周期同时计算所有通道，缩放方式与PID_ComputeDt()相同
+ * @param bank 控制器组指针
+ * @param current 各通道的当前反馈值，长度为size
+ * @param dt 距上次计算的实测时间(s)
+ * @return 各通道的输出（指向bank->output），禁用时全为0；参数无效时返回NULL
+ */
+const float *PidBank_ComputeDt(PidBank_t *bank, const float *current, float dt)
+{
+    if (bank == NULL || current == NULL) {
+        return NULL;
+    }
+    if (!bank->enable) {
+        return bank->output;
+    }
+    if (dt > 0.0f) {
+        PID_DtStatsUpdate(&bank->dt_stats, dt);
+    }
+    return PidBank_Update(bank, current, PID_DtRatio(dt, bank->sample_time));
+}
@@ -0,0 +1,63 @@
+/**
+ * @file pid_bank.h
+ * @author Shiki
+ * @brief 多通道位置式PID控制器组
+ *        N个控制器的参数和状态按结构体数组（SoA）存放，一次调用在同一个循环中更新所有通道并返回全部输出，
+ *        没有PID_Compute()中按类型的分支。各通道的运算顺序与PID_Compute()位置式相同，
+ *        设定值权重、微分滤波、反算抗饱和的设置也相同，与相同配置的PID_Compute()结果逐位一致。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __PID_BANK_H
+#define __PID_BANK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pid_controller.h"
+
+#define PID_BANK_MAX 4  // 最大通道数
+
+typedef struct {
+    float kp[PID_BANK_MAX];            // 比例系数
+    float ki[PID_BANK_MAX];            // 积分系数
+    float kd[PID_BANK_MAX];            // 微分系数
+    float target[PID_BANK_MAX];        // 目标值
+    float current[PID_BANK_MAX];       // 当前值
+    float error[PID_BANK_MAX];         // 当前误差
+    float error_prev[PID_BANK_MAX];    // 前一次误差
+    float error_sum[PID_BANK_MAX];     // 误差积分和
+    float output[PID_BANK_MAX];        // PID输出值
+    float output_max[PID_BANK_MAX];    // 输出最大限制
+    float output_min[PID_BANK_MAX];    // 输出最小限制
+    float integral_max[PID_BANK_MAX];  // 积分限幅
+    float integral_min[PID_BANK_MAX];  // 积分限幅
+    float weight_p[PID_BANK_MAX];      // 比例项设定值权重b
+    float weight_d[PID_BANK_MAX];      // 微分项设定值权重c，0为测量值微分
+    float d_alpha[PID_BANK_MAX];       // 微分低通滤波系数(0~1)，0为不滤波
+    float d_filtered[PID_BANK_MAX];    // 滤波后的微分量
+    float kaw[PID_BANK_MAX];           // 反算抗饱和系数，0为关闭
+    float sample_time;                 // 标称采样周期(s)，0为不按实测周期缩放
+    PidDtStats_t dt_stats;             // 实测采样周期统计
+    uint8_t size;                      // 通道数
+    bool enable;                       // 使能标志（整组）
+} PidBank_t;
+
+bool PidBank_Init(PidBank_t *bank, uint8_t size);
+void PidBank_SetParam(PidBank_t *bank, uint8_t ch, float kp, float ki, float kd);
+void PidBank_SetTarget(PidBank_t *bank, uint8_t ch, float target);
+void PidBank_SetOutputLimit(PidBank_t *bank, uint8_t ch, float min, float max);
+void PidBank_SetIntegralLimit(PidBank_t *bank, uint8_t ch, float min, float max);
+void PidBank_SetSetpointWeight(PidBank_t *bank, uint8_t ch, float weight_p, float weight_d);
+void PidBank_SetDerivativeFilter(PidBank_t *bank, uint8_t ch, float alpha);
+void PidBank_SetAntiWindup(PidBank_t *bank, uint8_t ch, float kaw);
+void PidBank_SetSampleTime(PidBank_t *bank, float sample_time);
+void PidBank_Enable(PidBank_t *bank, bool enable);
+void PidBank_Reset(PidBank_t *bank);
+const float *PidBank_Compute(PidBank_t *bank, const float *current);
+const float *PidBank_ComputeDt(PidBank_t *bank, const float *current, float dt);
+
+#endif
@@ -1,6 +1,9 @@
 #include "pid_controller.h"
+#include <math.h>
 #include <string.h>
 
+#include "profiler.h"
+
 /**
  * @brief 初始化PID控制器
  *
@@ -21,6 +24,8 @@ void PID_Init(PidController_t *pid, PidType_t type)
     pid->output_min = -1000.0f;
     pid->integral_max = 100.0f;
     pid->integral_min = -100.0f;
+    pid->weight_p = 1.0f;
+    pid->weight_d = 1.0f;
     pid->enable = true;
 }
 
@@ -88,6 +93,75 @@ void PID_SetIntegralLimit(PidController_t *pid, float min, float max)
     pid->integral_max = max;
 }
 
+/**
+ * @brief 设置设定值权重
+ *        比例项使用e_p = b*r - y，微分项使用e_d = c*r - y，积分项始终使用e = r - y。
+ *        b<1可减小设定值阶跃时的超调，c=0即测量值微分，设定值阶跃不会产生微分冲击。
+ *
+ * @param pid PID控制器指针
+ * @param weight_p 比例项权重b（默认1）
+ * @param weight_d 微分项权重c（默认1）
+ */
+void PID_SetSetpointWeight(PidController_t *pid, float weight_p, float weight_d)
+{
+    if (pid == NULL)
+        return;
+
+    pid->weight_p = weight_p;
+    pid->weight_d = weight_d;
+}
+
+/**
+ * @brief 设置微分项一阶低通滤波
+ *        d(k) = alpha*d(k-1) + (1-alpha)*Δe_d(k)，alpha越大越平滑、滞后越大
+ *
+ * @param pid PID控制器指针
+ * @param alpha 滤波系数，0~1，0为不滤波（默认）
+ */
+void PID_SetDerivativeFilter(PidController_t *pid, float alpha)
+{
+    if (pid == NULL)
+        return;
+
+    if (alpha < 0.0f)
+        alpha = 0.0f;
+    if (alpha > 1.0f)
+        alpha = 1.0f;
+    pid->d_alpha = alpha;
+}
+
+/**
+ * @brief 设置反算（back-calculation）抗饱和
+ *        输出限幅时按kaw*(u_limited - u)修正积分，使积分项随输出退出饱和，
+ *        比单纯的积分限幅恢复更快。增量式PID的输出在限幅后累加，本身不会积分饱和，不使用该参数。
+ *
+ * @param pid PID控制器指针
+ * @param kaw 抗饱和系数，0为关闭（默认），一般取0.1~1
+ */
+void PID_SetAntiWindup(PidController_t *pid, float kaw)
+{
+    if (pid == NULL)
+        return;
+
+    pid->kaw = kaw;
+}
+
+/**
+ * @brief 设置标称采样周期
+ *        PID_ComputeDt()按实测周期dt与标称周期之比缩放积分、微分项，
+ *        参数按标称周期整定后，控制周期变化时等效增益不变。
+ *
+ * @param pid PID控制器指针
+ * @param sample_time 标称采样周期(s)，0为不缩放
+ */
+void PID_SetSampleTime(PidController_t *pid, float sample_time)
+{
+    if (pid == NULL)
+        return;
+
+    pid->sample_time = sample_time;
+}
+
 /**
  * @brief 使能/禁用PID控制器
  *
@@ -101,7 +175,7 @@ void PID_Enable(PidController_t *pid, bool enable)
 
     pid->enable = enable;
 
-    /* 禁用时清零输出 */
+    /* 禁用时清零输出和积分，误差历史保留 */
     if (!enable)
     {
         pid->output = 0.0f;
@@ -121,8 +195,12 @@ void PID_Reset(PidController_t *pid)
 
     pid->error = 0.0f;
     pid->error_prev = 0.0f;
+    pid->error_prev2 = 0.0f;
+    pid->error_p_prev = 0.0f;
     pid->error_sum = 0.0f;
+    pid->d_filtered = 0.0f;
     pid->output = 0.0f;
+    PID_DtStatsReset(&pid->dt_stats);
 }
 
 /**
@@ -143,56 +221,173 @@ static float PID_Limit(float value, float min, float max)
 }
 
 /**
- * @brief PID计算函数
+ * @brief 微分量一阶低通滤波
+ *
+ * @param pid PID控制器指针
+ * @param delta 未滤波的微分量
+ * @return float 滤波后的微分量
+ */
+static float PID_FilterDerivative(PidController_t *pid, float delta)
+{
+    if (pid->d_alpha > 0.0f)
+        pid->d_filtered = pid->d_alpha * pid->d_filtered + (1.0f - pid->d_alpha) * delta;
+    else
+        pid->d_filtered = delta;
+
+    return pid->d_filtered;
+}
+
+/**
+ * @brief 计算实测周期与标称周期之比，限制在PID_DT_RATIO_MIN~PID_DT_RATIO_MAX
+ *
+ * @param dt 实测采样周期(s)
+ * @param sample_time 标称采样周期(s)
+ * @return float 周期比，dt或sample_time无效时返回1
+ */
+float PID_DtRatio(float dt, float sample_time)
+{
+    if (dt <= 0.0f || sample_time <= 0.0f)
+        return 1.0f;
+
+    return PID_Limit(dt / sample_time, PID_DT_RATIO_MIN, PID_DT_RATIO_MAX);
+}
+
+/**
+ * @brief 更新采样周期统计（Welford算法计算标准差）
+ *
+ * @param stats 统计结构体指针
+ * @param dt 实测采样周期(s)
+ */
+void PID_DtStatsUpdate(PidDtStats_t *stats, float dt)
+{
+    if (stats == NULL)
+        return;
+
+    if (stats->count == 0 || dt < stats->min)
+        stats->min = dt;
+    if (stats->count == 0 || dt > stats->max)
+        stats->max = dt;
+
+    stats->count++;
+    float delta = dt - stats->mean;
+    stats->mean += delta / (float)stats->count;
+    stats->m2 += delta * (dt - stats->mean);
+    if (stats->count > 1)
+        stats->jitter = sqrtf(stats->m2 / (float)(stats->count - 1));
+}
+
+/**
+ * @brief 清除采样周期统计
+ *
+ * @param stats 统计结构体指针
+ */
+void PID_DtStatsReset(PidDtStats_t *stats)
+{
+    if (stats == NULL)
+        return;
+
+    memset(stats, 0, sizeof(PidDtStats_t));
+}
+
+/**
+ * @brief PID核心计算
+ *        积分增量乘以ratio，微分量除以ratio；ratio为1时与未缩放的算法结果完全一致
  *
  * @param pid PID控制器指针
  * @param current 当前反馈值
+ * @param ratio 实测周期与标称周期之比
  * @return float PID输出值
  */
-float PID_Compute(PidController_t *pid, float current)
+static float PID_Update(PidController_t *pid, float current, float ratio)
 {
-    if (pid == NULL || !pid->enable)
-        return 0.0f;
+    PROFILER_BEGIN(PID_COMPUTE);
 
     /* 更新当前值 */
     pid->current = current;
 
-    /* 计算误差 */
+    /* 计算误差，比例、微分通道按设定值权重计算 */
     pid->error = pid->target - pid->current;
+    float error_p = pid->weight_p * pid->target - pid->current;
+    float error_d = pid->weight_d * pid->target - pid->current;
 
     if (pid->type == PID_TYPE_POSITIONAL) {
         /* 位置式PID算法 */
 
         /* 积分项累加 */
-        pid->error_sum += pid->error;
+        pid->error_sum += pid->error * ratio;
 
         /* 积分限幅 */
         pid->error_sum = PID_Limit(pid->error_sum, pid->integral_min, pid->integral_max);
 
-        /* PID计算：u(k) = Kp*e(k) + Ki*∑e(k) + Kd*(e(k)-e(k-1)) */
-        pid->output = pid->kp * pid->error +
-                      pid->ki * pid->error_sum +
-                      pid->kd * (pid->error - pid->error_prev);
+        /* PID计算：u(k) = Kp*e_p(k) + Ki*∑e(k) + Kd*(e_d(k)-e_d(k-1)) */
+        float output = pid->kp * error_p +
+                       pid->ki * pid->error_sum +
+                       pid->kd * PID_FilterDerivative(pid, (error_d - pid->error_prev) / ratio);
+
+        /* 输出限幅 */
+        pid->output = PID_Limit(output, pid->output_min, pid->output_max);
+
+        /* 反算抗饱和：输出被限幅时回退积分 */
+        if (pid->kaw != 0.0f && pid->ki != 0.0f && pid->output != output) {
+            pid->error_sum += pid->kaw * (pid->output - output) / pid->ki;
+            pid->error_sum = PID_Limit(pid->error_sum, pid->integral_min, pid->integral_max);
+        }
     } else if (pid->type == PID_TYPE_INCREMENTAL) {
         /* 增量式PID算法 */
 
-        /* PID计算：Δu(k) = Kp*(e(k)-e(k-1)) + Ki*e(k) + Kd*(e(k)-2*e(k-1)+e(k-2)) */
-        float delta_output = pid->kp * (pid->error - pid->error_prev) +
-                             pid->ki * pid->error +
-                             pid->kd * (pid->error - 2.0f * pid->error_prev + pid->error_sum);
+        /* PID计算：Δu(k) = Kp*(e_p(k)-e_p(k-1)) + Ki*e(k) + Kd*(e_d(k)-2*e_d(k-1)+e_d(k-2)) */
+        float delta_output = pid->kp * (error_p - pid->error_p_prev) +
+                             pid->ki * pid->error * ratio +
+                             pid->kd * PID_FilterDerivative(pid, (error_d - 2.0f * pid->error_prev +
+                                                                      pid->error_prev2) / ratio);
 
-        /* 累加输出 */
-        pid->output += delta_output;
+        /* 累加输出并限幅 */
+        pid->output = PID_Limit(pid->output + delta_output, pid->output_min, pid->output_max);
 
         /* 更新误差历史 */
-        pid->error_sum = pid->error_prev; /* e(k-2) = e(k-1) */
+        pid->error_prev2 = pid->error_prev; /* e(k-2) = e(k-1) */
+        pid->error_p_prev = error_p;
     }
 
-    /* 输出限幅 */
-    pid->output = PID_Limit(pid->output, pid->output_min, pid->output_max);
-
     /* 更新误差历史 */
-    pid->error_prev = pid->error;
+    pid->error_prev = error_d;
 
+    PROFILER_END(PID_COMPUTE);
     return pid->output;
 }
+
+/**
+ * @brief PID计算函数（固定采样周期）
+ *
+ * @param pid PID控制器指针
+ * @param current 当前反馈值
+ * @return float PID输出值
+ */
+float PID_Compute(PidController_t *pid, float current)
+{
+    if (pid == NULL || !pid->enable)
+        return 0.0f;
+
+    return PID_Update(pid, current, 1.0f);
+}
+
+/**
+ * @brief PID计算函数（按实测采样周期缩放）
+ *        积分项按dt/Ts、微分项按Ts/dt缩放（Ts为PID_SetSampleTime()设置的标称周期），
+ *        并更新周期统计。未设置标称周期或dt<=0（如第一次计算）时与PID_Compute()相同。
+ *
+ * @param pid PID控制器指针
+ * @param current 当前反馈值
+ * @param dt 距上次计算的实测时间(s)
+ * @return float PID输出值
+ */
+float PID_ComputeDt(PidController_t *pid, float current, float dt)
+{
+    if (pid == NULL || !pid->enable)
+        return 0.0f;
+
+    if (dt > 0.0f)
+        PID_DtStatsUpdate(&pid->dt_stats, dt);
+
+    return PID_Update(pid, current, PID_DtRatio(dt, pid->sample_time));
+}
@@ -22,6 +22,20 @@ typedef enum {
     PID_TYPE_INCREMENTAL        /* 增量式PID */
 } PidType_t;
 
+/* 实测采样周期与标称周期之比的限制，防止长时间停顿后微分项过小、积分项跳变 */
+#define PID_DT_RATIO_MIN 0.1f
+#define PID_DT_RATIO_MAX 5.0f
+
+/* 实测采样周期统计 */
+typedef struct {
+    uint32_t count;             /* 统计次数 */
+    float min;                  /* 最小周期(s) */
+    float max;                  /* 最大周期(s) */
+    float mean;                 /* 平均周期(s) */
+    float m2;                   /* 与平均值偏差的平方和（Welford算法） */
+    float jitter;               /* 周期标准差(s) */
+} PidDtStats_t;
+
 /* PID控制器参数结构体 */
 typedef struct {
     float kp;                   /* 比例系数 */
@@ -30,13 +44,22 @@ typedef struct {
     float target;               /* 目标值 */
     float current;              /* 当前值 */
     float error;                /* 当前误差 */
-    float error_prev;           /* 前一次误差 */
-    float error_sum;            /* 误差积分和 */
+    float error_prev;           /* 前一次误差（微分通道，e_d(k-1)） */
+    float error_prev2;          /* 前两次误差（微分通道，e_d(k-2)，增量式使用） */
+    float error_p_prev;         /* 前一次误差（比例通道，增量式使用） */
+    float error_sum;            /* 误差积分和（仅位置式使用） */
     float output;               /* PID输出值 */
     float output_max;           /* 输出最大限制 */
     float output_min;           /* 输出最小限制 */
     float integral_max;         /* 积分限幅 */
     float integral_min;         /* 积分限幅 */
+    float weight_p;             /* 比例项设定值权重b，e_p = b*r - y */
+    float weight_d;             /* 微分项设定值权重c，e_d = c*r - y，0为测量值微分 */
+    float d_alpha;              /* 微分低通滤波系数(0~1)，0为不滤波 */
+    float d_filtered;           /* 滤波后的微分量 */
+    float kaw;                  /* 反算抗饱和系数，0为关闭（仅位置式） */
+    float sample_time;          /* 标称采样周期(s)，整定参数时的周期，0为不按实测周期缩放 */
+    PidDtStats_t dt_stats;      /* 实测采样周期统计 */
     PidType_t type;             /* PID类型 */
     bool enable;                /* 使能标志 */
 } PidController_t;
@@ -47,8 +70,16 @@ void PID_SetParam(PidController_t *pid, float kp, float ki, float kd);
 void PID_SetTarget(PidController_t *pid, float target);
 void PID_SetOutputLimit(PidController_t *pid, float min, float max);
 void PID_SetIntegralLimit(PidController_t *pid, float min, float max);
+void PID_SetSetpointWeight(PidController_t *pid, float weight_p, float weight_d);
+void PID_SetDerivativeFilter(PidController_t *pid, float alpha);
+void PID_SetAntiWindup(PidController_t *pid, float kaw);
+void PID_SetSampleTime(PidController_t *pid, float sample_time);
 void PID_Enable(PidController_t *pid, bool enable);
 void PID_Reset(PidController_t *pid);
 float PID_Compute(PidController_t *pid, float current);
+float PID_ComputeDt(PidController_t *pid, float current, float dt);
+float PID_DtRatio(float dt, float sample_time);
+void PID_DtStatsUpdate(PidDtStats_t *stats, float dt);
+void PID_DtStatsReset(PidDtStats_t *stats);
 
 #endif /* __PID_CONTROLLER_H */
@@ -0,0 +1,319 @@
+#include "pid_fixed.h"
+
+#include <string.h>
+
+// 缩小后的增益上限，Q31/Q15无法表示1
+#define PID_FIXED_GAIN_LIMIT 0.999f
+
+/**
+ * @brief 计算增益缩小位数，使各增益及arm_pid_init中的A0=Kp+Ki+Kd、A1=-(Kp+2Kd)都小于1
+ * @return 缩小位数，超出PID_FIXED_MAX_SHIFT时返回-1
+ */
+static int8_t PidFixed_GainShift(float kp, float ki, float kd)
+{
+    float gains[5] = {kp, ki, kd, kp + ki + kd, kp + 2.0f * kd};
+    float max = 0.0f;
+    for (uint8_t i = 0; i < 5; i++) {
+        float value = (gains[i] < 0.0f) ? -gains[i] : gains[i];
+        if (value > max) {
+            max = value;
+        }
+    }
+
+    for (int8_t shift = 0; shift <= PID_FIXED_MAX_SHIFT; shift++) {
+        if (max < PID_FIXED_GAIN_LIMIT * (float)(1UL << shift)) {
+            return shift;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 浮点数转换为Q31（饱和）
+ */
+static q31_t PidFixed_FloatToQ31(float value)
+{
+    float scaled = value * 2147483648.0f;
+    if (scaled >= 2147483647.0f) {
+        return INT32_MAX;
+    }
+    if (scaled <= -2147483648.0f) {
+        return INT32_MIN;
+    }
+    return (q31_t)scaled;
+}
+
+/**
+ * @brief 浮点数转换为Q15（饱和）
+ */
+static q15_t PidFixed_FloatToQ15(float value)
+{
+    float scaled = value * 32768.0f;
+    if (scaled >= 32767.0f) {
+        return INT16_MAX;
+    }
+    if (scaled <= -32768.0f) {
+        return INT16_MIN;
+    }
+    return (q15_t)scaled;
+}
+
+// ==================== Q31 ====================
+
+/**
+ * @brief 初始化Q31 PID控制器，增益为0，输出限制为整个Q31范围
+ */
+void PidQ31_Init(PidQ31_t *pid)
+{
+    if (pid == NULL) {
+        return;
+    }
+    memset(pid, 0, sizeof(PidQ31_t));
+    pid->output_max = INT32_MAX;
+    pid->output_min = INT32_MIN;
+    pid->enable = true;
+}
+
+/**
+ * @brief 设置PID参数（与PID_SetParam()含义相同，每个采样周期的增益）
+ *        增益按需缩小gain_shift位后转换为Q31，y(k-1)按新的缩小位数换算，不清除状态
+ * @param pid PID控制器指针
+ * @param kp 比例系数
+ * @param ki 积分系数
+ * @param kd 微分系数
+ * @return true 设置成功，false 增益超出2^PID_FIXED_MAX_SHIFT，参数不变
+ */
+bool PidQ31_SetParam(PidQ31_t *pid, float kp, float ki, float kd)
+{
+    if (pid == NULL) {
+        return false;
+    }
+    int8_t shift = PidFixed_GainShift(kp, ki, kd);
+    if (shift < 0) {
+        return false;
+    }
+
+    float scale = 1.0f / (float)(1UL << shift);
+    pid->instance.Kp = PidFixed_FloatToQ31(kp * scale);
+    pid->instance.Ki = PidFixed_FloatToQ31(ki * scale);
+    pid->instance.Kd = PidFixed_FloatToQ31(kd * scale);
+    arm_pid_init_q31(&pid->instance, 0);
+
+    pid->gain_shift = (uint8_t)shift;
+    pid->instance.state[2] = pid->output >> pid->gain_shift;
+    return true;
+}
+
+/**
+ * @brief 设置目标值
+ */
+void PidQ31_SetTarget(PidQ31_t *pid, q31_t target)
+{
+    if (pid == NULL) {
+        return;
+    }
+    pid->target = target;
+}
+
+/**
+ * @brief 设置输出限制
+ */
+void PidQ31_SetOutputLimit(PidQ31_t *pid, q31_t min, q31_t max)
+{
+    if (pid == NULL) {
+        return;
+    }
+    pid->output_min = min;
+    pid->output_max = max;
+}
+
+/**
+ * @brief 使能/禁用控制器，禁用时清零输出（增量式的输出即积分状态），误差历史保留
+ */
+void PidQ31_Enable(PidQ31_t *pid, bool enable)
+{
+    if (pid == NULL) {
+        return;
+    }
+    pid->enable = enable;
+    if (!enable) {
+        pid->output = 0;
+        pid->instance.state[2] = 0;
+    }
+}
+
+/**
+ * @brief 重置误差历史和输出
+ */
+void PidQ31_Reset(PidQ31_t *pid)
+{
+    if (pid == NULL) {
+        return;
+    }
+    arm_pid_reset_q31(&pid->instance);
+    pid->error = 0;
+    pid->output = 0;
+}
+
+/**
+ * @brief Q31 PID计算，可在中断中调用
+ * @param pid PID控制器指针
+ * @param current 当前反馈值
+ * @return 限幅后的输出
+ */
+q31_t PidQ31_Compute(PidQ31_t *pid, q31_t current)
+{
+    if (pid == NULL || !pid->enable) {
+        return 0;
+    }
+
+    pid->current = current;
+    pid->error = clip_q63_to_q31((q63_t)pid->target - current);
+
+    // 与arm_pid_q31()相同的差分方程，但在64位中累加y(k-1)后再限幅：
+    // arm_pid_q31()把acc>>31截断为32位并直接加y(k-1)，满量程误差或输出接近满量程时会回绕变号。
+    // 三个乘积之和可能超出q63，各项先右移1位
+    q31_t *state = pid->instance.state;
+    q63_t acc = ((q63_t)pid->instance.A0 * pid->error) >> 1;
+    acc += ((q63_t)pid->instance.A1 * state[0]) >> 1;
+    acc += ((q63_t)pid->instance.A2 * state[1]) >> 1;
+    q63_t scaled = (acc >> 30) + state[2];
+    state[1] = state[0];
+    state[0] = pid->error;
+
+    // 缩小的输出还原后限幅，被限幅时写回y(k-1)，下次从限幅值继续累加
+    q63_t output = scaled * ((q63_t)1 << pid->gain_shift);
+    if (output > pid->output_max) {
+        pid->output = pid->output_max;
+        state[2] = pid->output >> pid->gain_shift;
+    } else if (output < pid->output_min) {
+        pid->output = pid->output_min;
+        state[2] = pid->output >> pid->gain_shift;
+    } else {
+        pid->output = (q31_t)output;
+        state[2] = (q31_t)scaled;
+    }
+
+    return pid->output;
+}
+
+// ==================== Q15 ====================
+
+/**
+ * @brief 初始化Q15 PID控制器，增益为0，输出限制为整个Q15范围
+ */
+void PidQ15_Init(PidQ15_t *pid)
+{
+    if (pid == NULL) {
+        return;
+    }
+    memset(pid, 0, sizeof(PidQ15_t));
+    pid->output_max = INT16_MAX;
+    pid->output_min = INT16_MIN;
+    pid->enable = true;
+}
+
+/**
+ * @brief 设置PID参数，见PidQ31_SetParam()
+ */
+bool PidQ15_SetParam(PidQ15_t *pid, float kp, float ki, float kd)
+{
+    if (pid == NULL) {
+        return false;
+    }
+    int8_t shift = PidFixed_GainShift(kp, ki, kd);
+    if (shift < 0) {
+        return false;
+    }
+
+    float scale = 1.0f / (float)(1UL << shift);
+    pid->instance.Kp = PidFixed_FloatToQ15(kp * scale);
+    pid->instance.Ki = PidFixed_FloatToQ15(ki * scale);
+    pid->instance.Kd = PidFixed_FloatToQ15(kd * scale);
+    arm_pid_init_q15(&pid->instance, 0);
+
+    pid->gain_shift = (uint8_t)shift;
+    pid->instance.state[2] = (q15_t)(pid->output >> pid->gain_shift);
+    return true;
+}
+
+/**
+ * @brief 设置目标值
+ */
+void PidQ15_SetTarget(PidQ15_t *pid, q15_t target)
+{
+    if (pid == NULL) {
+        return;
+    }
+    pid->target = target;
+}
+
+/**
+ * @brief 设置输出限制
+ */
+void PidQ15_SetOutputLimit(PidQ15_t *pid, q15_t min, q15_t max)
+{
+    if (pid == NULL) {
+        return;
+    }
+    pid->output_min = min;
+    pid->output_max = max;
+}
+
+/**
+ * @brief 使能/禁用控制器，见PidQ31_Enable()
+ */
+void PidQ15_Enable(PidQ15_t *pid, bool enable)
+{
+    if (pid == NULL) {
+        return;
+    }
+    pid->enable = enable;
+    if (!enable) {
+        pid->output = 0;
+        pid->instance.state[2] = 0;
+    }
+}
+
+/**
+ * @brief 重置误差历史和输出
+ */
+void PidQ15_Reset(PidQ15_t *pid)
+{
+    if (pid == NULL) {
+        return;
+    }
+    arm_pid_reset_q15(&pid->instance);
+    pid->error = 0;
+    pid->output = 0;
+}
+
+/**
+ * @brief Q15 PID计算，可在中断中调用
+ * @param pid PID控制器指针
+ * @param current 当前反馈值
+ * @return 限幅后的输出
+ */
+q15_t PidQ15_Compute(PidQ15_t *pid, q15_t current)
+{
+    if (pid == NULL || !pid->enable) {
+        return 0;
+    }
+
+    pid->current = current;
+    pid->error = (q15_t)__SSAT((q31_t)pid->target - current, 16);
+
+    // arm_pid_q15()在缩放前已饱和到Q15，不会回绕
+    q31_t output = (q31_t)arm_pid_q15(&pid->instance, pid->error) * (1L << pid->gain_shift);
+    if (output > pid->output_max) {
+        pid->output = pid->output_max;
+        pid->instance.state[2] = (q15_t)(pid->output >> pid->gain_shift);
+    } else if (output < pid->output_min) {
+        pid->output = pid->output_min;
+        pid->instance.state[2] = (q15_t)(pid->output >> pid->gain_shift);
+    } else {
+        pid->output = (q15_t)output;
+    }
+
+    return pid->output;
+}
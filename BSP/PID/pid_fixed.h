@@ -0,0 +1,68 @@
+/**
+ * @file pid_fixed.h
+ * @author Shiki
+ * @brief 定点PID控制器（Q31/Q15），用于定时器中断中的高速率内环
+ *        基于CMSIS-DSP的arm_pid_q31/arm_pid_q15（增量式：y(k) = y(k-1) + A0*e(k) + A1*e(k-1) + A2*e(k-2)），
+ *        接口与PidController_t对应。增益大于等于1时按2的幂缩小（gain_shift），输出再左移还原；
+ *        输出限幅后写回状态y(k-1)，与增量式PID_Compute()的PID_Limit()限幅语义相同。
+ *        Q31的差分方程在64位中计算并饱和（arm_pid_q31在满量程时会回绕），Q15直接使用arm_pid_q15。
+ *        浮点运算只在设置参数时进行，计算函数中只有整数运算。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __PID_FIXED_H
+#define __PID_FIXED_H
+
+#include "arm_math.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PID_FIXED_MAX_SHIFT 8  // 最大增益缩小位数，增益（及Kp+Ki+Kd、Kp+2Kd）需小于2^8
+
+/* Q31定点PID控制器 */
+typedef struct {
+    arm_pid_instance_q31 instance;  // CMSIS-DSP PID实例，增益已缩小gain_shift位
+    q31_t target;                   // 目标值
+    q31_t current;                  // 当前值
+    q31_t error;                    // 当前误差
+    q31_t output;                   // PID输出值
+    q31_t output_max;               // 输出最大限制
+    q31_t output_min;               // 输出最小限制
+    uint8_t gain_shift;             // 增益缩小位数
+    bool enable;                    // 使能标志
+} PidQ31_t;
+
+/* Q15定点PID控制器 */
+typedef struct {
+    arm_pid_instance_q15 instance;  // CMSIS-DSP PID实例，增益已缩小gain_shift位
+    q15_t target;                   // 目标值
+    q15_t current;                  // 当前值
+    q15_t error;                    // 当前误差
+    q15_t output;                   // PID输出值
+    q15_t output_max;               // 输出最大限制
+    q15_t output_min;               // 输出最小限制
+    uint8_t gain_shift;             // 增益缩小位数
+    bool enable;                    // 使能标志
+} PidQ15_t;
+
+void PidQ31_Init(PidQ31_t *pid);
+bool PidQ31_SetParam(PidQ31_t *pid, float kp, float ki, float kd);
+void PidQ31_SetTarget(PidQ31_t *pid, q31_t target);
+void PidQ31_SetOutputLimit(PidQ31_t *pid, q31_t min, q31_t max);
+void PidQ31_Enable(PidQ31_t *pid, bool enable);
+void PidQ31_Reset(PidQ31_t *pid);
+q31_t PidQ31_Compute(PidQ31_t *pid, q31_t current);
+
+void PidQ15_Init(PidQ15_t *pid);
+bool PidQ15_SetParam(PidQ15_t *pid, float kp, float ki, float kd);
+void PidQ15_SetTarget(PidQ15_t *pid, q15_t target);
+void PidQ15_SetOutputLimit(PidQ15_t *pid, q15_t min, q15_t max);
+void PidQ15_Enable(PidQ15_t *pid, bool enable);
+void PidQ15_Reset(PidQ15_t *pid);
+q15_t PidQ15_Compute(PidQ15_t *pid, q15_t current);
+
+#endif
@@ -1,34 +1,73 @@
 #include "command.h"
 
+// 包头：0xAA为旧格式（8位累加和校验），0xAB为v2格式（CRC-16/CCITT校验，高字节在前）
+#define COMMAND_HEADER 0xAA
+#define COMMAND_HEADER_V2 0xAB
+// 两种包头只有最低位不同
+#define COMMAND_HEADER_MASK 0xFE
 // 指令的最小长度，修改该值以适配不同协议格式的长度
 #define COMMAND_MIN_LENGTH 4
+// 指令的最大长度，长度字节超出范围的帧直接丢弃，不能超过调用者的指令缓冲区大小
+#define COMMAND_MAX_LENGTH 32
 // 循环缓冲区大小，增大该值以降低缓冲区溢出的概率
-#define BUFFER_SIZE 220
-// 循环缓冲区
+#define BUFFER_SIZE 256
+// 循环缓冲区，DMA循环接收时直接作为DMA目标，原地解析
 static uint8_t buffer[BUFFER_SIZE];
 // 循环缓冲区读索引
-static uint8_t read_index = 0;
-// 循环缓冲区写索引
-static uint8_t write_index = 0;
+static uint16_t read_index = 0;
+// 循环缓冲区写索引（DMA已写入位置）
+static volatile uint16_t write_index = 0;
+// 累计写入和已处理的字节数，两者之差超过缓冲区大小说明未处理的数据已被覆盖
+static volatile uint32_t write_total = 0;
+static uint32_t read_total = 0;
+
+// DMA循环接收使用的串口，NULL表示只使用Command_Write写入
+static UART_HandleTypeDef *rx_huart = NULL;
+// 最近一次收到数据的时刻(ms)
+static volatile uint32_t rx_tick = 0;
+// 接收错误重启DMA后置位，由解析函数丢弃重启前未处理的数据
+static volatile bool rx_restart = false;
+static uint32_t rx_restart_total = 0;
+// 统计信息
+static CommandStats_t stats = {0};
+
+// 帧同步状态
+typedef enum {
+    COMMAND_STATE_SYNC = 0,  // 寻找包头
+    COMMAND_STATE_LENGTH,    // 等待长度字节
+    COMMAND_STATE_BODY       // 接收数据和校验和
+} CommandState_t;
+
+static CommandState_t state = COMMAND_STATE_SYNC;
+// 下一个待扫描的字节，read_index指向当前候选帧的包头
+static uint16_t scan_index = 0;
+// 当前候选帧的包头、长度、已累加的校验和、已扫描的字节数
+static uint8_t frame_header = 0;
+static uint8_t frame_length = 0;
+static uint8_t frame_sum = 0;
+static uint16_t frame_crc = 0;
+static uint8_t frame_count = 0;
 
 /**
- * @brief 增加读索引
- * @param length 要增加的长度
+ * @brief CRC-16/CCITT（多项式0x1021，初值0xFFFF）累加一个字节
  */
-static void Command_AddReadIndex(uint8_t length)
+static uint16_t Command_Crc16Update(uint16_t crc, uint8_t byte)
 {
-    read_index += length;
-    read_index %= BUFFER_SIZE;
+    crc ^= (uint16_t)byte << 8;
+    for (uint8_t i = 0; i < 8; i++) {
+        crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
 }
 
 /**
- * @brief 读取第i位数据 超过缓存区长度自动循环
- * @param i 要读取的数据索引
+ * @brief 增加读索引
+ * @param length 要增加的长度
  */
-static uint8_t Command_Read(uint8_t i)
+static void Command_AddReadIndex(uint32_t length)
 {
-    uint8_t index = i % BUFFER_SIZE;
-    return buffer[index];
+    read_index = (read_index + length) % BUFFER_SIZE;
+    read_total += length;
 }
 
 /**
@@ -36,41 +75,12 @@ static uint8_t Command_Read(uint8_t i)
  * @return 未处理的数据长度
  * @retval 0 缓冲区为空
  * @retval 1~BUFFER_SIZE-1 未处理的数据长度
- * @retval BUFFER_SIZE 缓冲区已满
+ * @retval 大于BUFFER_SIZE-1 未处理的数据已被覆盖
  */
-static uint8_t Command_GetLength()
+static uint32_t Command_GetLength()
 {
-    // 读索引等于写索引时，缓冲区为空
-    if (read_index == write_index) {
-        return 0;
-    }
-    // 如果缓冲区已满,返回BUFFER_SIZE
-    if ((write_index + 1) % BUFFER_SIZE == read_index) {
-        return BUFFER_SIZE - 1;  // 实际可用空间比BUFFER_SIZE少1，避免满空无法区分
-    }
-    // 如果缓冲区未满,返回未处理的数据长度
-    if (read_index <= write_index) {
-        return write_index - read_index;
-    } else {
-        return BUFFER_SIZE - read_index + write_index;
-    }
+    return write_total - read_total;
 }
-// uint8_t Command_GetLength() {
-//   // 读索引等于写索引时，缓冲区为空
-//   if (read_index == write_index) {
-//     return 0;
-//   }
-//   // 如果缓冲区已满,返回BUFFER_SIZE
-//   if (write_index + 1 == read_index || (write_index == BUFFER_SIZE - 1 && read_index == 0)) {
-//     return BUFFER_SIZE;
-//   }
-//   // 如果缓冲区未满,返回未处理的数据长度
-//   if (read_index <= write_index) {
-//     return write_index - read_index;
-//   } else {
-//     return BUFFER_SIZE - read_index + write_index;
-//   }
-// }
 
 /**
  * @brief 计算缓冲区剩余空间
@@ -79,13 +89,13 @@ static uint8_t Command_GetLength()
  * @retval 1~BUFFER_SIZE-1 剩余空间
  * @retval BUFFER_SIZE 缓冲区为空
  */
-static uint8_t Command_GetRemain()
+static uint16_t Command_GetRemain()
 {
-    return BUFFER_SIZE - Command_GetLength();
+    return BUFFER_SIZE - 1 - Command_GetLength();  // 实际可用空间比BUFFER_SIZE少1，避免满空无法区分
 }
 
 /**
- * @brief 向缓冲区写入数据
+ * @brief 向缓冲区写入数据，用于不使用DMA循环接收的场合，不能与Command_StartReceive同时使用
  * @param data 要写入的数据指针
  * @param length 要写入的数据长度
  * @return 写入的数据长度
@@ -101,52 +111,227 @@ uint8_t Command_Write(uint8_t *data, uint8_t length)
         memcpy(buffer + write_index, data, length);
         write_index += length;
     } else {
-        uint8_t first_length = BUFFER_SIZE - write_index;
+        uint16_t first_length = BUFFER_SIZE - write_index;
         memcpy(buffer + write_index, data, first_length);
         memcpy(buffer, data + first_length, length - first_length);
         write_index = length - first_length;
     }
+    write_total += length;
+    rx_tick = HAL_GetTick();
     return length;
 }
 
+/**
+ * @brief 启动DMA循环接收，数据直接写入循环缓冲区，无需拷贝和重新启动接收
+ *        保留DMA过半/完成中断，保证每半个缓冲区至少更新一次写索引
+ * @param huart 串口句柄，DMA接收需配置为循环模式
+ */
+void Command_StartReceive(UART_HandleTypeDef *huart)
+{
+    rx_huart = huart;
+    write_index = 0;
+    HAL_UARTEx_ReceiveToIdle_DMA(rx_huart, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief DMA接收事件（空闲、过半、完成）时调用，根据DMA写入位置更新写索引
+ * @param Size DMA写入位置（BUFFER_SIZE - NDTR）
+ */
+void Command_RxEventCallback(uint16_t Size)
+{
+    uint16_t position = Size % BUFFER_SIZE;
+    write_total += (position + BUFFER_SIZE - write_index) % BUFFER_SIZE;
+    write_index = position;
+    rx_tick = HAL_GetTick();
+}
+
+/**
+ * @brief 接收错误时调用，重新启动DMA循环接收
+ *        DMA从缓冲区起始位置重新写入，重启前未处理的数据由Command_GetCommand丢弃
+ */
+void Command_ErrorCallback(void)
+{
+    stats.rx_errors++;
+    if (rx_huart == NULL) {
+        return;
+    }
+    rx_restart_total = write_total;
+    rx_restart = true;
+    Command_StartReceive(rx_huart);
+}
+
+/**
+ * @brief 最近一次收到数据的时刻(ms)，即刚解析出的指令的到达时刻（空闲中断时刻）
+ */
+uint32_t Command_GetRxTick(void)
+{
+    return rx_tick;
+}
+
+/**
+ * @brief 获取接收统计信息
+ */
+void Command_GetStats(CommandStats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+    out->received = write_total;
+}
+
+/**
+ * @brief 检查接收重启和缓冲区溢出，丢弃已失效的数据并重新寻找包头
+ * @return 有效的未处理数据长度，不超过BUFFER_SIZE-1
+ */
+static uint32_t Command_CheckOverrun(void)
+{
+    if (rx_restart) {
+        rx_restart = false;
+        stats.lost_bytes += rx_restart_total - read_total;
+        read_total = rx_restart_total;
+        read_index = 0;
+        scan_index = 0;
+        state = COMMAND_STATE_SYNC;
+    }
+
+    // 未处理的数据超过缓冲区容量，最早的数据已被DMA覆盖
+    uint32_t length = Command_GetLength();
+    if (length > BUFFER_SIZE - 1) {
+        uint32_t lost = length - (BUFFER_SIZE - 1);
+        stats.overruns++;
+        stats.lost_bytes += lost;
+        Command_AddReadIndex(lost);
+        scan_index = read_index;
+        state = COMMAND_STATE_SYNC;
+        length = BUFFER_SIZE - 1;
+    }
+    return length;
+}
+
+/**
+ * @brief 放弃当前候选帧，从其包头的下一个字节重新寻找包头
+ *        候选帧最长COMMAND_MAX_LENGTH字节，重新扫描的数据量有上限，总处理时间与数据量成线性
+ */
+static void Command_Resync(void)
+{
+    Command_AddReadIndex(1);
+    scan_index = read_index;
+    state = COMMAND_STATE_SYNC;
+}
+
+/**
+ * @brief 将read_index处长度为length的完整指令复制到command，最多两次memcpy
+ */
+static void Command_CopyOut(uint8_t *command, uint8_t length)
+{
+    if (read_index + length <= BUFFER_SIZE) {
+        memcpy(command, buffer + read_index, length);
+    } else {
+        uint16_t first_length = BUFFER_SIZE - read_index;
+        memcpy(command, buffer + read_index, first_length);
+        memcpy(command + first_length, buffer, length - first_length);
+    }
+}
+
 /**
  * @brief 尝试获取一条指令，重写该函数以适配指定协议格式
- * @param command 指令存放指针
+ *        帧同步状态机：每个新字节只累加一次校验和，状态在多次调用之间保持，
+ *        不完整的帧等下次调用时从上次扫描的位置继续
+ * @param command 指令存放指针，至少COMMAND_MAX_LENGTH字节
  * @return 获取的指令长度
  * @retval 0 没有获取到指令
  */
 uint8_t Command_GetCommand(uint8_t *command)
 {
-    // 寻找完整指令
-    while (1) {
-        // 如果缓冲区长度小于COMMAND_MIN_LENGTH 则不可能有完整的指令
-        if (Command_GetLength() < COMMAND_MIN_LENGTH) {
-            return 0;
-        }
-        // 如果不是包头 则跳过 重新开始寻找
-        if (Command_Read(read_index) != 0xAA) {
-            Command_AddReadIndex(1);
-            continue;
-        }
-        // 如果缓冲区长度小于指令长度 则不可能有完整的指令
-        uint8_t length = Command_Read(read_index + 1);
-        if (Command_GetLength() < length) {
-            return 0;
-        }
-        // 如果校验和不正确 则跳过 重新开始寻找
-        uint8_t sum = 0;
-        for (uint8_t i = 0; i < length - 1; i++) {
-            sum += Command_Read(read_index + i);
+    // 写索引在接收中断中更新，只处理调用时已写入的数据
+    uint16_t end = (read_index + Command_CheckOverrun()) % BUFFER_SIZE;
+
+    while (scan_index != end) {
+        switch (state) {
+        case COMMAND_STATE_SYNC: {
+            // 在连续的一段内查找包头，之前的数据直接丢弃
+            uint16_t span = ((end > scan_index) ? end : BUFFER_SIZE) - scan_index;
+            const uint8_t *p = buffer + scan_index;
+            uint16_t skip = 0;
+            while (skip < span && (p[skip] & COMMAND_HEADER_MASK) != COMMAND_HEADER) {
+                skip++;
+            }
+            Command_AddReadIndex(skip);
+            scan_index = read_index;
+            if (skip == span) {
+                break;
+            }
+            frame_header = buffer[read_index];
+            frame_sum = frame_header;
+            frame_crc = Command_Crc16Update(0xFFFF, frame_header);
+            scan_index = (read_index + 1) % BUFFER_SIZE;
+            state = COMMAND_STATE_LENGTH;
+            break;
         }
-        if (sum != Command_Read(read_index + length - 1)) {
-            Command_AddReadIndex(1);
-            continue;
+        case COMMAND_STATE_LENGTH:
+            // 长度不合法，不可能是包头
+            frame_length = buffer[scan_index];
+            if (frame_length < COMMAND_MIN_LENGTH || frame_length > COMMAND_MAX_LENGTH) {
+                Command_Resync();
+                break;
+            }
+            frame_sum += frame_length;
+            frame_crc = Command_Crc16Update(frame_crc, frame_length);
+            frame_count = 2;
+            scan_index = (scan_index + 1) % BUFFER_SIZE;
+            state = COMMAND_STATE_BODY;
+            break;
+        case COMMAND_STATE_BODY: {
+            uint8_t check_length = (frame_header == COMMAND_HEADER_V2) ? 2 : 1;
+            // 数据部分在连续的一段内累加校验和
+            if (frame_count < frame_length - check_length) {
+                uint16_t span = ((end > scan_index) ? end : BUFFER_SIZE) - scan_index;
+                uint8_t need = frame_length - check_length - frame_count;
+                uint8_t n = (span < need) ? span : need;
+                const uint8_t *p = buffer + scan_index;
+                if (frame_header == COMMAND_HEADER_V2) {
+                    uint16_t crc = frame_crc;
+                    for (uint8_t i = 0; i < n; i++) {
+                        crc = Command_Crc16Update(crc, p[i]);
+                    }
+                    frame_crc = crc;
+                } else {
+                    uint8_t sum = frame_sum;
+                    for (uint8_t i = 0; i < n; i++) {
+                        sum += p[i];
+                    }
+                    frame_sum = sum;
+                }
+                frame_count += n;
+                scan_index = (scan_index + n) % BUFFER_SIZE;
+                break;
+            }
+            // 如果校验和不正确 则从包头的下一个字节重新寻找
+            bool check_ok;
+            if (frame_header == COMMAND_HEADER_V2) {
+                // CRC的两个字节未全部到达，等待下次调用
+                uint16_t next = (scan_index + 1) % BUFFER_SIZE;
+                if (next == end) {
+                    return 0;
+                }
+                check_ok = (((uint16_t)buffer[scan_index] << 8) | buffer[next]) == frame_crc;
+            } else {
+                check_ok = (buffer[scan_index] == frame_sum);
+            }
+            if (!check_ok) {
+                Command_Resync();
+                break;
+            }
+            // 找到完整指令 则将指令写入command 返回指令长度
+            Command_CopyOut(command, frame_length);
+            Command_AddReadIndex(frame_length);
+            scan_index = read_index;
+            state = COMMAND_STATE_SYNC;
+            stats.frames++;
+            return frame_length;
         }
-        // 如果找到完整指令 则将指令写入command 返回指令长度
-        for (uint8_t i = 0; i < length; i++) {
-            command[i] = Command_Read(read_index + i);
         }
-        Command_AddReadIndex(length);
-        return length;
     }
+    return 0;
 }
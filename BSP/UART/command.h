@@ -1,7 +1,10 @@
 /**
  * @file command.h
  * @author Shiki
- * @brief UART Command, protocol format is 0xAA + length + data + checksum
+ * @brief UART Command, protocol format is 0xAA + length + data + checksum,
+ *        or 0xAB + length + data + CRC-16/CCITT (big-endian) for v2 frames
+ *        Use Command_StartReceive() for zero-copy circular DMA reception, and call
+ *        Command_RxEventCallback() / Command_ErrorCallback() from the HAL UART callbacks.
  * @version 0.1
  * @date 2025-07-13
  * 
@@ -12,9 +15,24 @@
 #define __COMMAND_H
 
 #include "main.h"
+#include <stdbool.h>
 #include <string.h>
 
+// 接收统计信息
+typedef struct {
+    uint32_t received;    // 累计收到的字节数
+    uint32_t frames;      // 解析出的完整指令数
+    uint32_t overruns;    // 缓冲区溢出次数（未处理的数据被DMA覆盖）
+    uint32_t lost_bytes;  // 因溢出或接收错误丢弃的字节数
+    uint32_t rx_errors;   // 串口接收错误次数
+} CommandStats_t;
+
 uint8_t Command_Write(uint8_t *data, uint8_t length);
 uint8_t Command_GetCommand(uint8_t *command);
+void Command_StartReceive(UART_HandleTypeDef *huart);
+void Command_RxEventCallback(uint16_t Size);
+void Command_ErrorCallback(void);
+void Command_GetStats(CommandStats_t *out);
+uint32_t Command_GetRxTick(void);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "host_command.h"
+
+#include <stddef.h>
+
+#include "uart_user.h"
+
+static HostCommandStats_t stats = {0};
+// 打印耗时统计的请求，指令在TIM6中断中解析，打印由主循环执行
+static volatile bool dump_request = false;
+
+/**
+ * @brief 设置视觉坐标中值滤波窗口
+ */
+static bool HostCommand_MedianWindow(const uint8_t *param, uint8_t length)
+{
+    if (length != 2 || param[1] > 1) {
+        return false;
+    }
+    return Uart_SetMedianWindow(param[0], param[1] != 0);
+}
+
+/**
+ * @brief 请求打印耗时统计
+ */
+static bool HostCommand_ProfilerDump(uint8_t length)
+{
+    if (length != 0) {
+        return false;
+    }
+    dump_request = true;
+    return true;
+}
+
+/**
+ * @brief 识别并执行一条上位机控制指令（已由Command_GetCommand完成帧同步和校验）
+ * @param data 指令数据
+ * @param length 指令长度
+ * @return true 是控制指令（无论执行是否成功），false 不是控制指令，应按视觉数据包解析
+ */
+bool HostCommand_Handle(const uint8_t *data, uint8_t length)
+{
+    if (data == NULL || length < HOST_COMMAND_HEAD_LEN + HOST_COMMAND_CRC_LEN ||
+        data[0] != HOST_COMMAND_HEADER || data[2] != HOST_COMMAND_TYPE) {
+        return false;
+    }
+
+    const uint8_t *param = &data[HOST_COMMAND_HEAD_LEN];
+    uint8_t param_len = length - HOST_COMMAND_HEAD_LEN - HOST_COMMAND_CRC_LEN;
+    bool ok = false;
+    switch (data[3]) {
+        case HOST_CMD_MEDIAN_WINDOW:
+            ok = HostCommand_MedianWindow(param, param_len);
+            break;
+        case HOST_CMD_PROFILER_DUMP:
+            ok = HostCommand_ProfilerDump(param_len);
+            break;
+        default:
+            break;
+    }
+
+    if (ok) {
+        stats.accepted++;
+    } else {
+        stats.rejected++;
+    }
+    return true;
+}
+
+/**
+ * @brief 获取控制指令统计信息
+ */
+void HostCommand_GetStats(HostCommandStats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+}
+
+/**
+ * @brief 读取并清除打印耗时统计的请求
+ * @return true 收到过HOST_CMD_PROFILER_DUMP指令
+ */
+bool HostCommand_TakeDumpRequest(void)
+{
+    if (!dump_request) {
+        return false;
+    }
+    dump_request = false;
+    return true;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file host_command.h
+ * @author Shiki
+ * @brief 上位机控制指令，与v2视觉数据包共用串口2和帧格式：
+ *        0xAB + 长度 + 类型(0x80) + 指令号 + 参数 + CRC-16（高字节在前）
+ *        类型字节位于v2数据包的版本号位置，Uart_DataProcess()先交给HostCommand_Handle()，
+ *        不是控制指令的再按视觉数据包解析。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __HOST_COMMAND_H
+#define __HOST_COMMAND_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define HOST_COMMAND_HEADER 0xAB
+#define HOST_COMMAND_TYPE 0x80
+#define HOST_COMMAND_HEAD_LEN 4  // 指令号之前（含）的字节数
+#define HOST_COMMAND_CRC_LEN 2
+
+/* 指令号 */
+typedef enum {
+    HOST_CMD_MEDIAN_WINDOW = 0x01,  // 参数：窗口大小(1~15奇数) + 模式(0中值，1 Hampel)
+    HOST_CMD_PROFILER_DUMP = 0x02,  // 无参数：打印并清零耗时统计和任务运行统计（同按键S9）
+} HostCommandId_t;
+
+typedef struct {
+    uint32_t accepted;  // 执行成功的指令数
+    uint32_t rejected;  // 指令号未知或参数不合法的指令数
+} HostCommandStats_t;
+
+bool HostCommand_Handle(const uint8_t *data, uint8_t length);
+void HostCommand_GetStats(HostCommandStats_t *stats);
+bool HostCommand_TakeDumpRequest(void);  // 读取并清除打印请求，在主循环中调用
+
+#endif
@@ -0,0 +1,150 @@
+#include "uart_log.h"
+
+#include <string.h>
+
+#include "usart.h"
+
+#define UART_LOG_MASK (UART_LOG_BUFFER_SIZE - 1U)
+
+static uint8_t log_buffer[UART_LOG_BUFFER_SIZE];
+static volatile uint32_t log_head = 0;    // 累计写入字节数，只由UartLog_Write修改
+static volatile uint32_t log_tail = 0;    // 累计发送完成字节数，只在发送完成时修改
+static volatile uint16_t tx_len = 0;      // 正在发送的字节数，0表示DMA空闲
+static UartLogStats_t log_stats = {0};    // 统计信息
+
+/**
+ * @brief 缓冲区非空且DMA空闲时，发送从读取位置到缓冲区末尾（或写入位置）的连续数据
+ *        主循环与发送完成中断都会调用，内部关中断保护
+ */
+static void UartLog_Kick(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t tail = log_tail;
+    uint32_t used = log_head - tail;
+    if (tx_len == 0 && used > 0) {
+        uint32_t pos = tail & UART_LOG_MASK;
+        uint32_t len = UART_LOG_BUFFER_SIZE - pos;
+        if (len > used) {
+            len = used;
+        }
+        // 启动失败（串口被其他发送占用）时保留数据，下次写入或发送完成时重试
+        if (HAL_UART_Transmit_DMA(&huart2, &log_buffer[pos], (uint16_t)len) == HAL_OK) {
+            tx_len = (uint16_t)len;
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 清空缓冲区和统计信息，应在第一次printf之前、DMA空闲时调用
+ */
+void UartLog_Init(void)
+{
+    log_head = 0;
+    log_tail = 0;
+    tx_len = 0;
+    memset(&log_stats, 0, sizeof(log_stats));
+}
+
+/**
+ * @brief 写入缓冲区，不等待发送
+ * @param data 数据
+ * @param len 长度
+ * @return true 已写入，false 剩余空间不足，整段丢弃并计入dropped
+ */
+bool UartLog_Write(const uint8_t *data, uint16_t len)
+{
+    if (data == NULL || len == 0) {
+        return true;
+    }
+
+    uint32_t head = log_head;
+    uint32_t used = head - log_tail;
+    if (UART_LOG_BUFFER_SIZE - used < len) {
+        log_stats.dropped += len;
+        return false;
+    }
+
+    for (uint16_t i = 0; i < len; i++) {
+        log_buffer[(head + i) & UART_LOG_MASK] = data[i];
+    }
+    // 数据写入完成后再更新写入位置
+    __DMB();
+    log_head = head + len;
+
+    log_stats.written += len;
+    if (used + len > log_stats.high_water) {
+        log_stats.high_water = (uint16_t)(used + len);
+    }
+
+    if (tx_len == 0) {
+        UartLog_Kick();
+    }
+    return true;
+}
+
+/**
+ * @brief USART2 DMA发送完成时调用，释放已发送的数据并发送下一段
+ */
+void UartLog_TxCpltCallback(void)
+{
+    if (tx_len != 0) {
+        log_tail += tx_len;
+        log_stats.sent += tx_len;
+        tx_len = 0;
+    }
+    UartLog_Kick();
+}
+
+/**
+ * @brief USART2错误时调用，DMA发送出错被中止时重新发送当前数据段
+ */
+void UartLog_ErrorCallback(void)
+{
+    if (tx_len != 0 && huart2.gState == HAL_UART_STATE_READY) {
+        log_stats.tx_errors++;
+        tx_len = 0;
+        UartLog_Kick();
+    }
+}
+
+/**
+ * @brief 缓冲区为空且DMA空闲
+ */
+bool UartLog_IsIdle(void)
+{
+    return tx_len == 0 && log_head == log_tail;
+}
+
+/**
+ * @brief 获取发送统计信息
+ */
+void UartLog_GetStats(UartLogStats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = log_stats;
+    stats->pending = (uint16_t)(log_head - log_tail);
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 清零统计信息
+ */
+void UartLog_ResetStats(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    log_stats.written = 0;
+    log_stats.sent = 0;
+    log_stats.dropped = 0;
+    log_stats.tx_errors = 0;
+    log_stats.high_water = 0;
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file uart_log.h
+ * @author Shiki
+ * @brief USART2非阻塞日志输出（printf重定向）
+ *        fputc只把字符写入环形缓冲区，由DMA(DMA1_Stream6)在后台发送，调用者不等待串口；
+ *        缓冲区满时丢弃字符并计数。115200波特率下每字符约87us，原来的逐字节阻塞发送会拖慢控制循环。
+ *        缓冲区为单生产者（主循环中的printf）、单消费者（DMA发送完成中断）：写入位置只由fputc修改，
+ *        读取位置只在发送完成时修改，写入字符不需要关中断。不要在中断中调用printf。
+ *        Remember to call UartLog_TxCpltCallback() in HAL_UART_TxCpltCallback for USART2!!!
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __UART_LOG_H
+#define __UART_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define UART_LOG_BUFFER_SIZE 4096  // 环形缓冲区大小，需为2的幂（可容纳按键S9的统计输出）
+
+// 发送统计信息
+typedef struct {
+    uint32_t written;     // 写入缓冲区的字节数
+    uint32_t sent;        // 已发送完成的字节数
+    uint32_t dropped;     // 缓冲区满被丢弃的字节数
+    uint32_t tx_errors;   // 发送错误次数
+    uint16_t pending;     // 当前缓冲区中的字节数（含正在发送的）
+    uint16_t high_water;  // 缓冲区中字节数历史最大值
+} UartLogStats_t;
+
+void UartLog_Init(void);
+bool UartLog_Write(const uint8_t *data, uint16_t len);  // 写入缓冲区，空间不足时整段丢弃
+void UartLog_TxCpltCallback(void);                      // USART2 DMA发送完成回调中调用
+void UartLog_ErrorCallback(void);                       // USART2错误回调中调用
+bool UartLog_IsIdle(void);                              // 缓冲区为空且DMA空闲
+void UartLog_GetStats(UartLogStats_t *stats);
+void UartLog_ResetStats(void);
+
+#endif
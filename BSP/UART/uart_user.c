@@ -3,83 +3,45 @@
 #include <stdio.h>
 
 #include "command.h"
+#include "emm_feedback.h"
+#include "gimbal_motion.h"
+#include "host_command.h"
 #include "laser_shot_common.h"
+#include "median_filter.h"
+#include "profiler.h"
+#include "target_predictor.h"
 #include "task_scheduler.h"
+#include "uart_log.h"
 #include "usart.h"
 #include "user_init.h"
+#include "vision_packet.h"
 
 uint8_t g_uart_command_buffer[UART_USER_BUFFER_SIZE];  // UART command buffer
 
 // 中值滤波相关变量
-#define FILTER_BUFFER_SIZE 3                           // 滤波缓冲区大小
-static PixelPoint_t point_buffer[FILTER_BUFFER_SIZE];  // 坐标缓冲区
-static uint8_t buffer_index = 0;                       // 当前缓冲区索引
-static uint8_t buffer_filled = 0;                      // 缓冲区是否已填满
+#define FILTER_BUFFER_SIZE 3                                       // 默认滤波窗口大小
+static MedianFilter_t median_x = {.window = FILTER_BUFFER_SIZE};  // X坐标滤波器
+static MedianFilter_t median_y = {.window = FILTER_BUFFER_SIZE};  // Y坐标滤波器
 
 // 滤波控制变量
-static bool filter_enabled = true;  // 滤波使能标志
+static bool filter_enabled = true;                         // 滤波使能标志
+static UartFilterMode_t filter_mode = UART_FILTER_MEDIAN;  // 使能时使用的滤波方式
+static KalmanCv2d_t vision_kalman = {                      // 卡尔曼滤波器
+    .q = KALMAN_CV2D_Q,
+    .r = KALMAN_CV2D_R,
+};
 
 /**
- * @brief 获取中值（冒泡排序）
- *
- * @param values 待排序的数组
- * @param size 数组大小
- * @return uint16_t 中值
- */
-static uint16_t GetMedian(uint16_t values[], uint8_t size)
-{
-    uint16_t temp;
-    uint8_t i, j;
-
-    // 冒泡排序
-    for (i = 0; i < size - 1; i++) {
-        for (j = 0; j < size - i - 1; j++) {
-            if (values[j] > values[j + 1]) {
-                temp = values[j];
-                values[j] = values[j + 1];
-                values[j + 1] = temp;
-            }
-        }
-    }
-
-    // 返回中值
-    return values[size / 2];
-}
-
-/**
- * @brief 对中心点坐标进行中值滤波
+ * @brief 对中心点坐标进行中值滤波（X、Y独立处理）
  *
  * @param point 待处理的坐标点
- * @return PixelPoint_t 处理后的坐标点
+ * @return PixelPoint_t 处理后的坐标点，窗口未填满时返回原值
  */
 static PixelPoint_t FilterCenterPoint(PixelPoint_t point)
 {
-    // 将新值加入缓冲区
-    point_buffer[buffer_index] = point;
-    buffer_index = (buffer_index + 1) % FILTER_BUFFER_SIZE;
-
-    // 如果缓冲区未填满，直接返回原值
-    if (!buffer_filled && buffer_index != 0) {
-        return point;
-    }
-
-    // 标记缓冲区已填满
-    buffer_filled = 1;
-
-    // 提取X坐标和Y坐标进行独立处理
-    uint16_t x_values[FILTER_BUFFER_SIZE];
-    uint16_t y_values[FILTER_BUFFER_SIZE];
-
-    for (uint8_t i = 0; i < FILTER_BUFFER_SIZE; i++) {
-        x_values[i] = point_buffer[i].x;
-        y_values[i] = point_buffer[i].y;
-    }
-
-    // 计算中值并返回
     PixelPoint_t filtered_point;
-    filtered_point.x = GetMedian(x_values, FILTER_BUFFER_SIZE);
-    filtered_point.y = GetMedian(y_values, FILTER_BUFFER_SIZE);
-
+    filtered_point.x = MedianFilter_Update(&median_x, point.x);
+    filtered_point.y = MedianFilter_Update(&median_y, point.y);
     return filtered_point;
 }
 
@@ -89,25 +51,50 @@ static PixelPoint_t FilterCenterPoint(PixelPoint_t point)
  */
 void Uart_DataProcess(void)
 {
-    uint8_t command_length = Command_GetCommand(g_uart_command_buffer);
+    uint8_t command_length;
+
+    PROFILER_BEGIN(UART_PROCESS);
+
+    // 收到正确格式数据包时的解析，一次处理完已收到的所有数据包
+    while ((command_length = Command_GetCommand(g_uart_command_buffer)) != 0) {
+        // 上位机控制指令与视觉数据包共用串口
+        if (HostCommand_Handle(g_uart_command_buffer, command_length)) {
+            continue;
+        }
 
-    // 收到正确格式数据包时的解析
-    if (command_length) {
-        // 获取原始坐标值
-        PixelPoint_t raw_point;
-        raw_point.x = (g_uart_command_buffer[2] << 8) | g_uart_command_buffer[3];
-        raw_point.y = (g_uart_command_buffer[4] << 8) | g_uart_command_buffer[5];
+        // 解析旧格式或v2格式数据包
+        if (!VisionPacket_Update(g_uart_command_buffer, command_length, Command_GetRxTick())) {
+            continue;
+        }
+
+        // 获取原始坐标值，未检测到目标时为(0,0)，兼容旧的判断方式
+        PixelPoint_t raw_point = {0, 0};
+        VisionPacket_GetCenter(&g_vision_packet, &raw_point);
 
-        // 根据滤波使能标志决定是否应用中值滤波
-        if (filter_enabled) {
+        // 根据滤波使能标志和滤波方式处理坐标
+        PROFILER_BEGIN(VISION_FILTER);
+        if (filter_enabled && filter_mode == UART_FILTER_MEDIAN) {
             // 应用中值滤波
             PixelPoint_t filtered_point = FilterCenterPoint(raw_point);
             g_curr_center_point = filtered_point;
+        } else if (filter_enabled && filter_mode == UART_FILTER_KALMAN &&
+                   VisionPacket_TargetDetected()) {
+            // 应用卡尔曼滤波，离群测量被拒绝时使用预测位置；未检测到目标时仍输出(0,0)
+            KalmanCv2d_Update(&vision_kalman, raw_point, g_vision_packet.rx_tick);
+            g_curr_center_point = KalmanCv2d_GetPosition(&vision_kalman);
         } else {
             // 直接使用原始数据，不进行滤波
             g_curr_center_point = raw_point;
         }
+        PROFILER_END(VISION_FILTER);
+
+        // 检测到目标时按到达时刻更新预测器，丢失目标时由预测器超时处理
+        if (VisionPacket_TargetDetected()) {
+            Predictor_Update(&g_target_predictor, g_curr_center_point, g_vision_packet.rx_tick);
+        }
     }
+
+    PROFILER_END(UART_PROCESS);
 }
 
 /**
@@ -116,18 +103,84 @@ void Uart_DataProcess(void)
  */
 void Uart_SetFilterEnabled(bool enable)
 {
+    // 滤波器在TIM6中断中使用，关中断修改
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
     filter_enabled = enable;
 
     // 如果重新启用滤波，清空滤波缓冲区以避免使用旧数据
     if (enable) {
-        buffer_index = 0;
-        buffer_filled = 0;
-        // 清空缓冲区
-        for (uint8_t i = 0; i < FILTER_BUFFER_SIZE; i++) {
-            point_buffer[i].x = 0;
-            point_buffer[i].y = 0;
-        }
+        KalmanCv2d_Reset(&vision_kalman);
+        MedianFilter_Reset(&median_x);
+        MedianFilter_Reset(&median_y);
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 设置中值滤波窗口大小和模式
+ * @param window 窗口大小，奇数，1~MEDIAN_FILTER_MAX_WINDOW
+ * @param hampel true为Hampel离群值替换，false为中值滤波
+ * @return true 设置成功，false 参数不合法（保持原设置）
+ */
+bool Uart_SetMedianWindow(uint8_t window, bool hampel)
+{
+    MedianFilter_t fx, fy;
+    if (!MedianFilter_Init(&fx, window, hampel, MEDIAN_FILTER_HAMPEL_K) ||
+        !MedianFilter_Init(&fy, window, hampel, MEDIAN_FILTER_HAMPEL_K)) {
+        return false;
+    }
+
+    // 滤波器在TIM6中断中使用，关中断替换
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    median_x = fx;
+    median_y = fy;
+    __set_PRIMASK(primask);
+    return true;
+}
+
+/**
+ * @brief 获取中值滤波窗口大小和模式
+ * @param hampel Hampel模式输出，可为NULL
+ * @return 窗口大小
+ */
+uint8_t Uart_GetMedianWindow(bool *hampel)
+{
+    if (hampel != NULL) {
+        *hampel = median_x.hampel;
     }
+    return median_x.window;
+}
+
+/**
+ * @brief 选择滤波使能时使用的滤波方式，UART_FILTER_NONE等同于禁用滤波
+ * @param mode 滤波方式
+ */
+void Uart_SetFilterMode(UartFilterMode_t mode)
+{
+    // 方式和滤波器状态一起切换，中断中不会用新方式处理旧状态
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    filter_mode = mode;
+    Uart_SetFilterEnabled(mode != UART_FILTER_NONE);
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 获取当前的滤波方式
+ */
+UartFilterMode_t Uart_GetFilterMode(void)
+{
+    return filter_mode;
+}
+
+/**
+ * @brief 获取卡尔曼滤波器状态（位置、速度、新息大小、离群计数）
+ */
+const KalmanCv2d_t *Uart_GetKalman(void)
+{
+    return &vision_kalman;
 }
 
 // 中断空闲接收回调函数
@@ -135,15 +188,41 @@ void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 {
     // Check if the UART instance is USART2
     if (huart->Instance == USART2) {
-        Command_Write(g_uart_command_buffer, Size);
-        // Re-enable the reception event
-        HAL_UARTEx_ReceiveToIdle_DMA(huart, g_uart_command_buffer, UART_USER_BUFFER_SIZE);
-        __HAL_DMA_DISABLE_IT(&hdma_usart2_rx, DMA_IT_HT);
+        // DMA循环接收，数据在指令缓冲区中原地解析，无需拷贝和重新启动接收
+        Command_RxEventCallback(Size);
+    } else if (huart->Instance == USART1) {
+        // 电机应答帧在DMA循环缓冲区中原地解析
+        EmmFeedback_RxEventCallback(Size);
+    }
+}
+
+// 接收错误回调函数
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART1) {
+        EmmFeedback_ErrorCallback();
+    } else if (huart->Instance == USART2) {
+        Command_ErrorCallback();
+        UartLog_ErrorCallback();
+    }
+}
+
+// DMA发送完成回调函数
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    // USART1: 释放已发送的电机命令槽位并发送下一帧，再补充云台待发送命令
+    if (huart->Instance == USART1) {
+        Emm_V5_TxCpltCallback();
+        GimbalMotion_TxCpltCallback();
+    } else if (huart->Instance == USART2) {
+        // USART2: 释放已发送的日志数据并发送下一段
+        UartLog_TxCpltCallback();
     }
 }
 
 /**
  * @brief 重定向c库函数printf到DEBUG_USARTx
+ *        写入日志缓冲区后立即返回，由DMA在后台发送，缓冲区满时丢弃
  *
  * @param ch
  * @param f
@@ -151,7 +230,8 @@ void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
  */
 int fputc(int ch, FILE *f)
 {
-    HAL_UART_Transmit(&huart2, (uint8_t *)&ch, 1, 0xffff);
+    uint8_t c = (uint8_t)ch;
+    UartLog_Write(&c, 1);
     return ch;
 }
 
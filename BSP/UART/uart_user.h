@@ -1,8 +1,8 @@
 /**
  * @file uart_user.h
  * @author Shiki
- * @brief UART user buffer, to start, use HAL_UARTEx_ReceiveToIdle_DMA in user_init.c
- *        to receive data into this buffer.
+ * @brief UART user buffer, to start, use Command_StartReceive(&huart2) in user_init.c
+ *        to receive data by circular DMA, complete commands are copied into this buffer.
  *        Remember to call Uart_DataProcess() in the task scheduler to process the received data.
  * @version 0.1
  * @date 2025-07-13
@@ -16,10 +16,16 @@
 #include "main.h"
 #include "stdio.h"
 #include "stdbool.h"
+#include "kalman_cv2d.h"
 
 #define UART_USER_BUFFER_SIZE 32
 
-extern DMA_HandleTypeDef hdma_usart2_rx;
+// 视觉坐标滤波方式
+typedef enum {
+    UART_FILTER_NONE = 0,  // 不滤波
+    UART_FILTER_MEDIAN,    // 中值滤波
+    UART_FILTER_KALMAN     // 卡尔曼滤波（匀速模型，带离群测量拒绝）
+} UartFilterMode_t;
 
 extern uint8_t g_uart_command_buffer[UART_USER_BUFFER_SIZE]; // UART command buffer
 
@@ -28,5 +34,12 @@ void Uart_DataProcess(void);
 
 // Function to enable or disable median filter
 void Uart_SetFilterEnabled(bool enable);
+// Select the filter used while filtering is enabled
+void Uart_SetFilterMode(UartFilterMode_t mode);
+UartFilterMode_t Uart_GetFilterMode(void);
+const KalmanCv2d_t *Uart_GetKalman(void);
+// Configure the median filter window (odd, up to 15) and Hampel mode
+bool Uart_SetMedianWindow(uint8_t window, bool hampel);
+uint8_t Uart_GetMedianWindow(bool *hampel);
 
 #endif
@@ -0,0 +1,191 @@
+#include "vision_packet.h"
+
+#include <string.h>
+
+#include "main.h"
+
+VisionPacket_t g_vision_packet = {0};
+
+static VisionPacketStats_t stats = {0};
+// 旧格式没有帧序号，用本地计数代替
+static uint16_t v1_seq = 0;
+
+/**
+ * @brief 读取高字节在前的16位数据
+ */
+static uint16_t VisionPacket_ReadU16(const uint8_t *p)
+{
+    return ((uint16_t)p[0] << 8) | p[1];
+}
+
+/**
+ * @brief 读取高字节在前的32位数据
+ */
+static uint32_t VisionPacket_ReadU32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @brief 解析旧格式：X、Y位于第2~5字节，(0,0)表示未检测到目标
+ */
+static bool VisionPacket_ParseV1(const uint8_t *data, uint8_t length, VisionPacket_t *packet)
+{
+    if (length < 7) {
+        return false;
+    }
+    packet->version = 1;
+    packet->seq = v1_seq++;
+    packet->timestamp = 0;
+    packet->point_count = 1;
+    packet->points[0].x = VisionPacket_ReadU16(&data[2]);
+    packet->points[0].y = VisionPacket_ReadU16(&data[4]);
+    if (packet->points[0].x != 0 || packet->points[0].y != 0) {
+        packet->flags = VISION_FLAG_VALID;
+        packet->confidence = 255;
+    } else {
+        packet->flags = 0;
+        packet->confidence = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief 解析v2格式，长度必须与点数一致
+ */
+static bool VisionPacket_ParseV2(const uint8_t *data, uint8_t length, VisionPacket_t *packet)
+{
+    if (length < VISION_PACKET_V2_HEAD_LEN + VISION_PACKET_V2_CRC_LEN ||
+        data[2] != VISION_PACKET_VERSION_V2) {
+        return false;
+    }
+    uint8_t count = data[11];
+    if (count > VISION_MAX_POINTS ||
+        length != VISION_PACKET_V2_HEAD_LEN + count * 4 + VISION_PACKET_V2_CRC_LEN) {
+        return false;
+    }
+
+    packet->version = 2;
+    packet->seq = VisionPacket_ReadU16(&data[3]);
+    packet->timestamp = VisionPacket_ReadU32(&data[5]);
+    packet->confidence = data[9];
+    packet->flags = data[10];
+    packet->point_count = count;
+    for (uint8_t i = 0; i < count; i++) {
+        const uint8_t *p = &data[VISION_PACKET_V2_HEAD_LEN + i * 4];
+        packet->points[i].x = VisionPacket_ReadU16(p);
+        packet->points[i].y = VisionPacket_ReadU16(p + 2);
+    }
+    // 没有点时不可能有效
+    if (count == 0) {
+        packet->flags &= (uint8_t)~VISION_FLAG_VALID;
+    }
+    return true;
+}
+
+/**
+ * @brief 解析一条完整的视觉指令（已由Command_GetCommand完成帧同步和校验）
+ * @param data 指令数据
+ * @param length 指令长度
+ * @param packet 解析结果
+ * @return true 解析成功，false 格式不合法
+ */
+bool VisionPacket_Parse(const uint8_t *data, uint8_t length, VisionPacket_t *packet)
+{
+    if (data == NULL || packet == NULL || length < 2) {
+        return false;
+    }
+
+    memset(packet, 0, sizeof(VisionPacket_t));
+    packet->rx_tick = HAL_GetTick();
+
+    if (data[0] == VISION_PACKET_HEADER_V1) {
+        return VisionPacket_ParseV1(data, length, packet);
+    }
+    if (data[0] == VISION_PACKET_HEADER_V2) {
+        return VisionPacket_ParseV2(data, length, packet);
+    }
+    return false;
+}
+
+/**
+ * @brief 解析一条视觉指令并更新g_vision_packet和统计信息
+ * @param data 指令数据
+ * @param length 指令长度
+ * @param rx_tick 数据包到达时刻(ms)
+ * @return true 解析成功，false 格式不合法（g_vision_packet保持不变）
+ */
+bool VisionPacket_Update(const uint8_t *data, uint8_t length, uint32_t rx_tick)
+{
+    VisionPacket_t packet;
+    if (!VisionPacket_Parse(data, length, &packet)) {
+        stats.invalid++;
+        return false;
+    }
+    packet.rx_tick = rx_tick;
+
+    if (packet.version == 2) {
+        // 帧序号不连续，说明相机帧丢失（序号回绕按16位计算）
+        if (stats.v2_packets > 0 && g_vision_packet.version == 2) {
+            uint16_t gap = (uint16_t)(packet.seq - g_vision_packet.seq);
+            if (gap > 1 && gap < 0x8000) {
+                stats.seq_gaps += gap - 1;
+            }
+        }
+        stats.v2_packets++;
+    } else {
+        stats.v1_packets++;
+    }
+
+    g_vision_packet = packet;
+    return true;
+}
+
+/**
+ * @brief 获取数据包中目标的中心点
+ * @param packet 数据包
+ * @param center 中心点输出
+ * @return true 检测到目标，false 未检测到目标（center不修改）
+ */
+bool VisionPacket_GetCenter(const VisionPacket_t *packet, PixelPoint_t *center)
+{
+    if (packet == NULL || center == NULL || !(packet->flags & VISION_FLAG_VALID) ||
+        packet->point_count == 0) {
+        return false;
+    }
+
+    if (!(packet->flags & VISION_FLAG_CORNERS)) {
+        *center = packet->points[0];
+        return true;
+    }
+
+    // 角点取平均值作为中心
+    uint32_t sum_x = 0, sum_y = 0;
+    for (uint8_t i = 0; i < packet->point_count; i++) {
+        sum_x += packet->points[i].x;
+        sum_y += packet->points[i].y;
+    }
+    center->x = (uint16_t)((sum_x + packet->point_count / 2) / packet->point_count);
+    center->y = (uint16_t)((sum_y + packet->point_count / 2) / packet->point_count);
+    return true;
+}
+
+/**
+ * @brief 最近一个数据包是否检测到目标
+ *        v2格式使用有效标志位，旧格式由(0,0)判断
+ */
+bool VisionPacket_TargetDetected(void)
+{
+    return (g_vision_packet.flags & VISION_FLAG_VALID) != 0;
+}
+
+/**
+ * @brief 获取解析统计信息
+ */
+void VisionPacket_GetStats(VisionPacketStats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+}
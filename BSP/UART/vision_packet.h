@@ -0,0 +1,58 @@
+/**
+ * @file vision_packet.h
+ * @author Shiki
+ * @brief 视觉数据包解析，兼容旧格式与v2格式
+ *        旧格式：0xAA + 长度 + X(2) + Y(2) + ... + 累加和，(0,0)表示未检测到目标
+ *        v2格式：0xAB + 长度 + 版本(0x02) + 帧序号(2) + 采集时间戳(4) + 置信度 + 标志 + 点数
+ *               + 点数 * (X(2) + Y(2)) + CRC-16，多字节数据高字节在前
+ *        帧同步与校验由command.c完成，这里只解析完整的指令
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __VISION_PACKET_H
+#define __VISION_PACKET_H
+
+#include "laser_shot_common.h"
+
+#define VISION_PACKET_HEADER_V1 0xAA
+#define VISION_PACKET_HEADER_V2 0xAB
+#define VISION_PACKET_VERSION_V2 0x02
+#define VISION_MAX_POINTS 4          // 单个数据包最多的目标点数（如矩形四个角点）
+#define VISION_PACKET_V2_HEAD_LEN 12 // v2格式点数据之前的字节数
+#define VISION_PACKET_V2_CRC_LEN 2   // v2格式CRC字节数
+
+/* 数据包标志位 */
+#define VISION_FLAG_VALID 0x01    // 检测到目标
+#define VISION_FLAG_CORNERS 0x02  // 点为目标的角点，中心取各点平均值；否则第一个点即目标中心
+
+typedef struct {
+    uint8_t version;                        // 1为旧格式，2为v2格式
+    uint16_t seq;                           // 相机帧序号（旧格式为本地计数）
+    uint32_t timestamp;                     // 相机采集时间戳(ms)，旧格式为0
+    uint8_t confidence;                     // 检测置信度0~255，旧格式检测到目标时为255
+    uint8_t flags;                          // 标志位
+    uint8_t point_count;                    // 目标点数
+    PixelPoint_t points[VISION_MAX_POINTS]; // 目标点坐标
+    uint32_t rx_tick;                       // 数据包到达时刻(ms)
+} VisionPacket_t;
+
+typedef struct {
+    uint32_t v1_packets;  // 旧格式数据包数
+    uint32_t v2_packets;  // v2格式数据包数
+    uint32_t invalid;     // 校验通过但内容不合法的数据包数
+    uint32_t seq_gaps;    // 按帧序号推算丢失的相机帧数
+} VisionPacketStats_t;
+
+extern VisionPacket_t g_vision_packet;  // 最近一次解析成功的数据包
+
+bool VisionPacket_Parse(const uint8_t *data, uint8_t length, VisionPacket_t *packet);
+bool VisionPacket_Update(const uint8_t *data, uint8_t length,
+                         uint32_t rx_tick);  // 解析并更新g_vision_packet
+bool VisionPacket_GetCenter(const VisionPacket_t *packet, PixelPoint_t *center);
+bool VisionPacket_TargetDetected(void);  // 最近一个数据包是否检测到目标
+void VisionPacket_GetStats(VisionPacketStats_t *stats);
+
+#endif
@@ -1,5 +1,7 @@
 #include "Emm_V5.h"
 
+#include <string.h>
+
 /**********************************************************
 ***	Emm_V5.0步进闭环控制例程
 ***	编写作者：ZHANGDATOU
@@ -11,6 +13,187 @@
 
 __IO uint16_t MMCL_count = 0, MMCL_cmd[MMCL_LEN] = {0};
 
+/**********************************************************
+*** 发送队列
+**********************************************************/
+// 发送队列槽位，命令装载后拷贝到槽位中，发送完成前槽位不会被覆盖
+typedef struct {
+    uint8_t data[EMM_V5_TX_FRAME_MAX];  // 命令数据
+    const uint8_t *ext;                 // 外部缓冲区（多电机命令），为NULL时使用data
+    uint16_t len;                       // 命令长度
+} Emm_V5_TxSlot_t;
+
+static Emm_V5_TxSlot_t tx_queue[EMM_V5_TX_QUEUE_LEN];
+static volatile uint8_t tx_head = 0;     // 写入位置
+static volatile uint8_t tx_tail = 0;     // 正在发送/下一条待发送的位置
+static volatile uint8_t tx_count = 0;    // 队列中帧数（含正在发送的帧）
+static volatile bool tx_busy = false;    // DMA正在发送tx_tail处的帧
+static Emm_V5_TxStats_t tx_stats = {0};  // 统计信息
+
+// 多电机命令缓冲区（帧长超过槽位大小，单独存放）
+static uint8_t mmcl_tx_buf[MMCL_LEN + 5];
+static volatile bool mmcl_tx_busy = false;
+
+/**
+ * @brief    队列非空且DMA空闲时启动下一帧发送，调用者需关中断
+ */
+static void Emm_V5_TxQueue_Kick(void)
+{
+    while (!tx_busy && tx_count > 0) {
+        Emm_V5_TxSlot_t *slot = &tx_queue[tx_tail];
+        const uint8_t *data = (slot->ext != NULL) ? slot->ext : slot->data;
+
+        if (HAL_UART_Transmit_DMA(&huart1, (uint8_t *)data, slot->len) == HAL_OK) {
+            tx_busy = true;
+            break;
+        }
+
+        // 启动失败，丢弃该帧继续下一帧
+        ++tx_stats.dropped;
+        if (slot->ext != NULL) {
+            mmcl_tx_busy = false;
+        }
+        tx_tail = (tx_tail + 1) % EMM_V5_TX_QUEUE_LEN;
+        --tx_count;
+    }
+}
+
+/**
+ * @brief    将一帧放入发送队列
+ * @param    data ：命令数据，ext为NULL时拷贝到槽位
+ * @param    ext  ：外部缓冲区，不为NULL时槽位只保存指针
+ * @param    len  ：命令长度
+ * @retval   true为已入队，false为被丢弃
+ */
+static bool Emm_V5_TxQueue_Push(const uint8_t *data, const uint8_t *ext, uint16_t len)
+{
+    bool ok = false;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (tx_count >= EMM_V5_TX_QUEUE_LEN) {
+        ++tx_stats.overflow;
+    } else {
+        Emm_V5_TxSlot_t *slot = &tx_queue[tx_head];
+        if (ext == NULL) {
+            memcpy(slot->data, data, len);
+        }
+        slot->ext = ext;
+        slot->len = len;
+        tx_head = (tx_head + 1) % EMM_V5_TX_QUEUE_LEN;
+        ++tx_count;
+        if (tx_count > tx_stats.high_water) {
+            tx_stats.high_water = tx_count;
+        }
+        ok = true;
+        Emm_V5_TxQueue_Kick();
+    }
+
+    __set_PRIMASK(primask);
+    return ok;
+}
+
+/**
+ * @brief    发送命令（拷贝到发送队列）
+ * @param    cmd ：命令数据
+ * @param    len ：命令长度
+ */
+static void Emm_V5_Transmit(const uint8_t *cmd, uint16_t len)
+{
+    if (len > EMM_V5_TX_FRAME_MAX) {
+        ++tx_stats.dropped;
+        return;
+    }
+    Emm_V5_TxQueue_Push(cmd, NULL, len);
+}
+
+/**
+ * @brief    发送多电机命令（队列只保存缓冲区指针）
+ * @param    cmd ：多电机命令缓冲区
+ * @param    len ：命令长度
+ */
+static void Emm_V5_Transmit_External(const uint8_t *cmd, uint16_t len)
+{
+    mmcl_tx_busy = true;
+    if (!Emm_V5_TxQueue_Push(NULL, cmd, len)) {
+        mmcl_tx_busy = false;
+    }
+}
+
+/**
+ * @brief    USART1 DMA发送完成时调用，释放当前槽位并发送下一帧
+ */
+void Emm_V5_TxCpltCallback(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (tx_busy) {
+        if (tx_queue[tx_tail].ext != NULL) {
+            mmcl_tx_busy = false;
+        }
+        tx_tail = (tx_tail + 1) % EMM_V5_TX_QUEUE_LEN;
+        --tx_count;
+        ++tx_stats.sent;
+        tx_busy = false;
+    }
+    Emm_V5_TxQueue_Kick();
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief    获取发送队列统计信息
+ * @param    stats ：统计信息输出
+ */
+void Emm_V5_TxQueue_GetStats(Emm_V5_TxStats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = tx_stats;
+    stats->pending = tx_count;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief    清零发送队列统计信息
+ */
+void Emm_V5_TxQueue_ResetStats(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(&tx_stats, 0, sizeof(tx_stats));
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief    队列中等待发送（尚未开始发送）的帧数
+ */
+uint8_t Emm_V5_TxQueue_Waiting(void)
+{
+    uint8_t count = tx_count;
+    return (tx_busy && count > 0) ? count - 1 : count;
+}
+
+/**
+ * @brief    队列为空且DMA空闲
+ */
+bool Emm_V5_TxQueue_IsIdle(void)
+{
+    return tx_count == 0 && !tx_busy;
+}
+
+/**
+ * @brief    上一帧多电机命令是否仍未发送完成，此时调用Emm_V5_Multi_Motor_Cmd会被丢弃
+ */
+bool Emm_V5_MMCL_IsBusy(void)
+{
+    return mmcl_tx_busy;
+}
+
 /**********************************************************
 *** 触发动作命令
 **********************************************************/
@@ -21,7 +204,7 @@ __IO uint16_t MMCL_count = 0, MMCL_cmd[MMCL_LEN] = {0};
  */
 void Emm_V5_Trig_Encoder_Cal(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -30,7 +213,7 @@ void Emm_V5_Trig_Encoder_Cal(uint8_t addr)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**
@@ -40,7 +223,7 @@ void Emm_V5_Trig_Encoder_Cal(uint8_t addr)
  */
 void Emm_V5_Reset_Motor(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -49,7 +232,7 @@ void Emm_V5_Reset_Motor(uint8_t addr)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**
@@ -59,7 +242,7 @@ void Emm_V5_Reset_Motor(uint8_t addr)
  */
 void Emm_V5_Reset_CurPos_To_Zero(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -68,7 +251,7 @@ void Emm_V5_Reset_CurPos_To_Zero(uint8_t addr)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**
@@ -78,7 +261,7 @@ void Emm_V5_Reset_CurPos_To_Zero(uint8_t addr)
  */
 void Emm_V5_Reset_Clog_Pro(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -87,7 +270,7 @@ void Emm_V5_Reset_Clog_Pro(uint8_t addr)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**
@@ -97,7 +280,7 @@ void Emm_V5_Reset_Clog_Pro(uint8_t addr)
  */
 void Emm_V5_Restore_Motor(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -106,7 +289,7 @@ void Emm_V5_Restore_Motor(uint8_t addr)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**********************************************************
@@ -120,7 +303,14 @@ void Emm_V5_Restore_Motor(uint8_t addr)
 void Emm_V5_Multi_Motor_Cmd(uint8_t addr)
 {
     uint16_t i = 0, j = 0, len = 0;
-    __IO static uint8_t cmd[MMCL_LEN] = {0};
+    uint8_t *cmd = mmcl_tx_buf;
+
+    // 上一帧多电机命令仍在队列中，缓冲区不可覆盖
+    if (mmcl_tx_busy) {
+        ++tx_stats.dropped;
+        MMCL_count = 0;
+        return;
+    }
 
     // 多电机命令长度大于0
     if (MMCL_count > 0) {
@@ -139,7 +329,7 @@ void Emm_V5_Multi_Motor_Cmd(uint8_t addr)
         ++j;  // 校验字节
 
         // 发送命令
-        HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, j);
+        Emm_V5_Transmit_External(cmd, j);
         MMCL_count = 0;
     } else {
         MMCL_count = 0;
@@ -155,7 +345,7 @@ void Emm_V5_Multi_Motor_Cmd(uint8_t addr)
  */
 void Emm_V5_En_Control(uint8_t addr, bool state, bool snF)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;            // 地址
@@ -166,7 +356,7 @@ void Emm_V5_En_Control(uint8_t addr, bool state, bool snF)
     cmd[5] = 0x6B;            // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 6);
+    Emm_V5_Transmit(cmd, 6);
 }
 
 /**
@@ -180,7 +370,7 @@ void Emm_V5_En_Control(uint8_t addr, bool state, bool snF)
  */
 void Emm_V5_Vel_Control(uint8_t addr, uint8_t dir, uint16_t vel, uint8_t acc, bool snF)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;                 // 地址
@@ -193,7 +383,7 @@ void Emm_V5_Vel_Control(uint8_t addr, uint8_t dir, uint16_t vel, uint8_t acc, bo
     cmd[7] = 0x6B;                 // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 8);
+    Emm_V5_Transmit(cmd, 8);
 }
 
 /**
@@ -210,7 +400,7 @@ void Emm_V5_Vel_Control(uint8_t addr, uint8_t dir, uint16_t vel, uint8_t acc, bo
 void Emm_V5_Pos_Control(uint8_t addr, uint8_t dir, uint16_t vel, uint8_t acc, uint32_t clk,
                         bool raF, bool snF)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;                  // 地址
@@ -228,7 +418,7 @@ void Emm_V5_Pos_Control(uint8_t addr, uint8_t dir, uint16_t vel, uint8_t acc, ui
     cmd[12] = 0x6B;                 // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 13);
+    Emm_V5_Transmit(cmd, 13);
 }
 
 /**
@@ -239,7 +429,7 @@ void Emm_V5_Pos_Control(uint8_t addr, uint8_t dir, uint16_t vel, uint8_t acc, ui
  */
 void Emm_V5_Stop_Now(uint8_t addr, bool snF)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -249,7 +439,7 @@ void Emm_V5_Stop_Now(uint8_t addr, bool snF)
     cmd[4] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 5);
+    Emm_V5_Transmit(cmd, 5);
 }
 
 /**
@@ -259,7 +449,7 @@ void Emm_V5_Stop_Now(uint8_t addr, bool snF)
  */
 void Emm_V5_Synchronous_motion(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -268,7 +458,7 @@ void Emm_V5_Synchronous_motion(uint8_t addr)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**********************************************************
@@ -282,7 +472,7 @@ void Emm_V5_Synchronous_motion(uint8_t addr)
  */
 void Emm_V5_Origin_Set_O(uint8_t addr, bool svF)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -292,7 +482,7 @@ void Emm_V5_Origin_Set_O(uint8_t addr, bool svF)
     cmd[4] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 5);
+    Emm_V5_Transmit(cmd, 5);
 }
 
 /**
@@ -305,7 +495,7 @@ void Emm_V5_Origin_Set_O(uint8_t addr, bool svF)
  */
 void Emm_V5_Origin_Trigger_Return(uint8_t addr, uint8_t o_mode, bool snF)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -316,7 +506,7 @@ void Emm_V5_Origin_Trigger_Return(uint8_t addr, uint8_t o_mode, bool snF)
     cmd[4] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 5);
+    Emm_V5_Transmit(cmd, 5);
 }
 
 /**
@@ -326,7 +516,7 @@ void Emm_V5_Origin_Trigger_Return(uint8_t addr, uint8_t o_mode, bool snF)
  */
 void Emm_V5_Origin_Interrupt(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -335,7 +525,7 @@ void Emm_V5_Origin_Interrupt(uint8_t addr)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**
@@ -345,7 +535,7 @@ void Emm_V5_Origin_Interrupt(uint8_t addr)
  */
 void Emm_V5_Origin_Read_Params(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -353,7 +543,7 @@ void Emm_V5_Origin_Read_Params(uint8_t addr)
     cmd[2] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 3);
+    Emm_V5_Transmit(cmd, 3);
 }
 
 /**
@@ -375,7 +565,7 @@ void Emm_V5_Origin_Modify_Params(uint8_t addr, bool svF, uint8_t o_mode, uint8_t
                                  uint16_t o_vel, uint32_t o_tm, uint16_t sl_vel, uint16_t sl_ma,
                                  uint16_t sl_ms, bool potF)
 {
-    __IO static uint8_t cmd[32] = {0};
+    uint8_t cmd[32] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -401,7 +591,7 @@ void Emm_V5_Origin_Modify_Params(uint8_t addr, bool svF, uint8_t o_mode, uint8_t
     cmd[19] = 0x6B;                    // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 20);
+    Emm_V5_Transmit(cmd, 20);
 }
 
 /**********************************************************
@@ -417,7 +607,7 @@ void Emm_V5_Origin_Modify_Params(uint8_t addr, bool svF, uint8_t o_mode, uint8_t
 void Emm_V5_Auto_Return_Sys_Params_Timed(uint8_t addr, SysParams_t s, uint16_t time_ms)
 {
     uint8_t i = 0;
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[i] = addr;
@@ -516,7 +706,7 @@ void Emm_V5_Auto_Return_Sys_Params_Timed(uint8_t addr, SysParams_t s, uint16_t t
     ++i;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, i);
+    Emm_V5_Transmit(cmd, i);
 }
 
 /**
@@ -528,7 +718,7 @@ void Emm_V5_Auto_Return_Sys_Params_Timed(uint8_t addr, SysParams_t s, uint16_t t
 void Emm_V5_Read_Sys_Params(uint8_t addr, SysParams_t s)
 {
     uint8_t i = 0;
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[i] = addr;
@@ -616,7 +806,7 @@ void Emm_V5_Read_Sys_Params(uint8_t addr, SysParams_t s)
     ++i;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, i);
+    Emm_V5_Transmit(cmd, i);
 }
 
 /**********************************************************
@@ -631,7 +821,7 @@ void Emm_V5_Read_Sys_Params(uint8_t addr, SysParams_t s)
  */
 void Emm_V5_Modify_Motor_ID(uint8_t addr, bool svF, uint8_t id)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -642,7 +832,7 @@ void Emm_V5_Modify_Motor_ID(uint8_t addr, bool svF, uint8_t id)
     cmd[5] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 6);
+    Emm_V5_Transmit(cmd, 6);
 }
 
 /**
@@ -654,7 +844,7 @@ void Emm_V5_Modify_Motor_ID(uint8_t addr, bool svF, uint8_t id)
  */
 void Emm_V5_Modify_MicroStep(uint8_t addr, bool svF, uint8_t mstep)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;   // 地址
@@ -665,7 +855,7 @@ void Emm_V5_Modify_MicroStep(uint8_t addr, bool svF, uint8_t mstep)
     cmd[5] = 0x6B;   // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 6);
+    Emm_V5_Transmit(cmd, 6);
 }
 
 /**
@@ -676,7 +866,7 @@ void Emm_V5_Modify_MicroStep(uint8_t addr, bool svF, uint8_t mstep)
  */
 void Emm_V5_Modify_PDFlag(uint8_t addr, bool pdf)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -685,7 +875,7 @@ void Emm_V5_Modify_PDFlag(uint8_t addr, bool pdf)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**
@@ -695,7 +885,7 @@ void Emm_V5_Modify_PDFlag(uint8_t addr, bool pdf)
  */
 void Emm_V5_Read_Opt_Param_Sta(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -703,7 +893,7 @@ void Emm_V5_Read_Opt_Param_Sta(uint8_t addr)
     cmd[2] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 3);
+    Emm_V5_Transmit(cmd, 3);
 }
 
 /**
@@ -716,7 +906,7 @@ void Emm_V5_Read_Opt_Param_Sta(uint8_t addr)
  */
 void Emm_V5_Modify_Motor_Type(uint8_t addr, bool svF, bool mottype)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
     uint8_t MotType = 0;
 
     if (mottype) {
@@ -734,7 +924,7 @@ void Emm_V5_Modify_Motor_Type(uint8_t addr, bool svF, bool mottype)
     cmd[5] = 0x6B;     // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 6);
+    Emm_V5_Transmit(cmd, 6);
 }
 
 /**
@@ -746,7 +936,7 @@ void Emm_V5_Modify_Motor_Type(uint8_t addr, bool svF, bool mottype)
  */
 void Emm_V5_Modify_Firmware_Type(uint8_t addr, bool svF, bool fwtype)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;    // 地址
@@ -757,7 +947,7 @@ void Emm_V5_Modify_Firmware_Type(uint8_t addr, bool svF, bool fwtype)
     cmd[5] = 0x6B;    // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 6);
+    Emm_V5_Transmit(cmd, 6);
 }
 
 /**
@@ -769,7 +959,7 @@ void Emm_V5_Modify_Firmware_Type(uint8_t addr, bool svF, bool fwtype)
  */
 void Emm_V5_Modify_Ctrl_Mode(uint8_t addr, bool svF, bool ctrl_mode)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;       // 地址
@@ -780,7 +970,7 @@ void Emm_V5_Modify_Ctrl_Mode(uint8_t addr, bool svF, bool ctrl_mode)
     cmd[5] = 0x6B;       // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 6);
+    Emm_V5_Transmit(cmd, 6);
 }
 
 /**
@@ -793,7 +983,7 @@ void Emm_V5_Modify_Ctrl_Mode(uint8_t addr, bool svF, bool ctrl_mode)
  */
 void Emm_V5_Modify_Motor_Dir(uint8_t addr, bool svF, bool dir)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -804,7 +994,7 @@ void Emm_V5_Modify_Motor_Dir(uint8_t addr, bool svF, bool dir)
     cmd[5] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 6);
+    Emm_V5_Transmit(cmd, 6);
 }
 
 /**
@@ -817,7 +1007,7 @@ void Emm_V5_Modify_Motor_Dir(uint8_t addr, bool svF, bool dir)
  */
 void Emm_V5_Modify_Lock_Btn(uint8_t addr, bool svF, bool lock)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -828,7 +1018,7 @@ void Emm_V5_Modify_Lock_Btn(uint8_t addr, bool svF, bool lock)
     cmd[5] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 6);
+    Emm_V5_Transmit(cmd, 6);
 }
 
 /**
@@ -841,7 +1031,7 @@ void Emm_V5_Modify_Lock_Btn(uint8_t addr, bool svF, bool lock)
  */
 void Emm_V5_Modify_S_Vel(uint8_t addr, bool svF, bool s_vel)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;   // 地址
@@ -852,7 +1042,7 @@ void Emm_V5_Modify_S_Vel(uint8_t addr, bool svF, bool s_vel)
     cmd[5] = 0x6B;   // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 6);
+    Emm_V5_Transmit(cmd, 6);
 }
 
 /**
@@ -864,7 +1054,7 @@ void Emm_V5_Modify_S_Vel(uint8_t addr, bool svF, bool s_vel)
  */
 void Emm_V5_Modify_OM_mA(uint8_t addr, bool svF, uint16_t om_ma)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;                   // 地址
@@ -876,7 +1066,7 @@ void Emm_V5_Modify_OM_mA(uint8_t addr, bool svF, uint16_t om_ma)
     cmd[6] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 7);
+    Emm_V5_Transmit(cmd, 7);
 }
 
 /**
@@ -888,7 +1078,7 @@ void Emm_V5_Modify_OM_mA(uint8_t addr, bool svF, uint16_t om_ma)
  */
 void Emm_V5_Modify_FOC_mA(uint8_t addr, bool svF, uint16_t foc_mA)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;                    // 地址
@@ -900,7 +1090,7 @@ void Emm_V5_Modify_FOC_mA(uint8_t addr, bool svF, uint16_t foc_mA)
     cmd[6] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 7);
+    Emm_V5_Transmit(cmd, 7);
 }
 
 /**
@@ -910,7 +1100,7 @@ void Emm_V5_Modify_FOC_mA(uint8_t addr, bool svF, uint16_t foc_mA)
  */
 void Emm_V5_Read_PID_Params(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -918,7 +1108,7 @@ void Emm_V5_Read_PID_Params(uint8_t addr)
     cmd[2] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 3);
+    Emm_V5_Transmit(cmd, 3);
 }
 
 /**
@@ -932,7 +1122,7 @@ void Emm_V5_Read_PID_Params(uint8_t addr)
  */
 void Emm_V5_Modify_PID_Params(uint8_t addr, bool svF, uint32_t kp, uint32_t ki, uint32_t kd)
 {
-    __IO static uint8_t cmd[20] = {0};
+    uint8_t cmd[20] = {0};
 
     // 装载命令
     cmd[0] = addr;                 // 地址
@@ -954,7 +1144,7 @@ void Emm_V5_Modify_PID_Params(uint8_t addr, bool svF, uint32_t kp, uint32_t ki,
     cmd[16] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 17);
+    Emm_V5_Transmit(cmd, 17);
 }
 
 /**
@@ -964,7 +1154,7 @@ void Emm_V5_Modify_PID_Params(uint8_t addr, bool svF, uint32_t kp, uint32_t ki,
  */
 void Emm_V5_Read_DMX512_Params(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -973,7 +1163,7 @@ void Emm_V5_Read_DMX512_Params(uint8_t addr)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**
@@ -999,7 +1189,7 @@ void Emm_V5_Read_DMX512_Params(uint8_t addr)
 void Emm_V5_Modify_DMX512_Params(uint8_t addr, bool svF, uint16_t tch, uint8_t nch, uint8_t mode,
                                  uint16_t vel, uint16_t acc, uint16_t vel_step, uint32_t pos_step)
 {
-    __IO static uint8_t cmd[32] = {0};
+    uint8_t cmd[32] = {0};
 
     // 装载命令
     cmd[0] = addr;                 // 地址
@@ -1023,7 +1213,7 @@ void Emm_V5_Modify_DMX512_Params(uint8_t addr, bool svF, uint16_t tch, uint8_t n
     cmd[18] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 19);
+    Emm_V5_Transmit(cmd, 19);
 }
 
 /**
@@ -1033,7 +1223,7 @@ void Emm_V5_Modify_DMX512_Params(uint8_t addr, bool svF, uint16_t tch, uint8_t n
  */
 void Emm_V5_Read_Pos_Window(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -1041,7 +1231,7 @@ void Emm_V5_Read_Pos_Window(uint8_t addr)
     cmd[2] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 3);
+    Emm_V5_Transmit(cmd, 3);
 }
 
 /**
@@ -1053,7 +1243,7 @@ void Emm_V5_Read_Pos_Window(uint8_t addr)
  */
 void Emm_V5_Modify_Pos_Window(uint8_t addr, bool svF, uint16_t prw)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;                 // 地址
@@ -1065,7 +1255,7 @@ void Emm_V5_Modify_Pos_Window(uint8_t addr, bool svF, uint16_t prw)
     cmd[6] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 7);
+    Emm_V5_Transmit(cmd, 7);
 }
 
 /**
@@ -1075,7 +1265,7 @@ void Emm_V5_Modify_Pos_Window(uint8_t addr, bool svF, uint16_t prw)
  */
 void Emm_V5_Read_Otocp(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -1083,7 +1273,7 @@ void Emm_V5_Read_Otocp(uint8_t addr)
     cmd[2] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 3);
+    Emm_V5_Transmit(cmd, 3);
 }
 
 /**
@@ -1097,7 +1287,7 @@ void Emm_V5_Read_Otocp(uint8_t addr)
  */
 void Emm_V5_Modify_Otocp(uint8_t addr, bool svF, uint16_t otp, uint16_t ocp, uint16_t time_ms)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;                 // 地址
@@ -1113,7 +1303,7 @@ void Emm_V5_Modify_Otocp(uint8_t addr, bool svF, uint16_t otp, uint16_t ocp, uin
     cmd[10] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 11);
+    Emm_V5_Transmit(cmd, 11);
 }
 
 /**
@@ -1123,7 +1313,7 @@ void Emm_V5_Modify_Otocp(uint8_t addr, bool svF, uint16_t otp, uint16_t ocp, uin
  */
 void Emm_V5_Read_Heart_Protect(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -1131,7 +1321,7 @@ void Emm_V5_Read_Heart_Protect(uint8_t addr)
     cmd[2] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 3);
+    Emm_V5_Transmit(cmd, 3);
 }
 
 /**
@@ -1143,7 +1333,7 @@ void Emm_V5_Read_Heart_Protect(uint8_t addr)
  */
 void Emm_V5_Modify_Heart_Protect(uint8_t addr, bool svF, uint32_t hp)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;                 // 地址
@@ -1157,7 +1347,7 @@ void Emm_V5_Modify_Heart_Protect(uint8_t addr, bool svF, uint32_t hp)
     cmd[8] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 9);
+    Emm_V5_Transmit(cmd, 9);
 }
 
 /**
@@ -1167,7 +1357,7 @@ void Emm_V5_Modify_Heart_Protect(uint8_t addr, bool svF, uint32_t hp)
  */
 void Emm_V5_Read_Integral_Limit(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -1175,7 +1365,7 @@ void Emm_V5_Read_Integral_Limit(uint8_t addr)
     cmd[2] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 3);
+    Emm_V5_Transmit(cmd, 3);
 }
 
 /**
@@ -1187,7 +1377,7 @@ void Emm_V5_Read_Integral_Limit(uint8_t addr)
  */
 void Emm_V5_Modify_Integral_Limit(uint8_t addr, bool svF, uint32_t il)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;                 // 地址
@@ -1201,7 +1391,7 @@ void Emm_V5_Modify_Integral_Limit(uint8_t addr, bool svF, uint32_t il)
     cmd[8] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 9);
+    Emm_V5_Transmit(cmd, 9);
 }
 
 /**********************************************************
@@ -1214,7 +1404,7 @@ void Emm_V5_Modify_Integral_Limit(uint8_t addr, bool svF, uint32_t il)
  */
 void Emm_V5_Read_System_State_Params(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -1223,7 +1413,7 @@ void Emm_V5_Read_System_State_Params(uint8_t addr)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**
@@ -1233,7 +1423,7 @@ void Emm_V5_Read_System_State_Params(uint8_t addr)
  */
 void Emm_V5_Read_Motor_Conf_Params(uint8_t addr)
 {
-    __IO static uint8_t cmd[16] = {0};
+    uint8_t cmd[16] = {0};
 
     // 装载命令
     cmd[0] = addr;  // 地址
@@ -1242,7 +1432,7 @@ void Emm_V5_Read_Motor_Conf_Params(uint8_t addr)
     cmd[3] = 0x6B;  // 校验字节
 
     // 发送命令
-    HAL_UART_Transmit_DMA(&huart1, (uint8_t *)cmd, 4);
+    Emm_V5_Transmit(cmd, 4);
 }
 
 /**
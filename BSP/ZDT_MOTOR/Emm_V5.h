@@ -47,6 +47,18 @@ typedef enum {
 #define MMCL_LEN 512
 extern __IO uint16_t MMCL_count, MMCL_cmd[MMCL_LEN];
 
+#define EMM_V5_TX_QUEUE_LEN 16  // 发送队列槽位数
+#define EMM_V5_TX_FRAME_MAX 32  // 单条命令最大字节数（多电机命令除外）
+
+// 发送队列统计信息
+typedef struct {
+    uint32_t sent;       // 已发送完成的帧数
+    uint32_t overflow;   // 队列已满被丢弃的帧数
+    uint32_t dropped;    // 其他原因丢弃的帧数（超长、多电机缓冲区占用、DMA启动失败）
+    uint8_t pending;     // 当前队列中帧数（含正在发送的帧）
+    uint8_t high_water;  // 队列中帧数历史最大值
+} Emm_V5_TxStats_t;
+
 /**
 ***********************************************************
 ***********************************************************
@@ -196,4 +208,15 @@ void Emm_V5_MMCL_Read_Sys_Params(uint8_t addr, SysParams_t s);  // 读取系统
 *** 读写驱动参数命令
 **********************************************************/
 
+/**********************************************************
+*** 发送队列
+**********************************************************/
+
+void Emm_V5_TxCpltCallback(void);                         // USART1发送完成回调中调用
+void Emm_V5_TxQueue_GetStats(Emm_V5_TxStats_t *stats);  // 获取发送队列统计信息
+void Emm_V5_TxQueue_ResetStats(void);                   // 清零发送队列统计信息
+uint8_t Emm_V5_TxQueue_Waiting(void);                   // 等待发送的帧数（不含正在发送的帧）
+bool Emm_V5_TxQueue_IsIdle(void);                       // 队列为空且DMA空闲
+bool Emm_V5_MMCL_IsBusy(void);                          // 上一帧多电机命令是否仍未发送完成
+
 #endif
@@ -0,0 +1,381 @@
+#include "emm_feedback.h"
+
+#include <string.h>
+
+#define EMM_FB_FRAME_END 0x6B       // 帧尾（校验字节）
+#define EMM_FB_SYS_STATE_LEN 31     // 读取系统状态参数应答帧长度
+#define EMM_FB_FRAME_NEED_MORE 0    // 数据不足，等待更多数据
+#define EMM_FB_FRAME_INVALID (-1)   // 不是合法帧头
+
+// DMA循环接收缓冲区
+static uint8_t rx_buf[EMM_FB_RX_BUFFER_SIZE];
+// DMA已写入位置
+static volatile uint16_t rx_write = 0;
+// 尚未解析数据的起始位置
+static uint16_t rx_read = 0;
+
+// 每个电机的快照与历史样本，seq为奇数表示正在写入（顺序锁）
+typedef struct {
+    volatile uint32_t seq;
+    EmmFeedback_t data;
+    EmmFeedbackSample_t history[EMM_FB_HISTORY_LEN];  // 环形缓冲区
+    uint8_t history_head;                              // 下一个写入位置
+    uint8_t history_count;                             // 有效样本数
+} EmmFeedbackSlot_t;
+
+static EmmFeedbackSlot_t fb_slots[EMM_FB_MAX_ADDR];
+static EmmFeedbackStats_t fb_stats = {0};
+
+// 参与定时返回的云台电机
+static const uint8_t stream_addr[] = {STEP_MOTOR_X, STEP_MOTOR_Y};
+// 当前定时返回周期(ms)，0为关闭
+static uint16_t stream_period_ms = 0;
+
+/**
+ * @brief 读取未解析数据中第i个字节（原地读取DMA缓冲区，自动回绕）
+ */
+static uint8_t EmmFeedback_At(uint16_t i)
+{
+    i += rx_read;
+    if (i >= EMM_FB_RX_BUFFER_SIZE) {
+        i -= EMM_FB_RX_BUFFER_SIZE;
+    }
+    return rx_buf[i];
+}
+
+static uint16_t EmmFeedback_ReadU16(uint16_t i)
+{
+    return ((uint16_t)EmmFeedback_At(i) << 8) | EmmFeedback_At(i + 1);
+}
+
+static uint32_t EmmFeedback_ReadU32(uint16_t i)
+{
+    return ((uint32_t)EmmFeedback_At(i) << 24) | ((uint32_t)EmmFeedback_At(i + 1) << 16) |
+           ((uint32_t)EmmFeedback_At(i + 2) << 8) | EmmFeedback_At(i + 3);
+}
+
+/**
+ * @brief 读取"符号字节 + 4字节数值"格式的带符号数，符号字节为1表示负数
+ */
+static int32_t EmmFeedback_ReadSigned32(uint16_t i)
+{
+    int32_t value = (int32_t)EmmFeedback_ReadU32(i + 1);
+    return EmmFeedback_At(i) ? -value : value;
+}
+
+/**
+ * @brief 未解析数据的长度
+ */
+static uint16_t EmmFeedback_Available(void)
+{
+    uint16_t write = rx_write;
+    if (write >= rx_read) {
+        return write - rx_read;
+    }
+    return EMM_FB_RX_BUFFER_SIZE - rx_read + write;
+}
+
+/**
+ * @brief 根据功能码确定应答帧长度
+ * @param avail 当前可用数据长度
+ * @return 帧长度，EMM_FB_FRAME_NEED_MORE 数据不足，EMM_FB_FRAME_INVALID 非法帧
+ */
+static int16_t EmmFeedback_FrameLength(uint16_t avail)
+{
+    switch (EmmFeedback_At(1)) {
+        case 0x3A:  // 电机状态标志位
+        case 0x3B:  // 回零状态标志位
+        case 0x00:  // 错误命令应答
+        case 0x06:  // 以下为控制类命令应答：地址 + 功能码 + 状态 + 校验
+        case 0x08:
+        case 0x0A:
+        case 0x0E:
+        case 0x0F:
+        case 0x93:
+        case 0x9A:
+        case 0x9C:
+        case 0xF3:
+        case 0xF6:
+        case 0xFD:
+        case 0xFE:
+        case 0xFF:
+            return 4;
+        case 0x24:  // 总线电压
+            return 5;
+        case 0x35:  // 实时转速
+            return 6;
+        case 0x33:  // 目标位置
+        case 0x34:  // 实时设定的目标位置
+        case 0x36:  // 实时位置
+        case 0x37:  // 位置误差
+            return 8;
+        case 0x43:  // 系统状态参数，第3字节为总字节数
+            if (avail < 3) {
+                return EMM_FB_FRAME_NEED_MORE;
+            }
+            return (EmmFeedback_At(2) == EMM_FB_SYS_STATE_LEN) ? EMM_FB_SYS_STATE_LEN
+                                                               : EMM_FB_FRAME_INVALID;
+        default:
+            return EMM_FB_FRAME_INVALID;
+    }
+}
+
+/**
+ * @brief 解码一帧应答并写入对应电机的快照
+ */
+static void EmmFeedback_Decode(uint8_t addr)
+{
+    EmmFeedbackSlot_t *slot = &fb_slots[addr - 1];
+    EmmFeedback_t *fb = &slot->data;
+
+    slot->seq++;
+    __DMB();
+
+    switch (EmmFeedback_At(1)) {
+        case 0x24:
+            fb->vbus_mv = EmmFeedback_ReadU16(2);
+            fb->valid |= EMM_FB_VALID_VBUS;
+            break;
+        case 0x33:
+        case 0x34:
+            fb->target_pos = EmmFeedback_ReadSigned32(2);
+            fb->valid |= EMM_FB_VALID_TPOS;
+            break;
+        case 0x35: {
+            int16_t vel = (int16_t)EmmFeedback_ReadU16(3);
+            fb->velocity = EmmFeedback_At(2) ? -vel : vel;
+            fb->valid |= EMM_FB_VALID_VEL;
+            break;
+        }
+        case 0x36: {
+            fb->position = EmmFeedback_ReadSigned32(2);
+            fb->valid |= EMM_FB_VALID_POS;
+            // 位置样本存入该电机的历史环形缓冲区
+            EmmFeedbackSample_t *sample = &slot->history[slot->history_head];
+            sample->tick = HAL_GetTick();
+            sample->position = fb->position;
+            sample->velocity = fb->velocity;
+            slot->history_head = (slot->history_head + 1) % EMM_FB_HISTORY_LEN;
+            if (slot->history_count < EMM_FB_HISTORY_LEN) {
+                slot->history_count++;
+            }
+            break;
+        }
+        case 0x37:
+            fb->pos_error = EmmFeedback_ReadSigned32(2);
+            fb->valid |= EMM_FB_VALID_PERR;
+            break;
+        case 0x3A:
+            fb->flags = EmmFeedback_At(2);
+            fb->valid |= EMM_FB_VALID_FLAG;
+            break;
+        case 0x3B:
+            fb->origin_flags = EmmFeedback_At(2);
+            fb->valid |= EMM_FB_VALID_OFLAG;
+            break;
+        case 0x43: {
+            // 地址 + 0x43 + 字节数 + 参数个数 + 总线电压(2) + 相电流(2) + 编码器(2)
+            // + 目标位置(1+4) + 实时转速(1+2) + 实时位置(1+4) + 位置误差(1+4)
+            // + 回零状态标志 + 电机状态标志 + 校验
+            int16_t vel = (int16_t)EmmFeedback_ReadU16(16);
+            fb->vbus_mv = EmmFeedback_ReadU16(4);
+            fb->target_pos = EmmFeedback_ReadSigned32(10);
+            fb->velocity = EmmFeedback_At(15) ? -vel : vel;
+            fb->position = EmmFeedback_ReadSigned32(18);
+            fb->pos_error = EmmFeedback_ReadSigned32(23);
+            fb->origin_flags = EmmFeedback_At(28);
+            fb->flags = EmmFeedback_At(29);
+            fb->valid |= EMM_FB_VALID_VBUS | EMM_FB_VALID_TPOS | EMM_FB_VALID_VEL |
+                         EMM_FB_VALID_POS | EMM_FB_VALID_PERR | EMM_FB_VALID_OFLAG |
+                         EMM_FB_VALID_FLAG;
+            break;
+        }
+        default:
+            // 控制类命令应答
+            fb->last_ack = EmmFeedback_At(2);
+            break;
+    }
+    fb->update_tick = HAL_GetTick();
+
+    __DMB();
+    slot->seq++;
+}
+
+/**
+ * @brief 解析缓冲区中所有完整的应答帧
+ *        帧错误时只丢弃一个字节后重新同步
+ */
+static void EmmFeedback_Parse(void)
+{
+    while (1) {
+        uint16_t avail = EmmFeedback_Available();
+        if (avail < 2) {
+            return;
+        }
+
+        uint8_t addr = EmmFeedback_At(0);
+        int16_t len = EMM_FB_FRAME_INVALID;
+        if (addr >= 1 && addr <= EMM_FB_MAX_ADDR) {
+            len = EmmFeedback_FrameLength(avail);
+        }
+        if (len == EMM_FB_FRAME_NEED_MORE || (len > 0 && avail < (uint16_t)len)) {
+            return;
+        }
+        if (len == EMM_FB_FRAME_INVALID || EmmFeedback_At(len - 1) != EMM_FB_FRAME_END) {
+            // 非法帧，跳过一个字节重新同步
+            fb_stats.resync++;
+            len = 1;
+        } else {
+            EmmFeedback_Decode(addr);
+            fb_stats.frames++;
+        }
+
+        rx_read += len;
+        if (rx_read >= EMM_FB_RX_BUFFER_SIZE) {
+            rx_read -= EMM_FB_RX_BUFFER_SIZE;
+        }
+    }
+}
+
+/**
+ * @brief 启动USART1 DMA循环接收
+ */
+static void EmmFeedback_StartReceive(void)
+{
+    rx_read = 0;
+    rx_write = 0;
+    // 循环模式下保留DMA过半/完成中断，保证每半个缓冲区至少解析一次
+    HAL_UARTEx_ReceiveToIdle_DMA(&huart1, rx_buf, EMM_FB_RX_BUFFER_SIZE);
+}
+
+/**
+ * @brief 初始化应答接收，清空所有快照
+ */
+void EmmFeedback_Init(void)
+{
+    memset(fb_slots, 0, sizeof(fb_slots));
+    memset(&fb_stats, 0, sizeof(fb_stats));
+    stream_period_ms = 0;
+    EmmFeedback_StartReceive();
+}
+
+/**
+ * @brief 读取某电机最新的反馈快照（无锁，可在任意任务中调用）
+ * @param addr 电机地址
+ * @param fb 快照输出
+ * @return true 读取成功，false 地址无效或尚未收到该电机的应答
+ */
+bool EmmFeedback_Get(uint8_t addr, EmmFeedback_t *fb)
+{
+    if (fb == NULL || addr < 1 || addr > EMM_FB_MAX_ADDR) {
+        return false;
+    }
+
+    EmmFeedbackSlot_t *slot = &fb_slots[addr - 1];
+    uint32_t seq;
+    // 写入方在中断中，读取期间被打断则重读
+    do {
+        seq = slot->seq;
+        __DMB();
+        *fb = slot->data;
+        __DMB();
+    } while ((seq & 1U) || seq != slot->seq);
+
+    return fb->update_tick != 0 || fb->valid != 0;
+}
+
+/**
+ * @brief 开启X/Y轴定时返回实时位置和实时转速（Y42），替代逐次查询
+ *        周期与当前设置相同时不重发命令；只在需要反馈的任务运行期间开启，避免总线上常驻返回帧
+ * @param period_ms 返回周期(ms)
+ */
+void EmmFeedback_StartStreaming(uint16_t period_ms)
+{
+    if (period_ms == stream_period_ms) {
+        return;
+    }
+    stream_period_ms = period_ms;
+    for (uint8_t i = 0; i < sizeof(stream_addr); i++) {
+        Emm_V5_Auto_Return_Sys_Params_Timed(stream_addr[i], S_CPOS, period_ms);
+        Emm_V5_Auto_Return_Sys_Params_Timed(stream_addr[i], S_VEL, period_ms);
+    }
+}
+
+/**
+ * @brief 关闭X/Y轴定时返回（周期为0）
+ */
+void EmmFeedback_StopStreaming(void)
+{
+    EmmFeedback_StartStreaming(0);
+}
+
+/**
+ * @brief 读取某电机的定时返回历史样本（无锁）
+ * @param addr 电机地址
+ * @param samples 样本输出，最新的在前
+ * @param max 最多读取的样本数
+ * @return 实际读取的样本数
+ */
+uint8_t EmmFeedback_GetHistory(uint8_t addr, EmmFeedbackSample_t *samples, uint8_t max)
+{
+    if (samples == NULL || addr < 1 || addr > EMM_FB_MAX_ADDR) {
+        return 0;
+    }
+
+    EmmFeedbackSlot_t *slot = &fb_slots[addr - 1];
+    uint32_t seq;
+    uint8_t count;
+    do {
+        seq = slot->seq;
+        __DMB();
+        count = (slot->history_count < max) ? slot->history_count : max;
+        uint8_t idx = slot->history_head;
+        for (uint8_t i = 0; i < count; i++) {
+            idx = (idx == 0) ? EMM_FB_HISTORY_LEN - 1 : idx - 1;
+            samples[i] = slot->history[idx];
+        }
+        __DMB();
+    } while ((seq & 1U) || seq != slot->seq);
+
+    return count;
+}
+
+/**
+ * @brief 某电机的实时位置是否在max_age_ms内更新过
+ */
+bool EmmFeedback_IsFresh(uint8_t addr, uint32_t max_age_ms)
+{
+    EmmFeedbackSample_t sample;
+    if (EmmFeedback_GetHistory(addr, &sample, 1) == 0) {
+        return false;
+    }
+    return (HAL_GetTick() - sample.tick) <= max_age_ms;
+}
+
+/**
+ * @brief 获取接收统计信息
+ */
+void EmmFeedback_GetStats(EmmFeedbackStats_t *stats)
+{
+    if (stats != NULL) {
+        *stats = fb_stats;
+    }
+}
+
+/**
+ * @brief USART1接收事件回调（过半、完成、空闲），Size为DMA当前写入位置
+ */
+void EmmFeedback_RxEventCallback(uint16_t Size)
+{
+    rx_write = (Size >= EMM_FB_RX_BUFFER_SIZE) ? 0 : Size;
+    EmmFeedback_Parse();
+}
+
+/**
+ * @brief USART1接收错误（如溢出）后重新启动接收
+ */
+void EmmFeedback_ErrorCallback(void)
+{
+    fb_stats.rx_errors++;
+    EmmFeedback_StartReceive();
+}
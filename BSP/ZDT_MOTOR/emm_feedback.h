@@ -0,0 +1,81 @@
+/**
+ * @file emm_feedback.h
+ * @author Shiki
+ * @brief Emm_V5 应答帧接收与解析
+ *        USART1 DMA 循环接收 + 空闲中断，在 DMA 缓冲区中原地解析应答帧，
+ *        按电机地址发布最新的位置、速度、位置误差和状态标志。
+ *        定时返回模式下，X/Y轴主动上报的位置与速度按地址存入各自的历史环形缓冲区。
+ *        Remember to call EmmFeedback_Init() in user_init.c and
+ *        EmmFeedback_RxEventCallback() in HAL_UARTEx_RxEventCallback for USART1!!!
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __EMM_FEEDBACK_H
+#define __EMM_FEEDBACK_H
+
+#include "Emm_V5.h"
+
+#define EMM_FB_RX_BUFFER_SIZE 128  // DMA循环接收缓冲区大小
+#define EMM_FB_MAX_ADDR 4          // 支持的最大电机地址（地址1~EMM_FB_MAX_ADDR）
+#define EMM_FB_POS_PER_REV 65536   // 实时位置/位置误差每圈对应的数值
+#define EMM_FB_HISTORY_LEN 8       // 每个电机的定时返回历史样本数
+#define EMM_FB_STREAM_PERIOD_MS 30 // 默认定时返回周期(ms)，与追踪任务周期一致
+
+/* 电机状态标志位（S_FLAG） */
+#define EMM_FB_FLAG_ENABLED 0x01     // 使能状态
+#define EMM_FB_FLAG_IN_POSITION 0x02 // 电机到位
+#define EMM_FB_FLAG_STALL 0x04       // 电机堵转
+#define EMM_FB_FLAG_STALL_PROT 0x08  // 堵转保护
+
+/* 已更新字段标志 */
+#define EMM_FB_VALID_POS 0x01    // position有效
+#define EMM_FB_VALID_VEL 0x02    // velocity有效
+#define EMM_FB_VALID_PERR 0x04   // pos_error有效
+#define EMM_FB_VALID_TPOS 0x08   // target_pos有效
+#define EMM_FB_VALID_FLAG 0x10   // flags有效
+#define EMM_FB_VALID_OFLAG 0x20  // origin_flags有效
+#define EMM_FB_VALID_VBUS 0x40   // vbus_mv有效
+
+/* 单个电机的反馈快照 */
+typedef struct {
+    int32_t position;      // 实时位置（EMM_FB_POS_PER_REV为一圈）
+    int32_t target_pos;    // 目标位置
+    int32_t pos_error;     // 位置误差
+    int16_t velocity;      // 实时转速(RPM)，带符号
+    uint16_t vbus_mv;      // 总线电压(mV)
+    uint8_t flags;         // 电机状态标志位
+    uint8_t origin_flags;  // 回零状态标志位
+    uint8_t last_ack;      // 最近一次控制命令应答状态（0x02正确，0xE2条件不满足，0xEE错误）
+    uint8_t valid;         // 已更新过的字段
+    uint32_t update_tick;  // 最近一次更新时间(ms)
+} EmmFeedback_t;
+
+/* 定时返回的位置/速度样本 */
+typedef struct {
+    uint32_t tick;     // 收到位置的时间(ms)
+    int32_t position;  // 实时位置
+    int16_t velocity;  // 收到位置时最近一次的转速(RPM)
+} EmmFeedbackSample_t;
+
+/* 接收统计信息 */
+typedef struct {
+    uint32_t frames;     // 正确解析的帧数
+    uint32_t resync;     // 因帧错误丢弃的字节数
+    uint32_t rx_errors;  // UART接收错误次数
+} EmmFeedbackStats_t;
+
+void EmmFeedback_Init(void);
+bool EmmFeedback_Get(uint8_t addr, EmmFeedback_t *fb);  // 读取某电机的最新快照
+void EmmFeedback_GetStats(EmmFeedbackStats_t *stats);
+void EmmFeedback_StartStreaming(uint16_t period_ms);  // X/Y轴定时返回位置和速度（Y42）
+void EmmFeedback_StopStreaming(void);                 // 关闭定时返回
+uint8_t EmmFeedback_GetHistory(uint8_t addr, EmmFeedbackSample_t *samples,
+                               uint8_t max);  // 读取历史样本，最新的在前
+bool EmmFeedback_IsFresh(uint8_t addr, uint32_t max_age_ms);  // 位置是否在max_age_ms内更新过
+void EmmFeedback_RxEventCallback(uint16_t Size);  // USART1接收事件回调中调用
+void EmmFeedback_ErrorCallback(void);             // USART1错误回调中调用
+
+#endif
@@ -0,0 +1,355 @@
+#include "gimbal_motion.h"
+
+#include <string.h>
+
+#include "target_predictor.h"
+#include "trajectory.h"
+
+// 待发送命令类型
+typedef enum {
+    GIMBAL_CMD_NONE = 0,
+    GIMBAL_CMD_POS,
+    GIMBAL_CMD_VEL,
+    GIMBAL_CMD_STOP
+} GimbalCmdType_t;
+
+// 每个轴的待发送命令（邮箱）
+typedef struct {
+    GimbalCmdType_t type;  // 命令类型，GIMBAL_CMD_NONE表示无待发送命令
+    uint8_t dir;           // 方向
+    uint16_t vel;          // 速度(RPM)
+    uint8_t acc;           // 加速度
+    uint32_t clk;          // 脉冲数（速度模式不使用）
+    bool raF;              // 相对/绝对标志
+    bool snF;              // 多机同步标志
+} GimbalCmd_t;
+
+// 轴地址表，顺序即轮询发送顺序
+static const uint8_t axis_addr[GIMBAL_AXIS_COUNT] = {STEP_MOTOR_X, STEP_MOTOR_Y};
+// 各轴邮箱
+static volatile GimbalCmd_t axis_cmd[GIMBAL_AXIS_COUNT];
+// 双轴同步命令邮箱，优先于各轴邮箱发送
+static volatile GimbalCmd_t pair_cmd[GIMBAL_AXIS_COUNT];
+static volatile bool pair_pending = false;
+// 下一次轮询起始轴
+static uint8_t next_axis = 0;
+// 已放入发送队列的命令数（一组双轴同步命令计为1），被覆盖的命令不计
+static volatile uint32_t sent_count = 0;
+
+/**
+ * @brief 根据电机地址查找轴索引
+ * @return 轴索引，找不到返回GIMBAL_AXIS_COUNT
+ */
+static uint8_t GimbalMotion_AxisIndex(uint8_t addr)
+{
+    for (uint8_t i = 0; i < GIMBAL_AXIS_COUNT; i++) {
+        if (axis_addr[i] == addr) {
+            return i;
+        }
+    }
+    return GIMBAL_AXIS_COUNT;
+}
+
+/**
+ * @brief 未发出的双轴同步命令拆回各轴邮箱（去掉同步标志），调用者需关中断
+ *        单轴命令到来时调用，保证新命令覆盖旧命令而另一轴的运动不丢失
+ */
+static void GimbalMotion_SplitPair(void)
+{
+    if (!pair_pending) {
+        return;
+    }
+    for (uint8_t i = 0; i < GIMBAL_AXIS_COUNT; i++) {
+        if (pair_cmd[i].type != GIMBAL_CMD_NONE) {
+            axis_cmd[i] = pair_cmd[i];
+            axis_cmd[i].snF = false;
+        }
+    }
+    pair_pending = false;
+}
+
+/**
+ * @brief 位置命令发出时记录到目标预测器，外推视觉坐标时计入云台自身的转动，调用者需关中断
+ *        绝对值运动的位移取决于当前位置，无法换算，不记录
+ * @param cmd 各轴命令，类型不是位置模式的轴不动
+ */
+static void GimbalMotion_RecordMotion(const volatile GimbalCmd_t cmd[GIMBAL_AXIS_COUNT])
+{
+    PredictorMotion_t motion = {.start_tick = HAL_GetTick()};
+    bool moving = false;
+    for (uint8_t i = 0; i < GIMBAL_AXIS_COUNT; i++) {
+        if (cmd[i].type != GIMBAL_CMD_POS || cmd[i].raF || cmd[i].clk == 0) {
+            continue;
+        }
+        // 预测器按X、Y轴顺序记录
+        uint8_t axis = (axis_addr[i] == STEP_MOTOR_X) ? 0 : 1;
+        uint32_t ramp_ms;
+        uint32_t ms = Trajectory_MoveTimeMs(cmd[i].clk, cmd[i].vel, cmd[i].acc, &ramp_ms);
+        motion.clk[axis] = (cmd[i].dir != DIR_CW) ? (int32_t)cmd[i].clk : -(int32_t)cmd[i].clk;
+        motion.duration_ms[axis] = (ms > UINT16_MAX) ? UINT16_MAX : (uint16_t)ms;
+        motion.ramp_ms[axis] = (ramp_ms > motion.duration_ms[axis]) ? motion.duration_ms[axis]
+                                                                    : (uint16_t)ramp_ms;
+        moving = true;
+    }
+    if (moving) {
+        Predictor_AddMotion(&g_target_predictor, &motion);
+    }
+}
+
+/**
+ * @brief 发送双轴同步命令：各轴带同步标志的位置命令 + 多机同步触发，调用者需关中断
+ * @return true 已放入发送队列，false 多电机缓冲区占用，等待下次发送完成再试
+ */
+static bool GimbalMotion_SendPair(void)
+{
+#if GIMBAL_MOTION_USE_MMCL
+    if (Emm_V5_MMCL_IsBusy()) {
+        return false;
+    }
+    MMCL_count = 0;
+    for (uint8_t i = 0; i < GIMBAL_AXIS_COUNT; i++) {
+        if (pair_cmd[i].type == GIMBAL_CMD_POS) {
+            Emm_V5_MMCL_Pos_Control(axis_addr[i], pair_cmd[i].dir, pair_cmd[i].vel,
+                                    pair_cmd[i].acc, pair_cmd[i].clk, pair_cmd[i].raF, true);
+        }
+    }
+    Emm_V5_Multi_Motor_Cmd(0);
+#else
+    for (uint8_t i = 0; i < GIMBAL_AXIS_COUNT; i++) {
+        if (pair_cmd[i].type == GIMBAL_CMD_POS) {
+            Emm_V5_Pos_Control(axis_addr[i], pair_cmd[i].dir, pair_cmd[i].vel, pair_cmd[i].acc,
+                               pair_cmd[i].clk, pair_cmd[i].raF, true);
+        }
+    }
+#endif
+    Emm_V5_Synchronous_motion(0);
+    GimbalMotion_RecordMotion(pair_cmd);
+    pair_pending = false;
+    return true;
+}
+
+/**
+ * @brief 若Emm_V5发送队列中没有等待的帧，按轮询顺序放入下一条待发送命令
+ *        同一时刻最多只有一条云台命令（或一组双轴同步命令）在队列中等待，保证新命令可以覆盖旧命令
+ *        主循环与发送完成中断都会调用，内部关中断保护
+ */
+static void GimbalMotion_Kick(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (Emm_V5_TxQueue_Waiting() == 0) {
+        // 双轴同步命令优先
+        if (pair_pending) {
+            if (GimbalMotion_SendPair()) {
+                sent_count++;
+            }
+        } else {
+            for (uint8_t n = 0; n < GIMBAL_AXIS_COUNT; n++) {
+                uint8_t i = (next_axis + n) % GIMBAL_AXIS_COUNT;
+                if (axis_cmd[i].type == GIMBAL_CMD_NONE) {
+                    continue;
+                }
+                GimbalCmd_t cmd = axis_cmd[i];
+                axis_cmd[i].type = GIMBAL_CMD_NONE;
+                next_axis = (i + 1) % GIMBAL_AXIS_COUNT;
+
+                if (cmd.type == GIMBAL_CMD_POS) {
+                    Emm_V5_Pos_Control(axis_addr[i], cmd.dir, cmd.vel, cmd.acc, cmd.clk, cmd.raF,
+                                       cmd.snF);
+                    GimbalCmd_t single[GIMBAL_AXIS_COUNT] = {0};
+                    single[i] = cmd;
+                    GimbalMotion_RecordMotion(single);
+                } else if (cmd.type == GIMBAL_CMD_VEL) {
+                    Emm_V5_Vel_Control(axis_addr[i], cmd.dir, cmd.vel, cmd.acc, cmd.snF);
+                } else {
+                    Emm_V5_Stop_Now(axis_addr[i], cmd.snF);
+                }
+                sent_count++;
+                break;
+            }
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 初始化云台运动接口，清空所有待发送命令
+ */
+void GimbalMotion_Init(void)
+{
+    memset((void *)axis_cmd, 0, sizeof(axis_cmd));
+    memset((void *)pair_cmd, 0, sizeof(pair_cmd));
+    pair_pending = false;
+    next_axis = 0;
+}
+
+/**
+ * @brief 非阻塞位置模式控制，同一轴未发出的旧命令会被覆盖
+ * @param addr 电机地址
+ * @param dir 方向，0为CW，其余值为CCW
+ * @param vel 速度(RPM)
+ * @param acc 加速度，0是直接启动
+ * @param clk 脉冲数
+ * @param raF 相位/绝对标志，false为相对运动，true为绝对值运动
+ * @param snF 多机同步标志
+ * @return true 命令已接收，false 地址不属于云台轴
+ */
+bool GimbalMotion_PosControl(uint8_t addr, uint8_t dir, uint16_t vel, uint8_t acc, uint32_t clk,
+                             bool raF, bool snF)
+{
+    uint8_t i = GimbalMotion_AxisIndex(addr);
+    if (i >= GIMBAL_AXIS_COUNT) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    GimbalMotion_SplitPair();
+    axis_cmd[i].dir = dir;
+    axis_cmd[i].vel = vel;
+    axis_cmd[i].acc = acc;
+    axis_cmd[i].clk = clk;
+    axis_cmd[i].raF = raF;
+    axis_cmd[i].snF = snF;
+    axis_cmd[i].type = GIMBAL_CMD_POS;
+    __set_PRIMASK(primask);
+
+    GimbalMotion_Kick();
+    return true;
+}
+
+/**
+ * @brief 非阻塞速度模式控制，同一轴未发出的旧命令会被覆盖
+ * @param addr 电机地址
+ * @param dir 方向，0为CW，其余值为CCW
+ * @param vel 速度(RPM)，0为按加速度减速停止
+ * @param acc 加速度，0是直接启动
+ * @param snF 多机同步标志
+ * @return true 命令已接收，false 地址不属于云台轴
+ */
+bool GimbalMotion_VelControl(uint8_t addr, uint8_t dir, uint16_t vel, uint8_t acc, bool snF)
+{
+    uint8_t i = GimbalMotion_AxisIndex(addr);
+    if (i >= GIMBAL_AXIS_COUNT) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    GimbalMotion_SplitPair();
+    axis_cmd[i].dir = dir;
+    axis_cmd[i].vel = vel;
+    axis_cmd[i].acc = acc;
+    axis_cmd[i].snF = snF;
+    axis_cmd[i].type = GIMBAL_CMD_VEL;
+    __set_PRIMASK(primask);
+
+    GimbalMotion_Kick();
+    return true;
+}
+
+/**
+ * @brief 非阻塞立即停止，覆盖该轴未发出的运动命令
+ * @param addr 电机地址
+ * @param snF 多机同步标志
+ * @return true 命令已接收，false 地址不属于云台轴
+ */
+bool GimbalMotion_StopNow(uint8_t addr, bool snF)
+{
+    uint8_t i = GimbalMotion_AxisIndex(addr);
+    if (i >= GIMBAL_AXIS_COUNT) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    GimbalMotion_SplitPair();
+    axis_cmd[i].snF = snF;
+    axis_cmd[i].type = GIMBAL_CMD_STOP;
+    __set_PRIMASK(primask);
+
+    GimbalMotion_Kick();
+    return true;
+}
+
+/**
+ * @brief 非阻塞双轴同步位置控制，X/Y命令在同一次总线传输中发出后触发多机同步，两轴同时启动
+ *        覆盖两轴所有未发出的命令；相对运动时只有一个轴需要运动则按单轴命令发送，
+ *        绝对值运动的脉冲数0是有效目标（回到零点），两轴总是同步发送
+ * @param dir_x X轴方向
+ * @param clk_x X轴脉冲数，相对运动时0表示X轴不动
+ * @param dir_y Y轴方向
+ * @param clk_y Y轴脉冲数，相对运动时0表示Y轴不动
+ * @param vel 速度(RPM)
+ * @param acc 加速度，0是直接启动
+ * @param raF 相位/绝对标志，false为相对运动，true为绝对值运动
+ * @return true 命令已接收，false 相对运动且两轴脉冲数均为0
+ */
+bool GimbalMotion_MoveXY(uint8_t dir_x, uint32_t clk_x, uint8_t dir_y, uint32_t clk_y,
+                         uint16_t vel, uint8_t acc, bool raF)
+{
+    if (!raF) {
+        if (clk_x == 0 && clk_y == 0) {
+            return false;
+        }
+        if (clk_y == 0) {
+            return GimbalMotion_PosControl(STEP_MOTOR_X, dir_x, vel, acc, clk_x, raF, false);
+        }
+        if (clk_x == 0) {
+            return GimbalMotion_PosControl(STEP_MOTOR_Y, dir_y, vel, acc, clk_y, raF, false);
+        }
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint8_t i = 0; i < GIMBAL_AXIS_COUNT; i++) {
+        bool is_x = (axis_addr[i] == STEP_MOTOR_X);
+        axis_cmd[i].type = GIMBAL_CMD_NONE;
+        pair_cmd[i].dir = is_x ? dir_x : dir_y;
+        pair_cmd[i].clk = is_x ? clk_x : clk_y;
+        pair_cmd[i].vel = vel;
+        pair_cmd[i].acc = acc;
+        pair_cmd[i].raF = raF;
+        pair_cmd[i].snF = true;
+        pair_cmd[i].type = GIMBAL_CMD_POS;
+    }
+    pair_pending = true;
+    __set_PRIMASK(primask);
+
+    GimbalMotion_Kick();
+    return true;
+}
+
+/**
+ * @brief 所有轴的命令是否均已发出且Emm_V5发送队列已清空
+ */
+bool GimbalMotion_IsIdle(void)
+{
+    if (pair_pending) {
+        return false;
+    }
+    for (uint8_t i = 0; i < GIMBAL_AXIS_COUNT; i++) {
+        if (axis_cmd[i].type != GIMBAL_CMD_NONE) {
+            return false;
+        }
+    }
+    return Emm_V5_TxQueue_IsIdle();
+}
+
+/**
+ * @brief 已放入发送队列的命令数（一组双轴同步命令计为1），用于统计追踪过程的总线负载
+ */
+uint32_t GimbalMotion_GetSentCount(void)
+{
+    return sent_count;
+}
+
+/**
+ * @brief USART1 DMA发送完成时调用（在Emm_V5_TxCpltCallback之后），放入下一条待发送命令
+ */
+void GimbalMotion_TxCpltCallback(void)
+{
+    GimbalMotion_Kick();
+}
@@ -0,0 +1,41 @@
+/**
+ * @file gimbal_motion.h
+ * @author Shiki
+ * @brief 云台非阻塞运动接口，基于Emm_V5驱动
+ *        每个轴保留一条待发送命令（新命令覆盖旧命令），调用后立即返回，
+ *        命令经Emm_V5发送队列由USART1 DMA发送完成中断依次发出，无需在命令之间HAL_Delay。
+ *        GimbalMotion_MoveXY将X/Y两轴命令打包为一帧多电机命令并触发多机同步，两轴同时启动。
+ *        相对位置命令发出时记录到目标预测器（Predictor_AddMotion），外推视觉坐标时计入云台自身的转动。
+ *        Remember to call GimbalMotion_TxCpltCallback() in HAL_UART_TxCpltCallback for USART1!!!
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __GIMBAL_MOTION_H
+#define __GIMBAL_MOTION_H
+
+#include "Emm_V5.h"
+
+/* 云台轴数量（X轴、Y轴） */
+#define GIMBAL_AXIS_COUNT 2
+
+/* 双轴同步运动方式：1为多电机命令一帧发出（Y42），0为逐轴发送带同步标志的命令（X42） */
+#ifndef GIMBAL_MOTION_USE_MMCL
+#define GIMBAL_MOTION_USE_MMCL 1
+#endif
+
+void GimbalMotion_Init(void);
+bool GimbalMotion_PosControl(uint8_t addr, uint8_t dir, uint16_t vel, uint8_t acc, uint32_t clk,
+                             bool raF, bool snF);  // 非阻塞位置模式控制
+bool GimbalMotion_VelControl(uint8_t addr, uint8_t dir, uint16_t vel, uint8_t acc,
+                             bool snF);                 // 非阻塞速度模式控制
+bool GimbalMotion_StopNow(uint8_t addr, bool snF);  // 非阻塞立即停止
+bool GimbalMotion_MoveXY(uint8_t dir_x, uint32_t clk_x, uint8_t dir_y, uint32_t clk_y,
+                         uint16_t vel, uint8_t acc, bool raF);  // 非阻塞双轴同步位置控制
+bool GimbalMotion_IsIdle(void);                     // 所有命令是否已发送完成
+uint32_t GimbalMotion_GetSentCount(void);           // 已发出的命令数
+void GimbalMotion_TxCpltCallback(void);             // USART1发送完成回调中调用
+
+#endif
@@ -0,0 +1,181 @@
+#include "trajectory.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "gimbal_motion.h"
+
+/**
+ * @brief 加速度(RPM/s)转换为不超过它的最大加速度档位
+ *        档位acc对应20000/(256-acc) RPM/s，0为直接启动，不使用；
+ *        调用者保证acc_rpm_s不小于TRAJ_ACC_RPM_S_MIN，档位1的下限只防止浮点舍入
+ */
+static uint8_t Trajectory_AccLevel(float acc_rpm_s)
+{
+    if (acc_rpm_s >= (float)TRAJ_ACC_RPM_S_MAX) {
+        return 255;
+    }
+    float level = 256.0f - ceilf((float)TRAJ_ACC_RPM_S_MAX / acc_rpm_s);
+    if (level < 1.0f) {
+        return 1;
+    }
+    return (uint8_t)level;
+}
+
+/**
+ * @brief 规划一次转动
+ * @param traj 规划结果
+ * @param clk 转动脉冲数
+ * @param max_vel 最大速度(RPM)
+ * @param max_acc_rpm_s 最大加速度(RPM/s)，不小于TRAJ_ACC_RPM_S_MIN
+ * @return true 规划成功，false 参数无效（加速度小于档位1，驱动器无法执行更慢的加速）
+ */
+bool Trajectory_Plan(Trajectory_t *traj, uint32_t clk, uint16_t max_vel, float max_acc_rpm_s)
+{
+    if (traj == NULL || clk == 0 || max_vel == 0 || max_acc_rpm_s < TRAJ_ACC_RPM_S_MIN) {
+        return false;
+    }
+
+    memset(traj, 0, sizeof(Trajectory_t));
+    traj->clk = clk;
+    traj->acc = Trajectory_AccLevel(max_acc_rpm_s);
+    traj->acc_rpm_s = (float)TRAJ_ACC_RPM_S_MAX / (float)(256 - traj->acc);
+
+    // 以圈、秒为单位计算
+    float distance = (float)clk / (float)TRAJ_PULSES_PER_REV;
+    float acc = traj->acc_rpm_s / 60.0f;
+    float vel = (float)max_vel / 60.0f;
+
+    if (distance < vel * vel / acc) {
+        // 距离不足以加速到最大速度：三角形速度曲线
+        float peak = sqrtf(distance * acc);
+        traj->t_acc = peak / acc;
+        traj->t_cruise = 0.0f;
+        traj->peak_rpm = peak * 60.0f;
+        traj->vel = (uint16_t)ceilf(traj->peak_rpm);
+    } else {
+        traj->t_acc = vel / acc;
+        traj->t_cruise = (distance - vel * vel / acc) / vel;
+        traj->peak_rpm = (float)max_vel;
+        traj->vel = max_vel;
+    }
+
+    traj->duration_ms =
+        (uint32_t)((2.0f * traj->t_acc + traj->t_cruise) * 1000.0f + 0.5f) + TRAJ_SETTLE_MS;
+    return true;
+}
+
+/**
+ * @brief 按给定速度、加速度档位执行一条位置命令所需的时间（不含TRAJ_SETTLE_MS）
+ * @param clk 转动脉冲数
+ * @param vel 速度(RPM)
+ * @param acc 加速度档位，0为直接启动
+ * @param ramp_ms 加速段（等于减速段）时间输出(ms)，可为NULL
+ * @return 预计时间(ms)，脉冲数或速度为0时返回0
+ */
+uint32_t Trajectory_MoveTimeMs(uint32_t clk, uint16_t vel, uint8_t acc, uint32_t *ramp_ms)
+{
+    float t = 0.0f, t_acc = 0.0f;
+
+    if (clk != 0 && vel != 0) {
+        // 以圈、秒为单位计算
+        float distance = (float)clk / (float)TRAJ_PULSES_PER_REV;
+        float v = (float)vel / 60.0f;
+        if (acc == 0) {
+            t = distance / v;
+        } else {
+            float a = (float)TRAJ_ACC_RPM_S_MAX / (float)(256 - acc) / 60.0f;
+            if (distance < v * v / a) {
+                // 三角形速度曲线
+                t_acc = sqrtf(distance / a);
+                t = 2.0f * t_acc;
+            } else {
+                t_acc = v / a;
+                t = t_acc + distance / v;
+            }
+        }
+    }
+
+    if (ramp_ms != NULL) {
+        *ramp_ms = (uint32_t)(t_acc * 1000.0f + 0.5f);
+    }
+    return (uint32_t)(t * 1000.0f + 0.5f);
+}
+
+/**
+ * @brief 下发规划好的转动（非阻塞）
+ * @param traj 规划结果
+ * @param addr 电机地址
+ * @param dir 方向
+ * @param tick 当前时刻(ms)
+ * @return true 命令已提交，false 未规划或提交失败
+ */
+bool Trajectory_Start(Trajectory_t *traj, uint8_t addr, uint8_t dir, uint32_t tick)
+{
+    if (traj == NULL || traj->clk == 0) {
+        return false;
+    }
+    if (!GimbalMotion_PosControl(addr, dir, traj->vel, traj->acc, traj->clk, false, false)) {
+        return false;
+    }
+    traj->start_tick = tick;
+    traj->active = true;
+    return true;
+}
+
+/**
+ * @brief 按规划计算预计已转过的脉冲数
+ */
+float Trajectory_GetPosition(const Trajectory_t *traj, uint32_t tick)
+{
+    if (traj == NULL || !traj->active) {
+        return 0.0f;
+    }
+
+    float t = (float)(tick - traj->start_tick) * 0.001f;
+    float acc = traj->acc_rpm_s / 60.0f;
+    float peak = traj->peak_rpm / 60.0f;
+    float t_dec = traj->t_acc + traj->t_cruise;
+    float revs;
+
+    if (t <= traj->t_acc) {
+        revs = 0.5f * acc * t * t;
+    } else if (t <= t_dec) {
+        revs = 0.5f * peak * traj->t_acc + peak * (t - traj->t_acc);
+    } else if (t <= t_dec + traj->t_acc) {
+        float td = t - t_dec;
+        revs = 0.5f * peak * traj->t_acc + peak * traj->t_cruise + peak * td - 0.5f * acc * td * td;
+    } else {
+        return (float)traj->clk;
+    }
+
+    float position = revs * (float)TRAJ_PULSES_PER_REV;
+    return (position < (float)traj->clk) ? position : (float)traj->clk;
+}
+
+/**
+ * @brief 预计剩余时间(ms)，未执行时返回0
+ */
+uint32_t Trajectory_GetEta(const Trajectory_t *traj, uint32_t tick)
+{
+    if (traj == NULL || !traj->active) {
+        return 0;
+    }
+    uint32_t elapsed = tick - traj->start_tick;
+    return (elapsed < traj->duration_ms) ? traj->duration_ms - elapsed : 0;
+}
+
+/**
+ * @brief 转动是否已完成（按预计时间判断），完成后清除执行标志
+ */
+bool Trajectory_IsDone(Trajectory_t *traj, uint32_t tick)
+{
+    if (traj == NULL || !traj->active) {
+        return true;
+    }
+    if (tick - traj->start_tick >= traj->duration_ms) {
+        traj->active = false;
+        return true;
+    }
+    return false;
+}
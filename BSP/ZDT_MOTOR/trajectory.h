@@ -0,0 +1,47 @@
+/**
+ * @file trajectory.h
+ * @author Shiki
+ * @brief 大角度转动的梯形速度规划
+ *        Emm_V5位置模式由驱动器按加速度档位执行梯形加减速（加速时每(256-acc)*50us速度增加1RPM，
+ *        即加速度为20000/(256-acc) RPM/s），本模块根据云台最大速度、最大加速度选择时间最短的
+ *        速度和加速度档位（距离不足时为三角形速度曲线），一条位置命令下发，并给出预计完成时间，
+ *        转动结束后再交给视觉精调，避免精调命令打断转动。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __TRAJECTORY_H
+#define __TRAJECTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TRAJ_PULSES_PER_REV 3200  // 每圈脉冲数（16细分）
+#define TRAJ_ACC_RPM_S_MAX 20000  // 加速度档位255对应的加速度(RPM/s)
+#define TRAJ_ACC_RPM_S_MIN (TRAJ_ACC_RPM_S_MAX / 255.0f)  // 加速度档位1对应的加速度(约78RPM/s)
+#define TRAJ_SETTLE_MS 30         // 计算时间之外的余量（命令发送、定位稳定）
+
+typedef struct {
+    uint32_t clk;          // 总脉冲数
+    uint16_t vel;          // 下发的速度(RPM)
+    uint8_t acc;           // 下发的加速度档位
+    float acc_rpm_s;       // 实际加速度(RPM/s)
+    float peak_rpm;        // 峰值速度(RPM)，三角形曲线时小于vel
+    float t_acc;           // 加速段（等于减速段）时间(s)
+    float t_cruise;        // 匀速段时间(s)
+    uint32_t duration_ms;  // 预计总时间(ms)，含TRAJ_SETTLE_MS
+    uint32_t start_tick;   // 开始时刻(ms)
+    bool active;           // 是否正在执行
+} Trajectory_t;
+
+bool Trajectory_Plan(Trajectory_t *traj, uint32_t clk, uint16_t max_vel, float max_acc_rpm_s);
+uint32_t Trajectory_MoveTimeMs(uint32_t clk, uint16_t vel, uint8_t acc,
+                               uint32_t *ramp_ms);  // 一条位置命令的执行时间(ms)
+bool Trajectory_Start(Trajectory_t *traj, uint8_t addr, uint8_t dir, uint32_t tick);
+float Trajectory_GetPosition(const Trajectory_t *traj, uint32_t tick);  // 预计已转过的脉冲数
+uint32_t Trajectory_GetEta(const Trajectory_t *traj, uint32_t tick);    // 预计剩余时间(ms)
+bool Trajectory_IsDone(Trajectory_t *traj, uint32_t tick);
+
+#endif
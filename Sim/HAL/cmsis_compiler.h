@@ -0,0 +1,156 @@
+/**
+ * @file cmsis_compiler.h
+ * @author Shiki
+ * @brief 主机仿真用的CMSIS编译器适配层，替换Drivers/CMSIS/Include中的同名文件
+ *        提供CMSIS-DSP和BSP用到的关键字宏、PRIMASK读写和__CLZ/__SSAT等指令的C实现。
+ *        PRIMASK只是一个变量：虚拟时间只在主循环中推进，"中断"不会打断临界区。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __CMSIS_COMPILER_H
+#define __CMSIS_COMPILER_H
+
+#include <stdint.h>
+
+#ifndef __ASM
+#define __ASM __asm__
+#endif
+#ifndef __INLINE
+#define __INLINE inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE static inline __attribute__((always_inline))
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+#define __USED __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_STRUCT
+#define __PACKED_STRUCT struct __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#endif
+#ifndef __I
+#define __I volatile const
+#endif
+#ifndef __O
+#define __O volatile
+#endif
+#ifndef __IO
+#define __IO volatile
+#endif
+#ifndef __RESTRICT
+#define __RESTRICT __restrict
+#endif
+
+// 中断屏蔽状态，由fake_hal.c定义
+extern volatile uint32_t FakeHal_Primask;
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void)
+{
+    return FakeHal_Primask;
+}
+
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t primask)
+{
+    FakeHal_Primask = primask & 1U;
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void)
+{
+    FakeHal_Primask = 1U;
+}
+
+__STATIC_FORCEINLINE void __enable_irq(void)
+{
+    FakeHal_Primask = 0U;
+}
+
+__STATIC_FORCEINLINE void __DMB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __DSB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __ISB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __NOP(void)
+{
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+    return (value == 0U) ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value)
+{
+    uint32_t result = 0;
+    for (uint8_t i = 0; i < 32U; i++) {
+        result = (result << 1) | (value & 1U);
+        value >>= 1;
+    }
+    return result;
+}
+
+__STATIC_FORCEINLINE uint32_t __ROR(uint32_t op1, uint32_t op2)
+{
+    op2 %= 32U;
+    if (op2 == 0U) {
+        return op1;
+    }
+    return (op1 >> op2) | (op1 << (32U - op2));
+}
+
+__STATIC_FORCEINLINE int32_t __SSAT(int32_t val, uint32_t sat)
+{
+    if (sat >= 1U && sat <= 32U) {
+        const int32_t max = (int32_t)((1U << (sat - 1U)) - 1U);
+        const int32_t min = -1 - max;
+        if (val > max) {
+            return max;
+        }
+        if (val < min) {
+            return min;
+        }
+    }
+    return val;
+}
+
+__STATIC_FORCEINLINE uint32_t __USAT(int32_t val, uint32_t sat)
+{
+    if (sat <= 31U) {
+        const uint32_t max = (1U << sat) - 1U;
+        if (val > (int32_t)max) {
+            return max;
+        }
+        if (val < 0) {
+            return 0U;
+        }
+    }
+    return (uint32_t)val;
+}
+
+#endif
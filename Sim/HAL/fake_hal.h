@@ -0,0 +1,65 @@
+/**
+ * @file fake_hal.h
+ * @author Shiki
+ * @brief 主机仿真HAL的控制接口
+ *        时间：虚拟时间以微秒计，HAL_GetTick()返回其毫秒数，只在FakeHal_Advance*()和HAL_Delay()中推进；
+ *              推进过程中按时间顺序触发"中断"：每1ms的SysTick钩子、已启动定时器的周期回调
+ *              （HAL_TIM_PeriodElapsedCallback）和串口DMA发送完成回调（HAL_UART_TxCpltCallback）。
+ *        串口：HAL_UART_Transmit_DMA的数据追加到每个串口的捕获缓冲区，并按波特率（10位/字节）
+ *              计算发送完成时刻；FakeHal_UartReceive()模拟DMA循环接收，触发过半/完成/空闲事件。
+ *        GPIO：输出电平保存在端口ODR中；读取时优先调用读取钩子，未设置钩子时返回IDR（复位后全为高电平）。
+ *        DWT->CYCCNT按虚拟时间×SystemCoreClock换算，FakeHal_AddCycles()可额外计入CPU周期。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __FAKE_HAL_H
+#define __FAKE_HAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "main.h"
+
+#define FAKE_HAL_TIM_CLOCK_HZ 84000000U  // APB1定时器时钟（TIM3/TIM6）
+#define FAKE_HAL_TX_CAPTURE_SIZE 65536U  // 每个串口的发送捕获缓冲区大小，写满后只计数不保存
+
+// 每次发送启动时调用（数据在发送完成前保持有效）
+typedef void (*FakeHalTxHook_t)(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len);
+// GPIO读取钩子，返回引脚电平
+typedef GPIO_PinState (*FakeHalGpioReadHook_t)(GPIO_TypeDef *port, uint16_t pin);
+// 每1ms虚拟时间调用一次（模拟SysTick中断），参数为当前虚拟时间(us)
+typedef void (*FakeHalSysTickHook_t)(uint64_t now_us);
+
+void FakeHal_Reset(void);
+
+// 时间
+uint64_t FakeHal_GetTimeUs(void);
+void FakeHal_SetTick(uint32_t tick);
+void FakeHal_AdvanceUs(uint64_t us);
+void FakeHal_Advance(uint32_t ms);
+void FakeHal_AddCycles(uint32_t cycles);
+void FakeHal_SetSysTickHook(FakeHalSysTickHook_t hook);
+
+// 串口发送
+void FakeHal_SetTxHook(FakeHalTxHook_t hook);
+void FakeHal_SetTxAutoComplete(bool enable);  // false时发送保持忙，需调用FakeHal_CompleteTx
+void FakeHal_CompleteTx(UART_HandleTypeDef *huart);
+const uint8_t *FakeHal_GetTxData(UART_HandleTypeDef *huart, uint32_t *len);
+uint32_t FakeHal_GetTxTotal(UART_HandleTypeDef *huart);    // 累计发送字节数（含未保存的部分）
+uint32_t FakeHal_GetTxFrames(UART_HandleTypeDef *huart);   // 累计HAL_UART_Transmit_DMA成功次数
+void FakeHal_ClearTx(UART_HandleTypeDef *huart);
+
+// 串口接收
+bool FakeHal_UartReceive(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len);
+void FakeHal_UartError(UART_HandleTypeDef *huart);
+void FakeHal_UartTxError(UART_HandleTypeDef *huart);  // 中止正在进行的DMA发送并调用错误回调
+
+// GPIO
+void FakeHal_SetGpioReadHook(FakeHalGpioReadHook_t hook);
+void FakeHal_SetInput(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+GPIO_PinState FakeHal_GetOutput(GPIO_TypeDef *port, uint16_t pin);
+
+#endif
@@ -0,0 +1,52 @@
+#include "fake_keypad.h"
+
+#include "fake_hal.h"
+
+typedef struct {
+    GPIO_TypeDef *port;
+    uint16_t pin;
+} FakePin_t;
+
+static const FakePin_t row_pin[4] = {
+    {ROW1_GPIO_Port, ROW1_Pin},
+    {ROW2_GPIO_Port, ROW2_Pin},
+    {ROW3_GPIO_Port, ROW3_Pin},
+    {ROW4_GPIO_Port, ROW4_Pin},
+};
+
+static const FakePin_t col_pin[4] = {
+    {COL1_GPIO_Port, COL1_Pin},
+    {COL2_GPIO_Port, COL2_Pin},
+    {COL3_GPIO_Port, COL3_Pin},
+    {COL4_GPIO_Port, COL4_Pin},
+};
+
+static uint8_t pressed = 0;  // 按下的按键编号，0为无按键
+
+static GPIO_PinState FakeKeypad_Read(GPIO_TypeDef *port, uint16_t pin)
+{
+    if (pressed != 0) {
+        uint8_t row = (uint8_t)((pressed - 1U) / 4U);
+        uint8_t col = (uint8_t)((pressed - 1U) % 4U);
+        if (port == col_pin[col].port && pin == col_pin[col].pin &&
+            FakeHal_GetOutput(row_pin[row].port, row_pin[row].pin) == GPIO_PIN_RESET) {
+            return GPIO_PIN_RESET;
+        }
+    }
+    return (port->IDR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/**
+ * @brief 按下一个按键
+ * @param number 按键编号1~16，对应KEY_S1~KEY_S16；0等同于释放
+ */
+void FakeKeypad_Press(uint8_t number)
+{
+    pressed = (number <= 16U) ? number : 0U;
+    FakeHal_SetGpioReadHook(FakeKeypad_Read);
+}
+
+void FakeKeypad_Release(void)
+{
+    pressed = 0;
+}
@@ -0,0 +1,21 @@
+/**
+ * @file fake_keypad.h
+ * @author Shiki
+ * @brief 主机仿真用的4x4矩阵键盘，引脚与Core/Inc/main.h的ROW1~4、COL1~4一致
+ *        按下的按键所在行被拉低时，对应列读为低电平，其余列为高电平（上拉）。
+ *        FakeKeypad_Press()安装GPIO读取钩子，FakeHal_Reset()会清除钩子。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __FAKE_KEYPAD_H
+#define __FAKE_KEYPAD_H
+
+#include <stdint.h>
+
+void FakeKeypad_Press(uint8_t number);  // 按下S1~S16（编号1~16），同一时刻只有一个按键
+void FakeKeypad_Release(void);
+
+#endif
@@ -0,0 +1,193 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @author Shiki
+ * @brief 主机仿真用的STM32F4 HAL替身，替换Drivers/STM32F4xx_HAL_Driver中的同名文件
+ *        Core/Inc/main.h、usart.h、gpio.h、tim.h、i2c.h保持原样，经main.h包含本文件，
+ *        只声明BSP实际用到的类型、外设句柄字段和函数。时间、串口发送、GPIO的行为由fake_hal.c模拟，
+ *        测试程序通过fake_hal.h控制。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cmsis_compiler.h"
+
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+extern uint32_t SystemCoreClock;
+
+/* DWT周期计数器：读CYCCNT时按虚拟时间和SystemCoreClock换算，见FakeHal_AddCycles */
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+DWT_Type *FakeHal_Dwt(void);
+extern CoreDebug_Type FakeHal_CoreDebug;
+
+#define DWT (FakeHal_Dwt())
+#define CoreDebug (&FakeHal_CoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk (1UL)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+/* GPIO：ODR为输出电平，IDR为未设置读取钩子时的输入电平 */
+typedef struct {
+    uint32_t IDR;
+    uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+#define FAKE_HAL_GPIO_PORTS 9U
+extern GPIO_TypeDef FakeHal_Gpio[FAKE_HAL_GPIO_PORTS];
+
+#define GPIOA (&FakeHal_Gpio[0])
+#define GPIOB (&FakeHal_Gpio[1])
+#define GPIOC (&FakeHal_Gpio[2])
+#define GPIOD (&FakeHal_Gpio[3])
+#define GPIOE (&FakeHal_Gpio[4])
+#define GPIOF (&FakeHal_Gpio[5])
+#define GPIOG (&FakeHal_Gpio[6])
+#define GPIOH (&FakeHal_Gpio[7])
+#define GPIOI (&FakeHal_Gpio[8])
+
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_1 ((uint16_t)0x0002)
+#define GPIO_PIN_2 ((uint16_t)0x0004)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+#define GPIO_PIN_6 ((uint16_t)0x0040)
+#define GPIO_PIN_7 ((uint16_t)0x0080)
+#define GPIO_PIN_8 ((uint16_t)0x0100)
+#define GPIO_PIN_9 ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_11 ((uint16_t)0x0800)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+#define GPIO_PIN_All ((uint16_t)0xFFFF)
+
+#define __HAL_RCC_GPIOA_CLK_ENABLE() ((void)0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE() ((void)0)
+#define __HAL_RCC_GPIOE_CLK_ENABLE() ((void)0)
+
+/* UART */
+typedef struct {
+    uint32_t id;
+} USART_TypeDef;
+
+extern USART_TypeDef FakeHal_Usart[3];
+
+#define USART1 (&FakeHal_Usart[0])
+#define USART2 (&FakeHal_Usart[1])
+#define USART3 (&FakeHal_Usart[2])
+
+typedef enum {
+    HAL_UART_STATE_RESET = 0x00U,
+    HAL_UART_STATE_READY = 0x20U,
+    HAL_UART_STATE_BUSY = 0x24U,
+    HAL_UART_STATE_BUSY_TX = 0x21U,
+    HAL_UART_STATE_BUSY_RX = 0x22U,
+    HAL_UART_STATE_BUSY_TX_RX = 0x23U,
+    HAL_UART_STATE_TIMEOUT = 0xA0U,
+    HAL_UART_STATE_ERROR = 0xE0U
+} HAL_UART_StateTypeDef;
+
+typedef struct {
+    uint32_t BaudRate;
+} UART_InitTypeDef;
+
+typedef struct __UART_HandleTypeDef {
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+    uint8_t *pRxBuffPtr;                   // DMA循环接收缓冲区
+    uint16_t RxXferSize;                   // DMA循环接收缓冲区大小
+    volatile HAL_UART_StateTypeDef gState;  // 发送状态
+    volatile HAL_UART_StateTypeDef RxState; // 接收状态
+    volatile uint32_t ErrorCode;
+} UART_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData,
+                                        uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size,
+                                   uint32_t Timeout);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData,
+                                               uint16_t Size);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+
+/* TIM：周期由Init.Prescaler/Init.Period和定时器时钟FAKE_HAL_TIM_CLOCK_HZ计算 */
+typedef struct {
+    uint32_t id;
+} TIM_TypeDef;
+
+extern TIM_TypeDef FakeHal_Tim[2];
+
+#define TIM3 (&FakeHal_Tim[0])
+#define TIM6 (&FakeHal_Tim[1])
+
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t Period;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+
+/* I2C：只统计写入次数（OLED） */
+typedef struct {
+    uint32_t id;
+} I2C_TypeDef;
+
+typedef struct {
+    I2C_TypeDef *Instance;
+} I2C_HandleTypeDef;
+
+#define I2C_MEMADD_SIZE_8BIT 0x00000001U
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+                                    uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData,
+                                    uint16_t Size, uint32_t Timeout);
+
+/* 系统 */
+HAL_StatusTypeDef HAL_Init(void);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+/* GPIO */
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+#endif
@@ -0,0 +1,498 @@
+#include "gimbal_plant.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "command.h"
+#include "emm_feedback.h"
+#include "fake_hal.h"
+#include "laser_shot_common.h"
+#include "sim_frames.h"
+
+#define PLANT_TX_FRAME_MAX 64  // 保存的命令帧最大长度，双轴多电机命令为31字节
+#define PLANT_AXIS_X 0
+#define PLANT_AXIS_Y 1
+
+// 已发出、等待生效的命令帧
+typedef struct {
+    uint64_t apply_us;  // 生效时刻(us)
+    uint8_t len;
+    uint8_t data[PLANT_TX_FRAME_MAX];
+} PlantTxFrame_t;
+
+// 已采样、等待送达的视觉坐标
+typedef struct {
+    uint32_t due_tick;  // 写入时刻(ms)
+    uint16_t x, y;      // 像素坐标，(0,0)表示不在视野中
+} PlantVisionFrame_t;
+
+static GimbalPlantConfig_t plant_config;
+static PlantMotor_t plant_motor[2];
+static GimbalPlantStats_t plant_stats;
+
+static PlantTxFrame_t tx_queue[PLANT_TX_QUEUE_LEN];
+static uint8_t tx_head, tx_count;
+static PlantVisionFrame_t frame_queue[PLANT_FRAME_QUEUE_LEN];
+static uint8_t frame_head, frame_count;
+
+static uint64_t plant_last_us;
+static uint32_t plant_next_capture;
+static uint32_t plant_lcg = 1;
+
+/**
+ * @brief 加速度档位换算为RPM/s，0为直接启动（返回0）
+ */
+static float GimbalPlant_AccRpmS(uint8_t acc)
+{
+    return (acc == 0) ? 0.0f : 20000.0f / (float)(256 - acc);
+}
+
+static PlantMotor_t *GimbalPlant_FindMotor(uint8_t addr)
+{
+    for (uint8_t i = 0; i < 2; i++) {
+        if (plant_motor[i].addr == addr) {
+            return &plant_motor[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 单条命令的长度，根据功能码判断
+ * @return 命令长度，不支持的命令返回0
+ */
+static uint8_t GimbalPlant_CommandLength(const uint8_t *cmd, uint16_t len)
+{
+    if (len < 2) {
+        return 0;
+    }
+    switch (cmd[1]) {
+        case 0xFD:
+            return 13;  // 位置模式
+        case 0xF6:
+            return 8;  // 速度模式
+        case 0xF3:
+            return 6;  // 使能控制
+        case 0xFE:
+        case 0x9A:
+            return 5;  // 立即停止、触发回零
+        case 0xFF:
+            return 4;  // 多机同步触发
+        case 0x35:
+        case 0x36:
+            return 3;  // 读取实时转速、实时位置
+        case 0x11:
+            return 7;  // 定时返回（Y42）
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief 电机返回一帧应答：经USART1 DMA循环接收送达固件
+ */
+static void GimbalPlant_Reply(const uint8_t *data, uint8_t len)
+{
+    if (FakeHal_UartReceive(&huart1, data, len)) {
+        plant_stats.replies++;
+        plant_stats.reply_bytes += len;
+    }
+}
+
+/**
+ * @brief 应答实时转速或实时位置，按说明书以顺时针为正（与电机状态的逆时针为正相反）
+ * @param code 0x35 实时转速，0x36 实时位置
+ */
+static void GimbalPlant_ReplyParam(const PlantMotor_t *motor, uint8_t code)
+{
+    uint8_t buf[8];
+    uint8_t len = 0;
+    buf[len++] = motor->addr;
+    buf[len++] = code;
+    if (code == 0x35) {
+        long rpm = lrintf(-motor->rpm);
+        uint16_t mag = (uint16_t)labs(rpm);
+        buf[len++] = (rpm < 0) ? 1 : 0;
+        buf[len++] = (uint8_t)(mag >> 8);
+        buf[len++] = (uint8_t)mag;
+    } else {
+        const float scale = (float)EMM_FB_POS_PER_REV / (float)PLANT_STEPS_PER_REV;
+        long position = lrintf(-motor->pos * scale);
+        uint32_t mag = (uint32_t)labs(position);
+        buf[len++] = (position < 0) ? 1 : 0;
+        buf[len++] = (uint8_t)(mag >> 24);
+        buf[len++] = (uint8_t)(mag >> 16);
+        buf[len++] = (uint8_t)(mag >> 8);
+        buf[len++] = (uint8_t)mag;
+    }
+    buf[len++] = 0x6B;
+    GimbalPlant_Reply(buf, len);
+}
+
+/**
+ * @brief 设置定时返回：只支持实时转速和实时位置，周期为0时关闭
+ */
+static void GimbalPlant_SetStream(PlantMotor_t *motor, const uint8_t *cmd)
+{
+    uint8_t idx;
+    if (cmd[2] != 0x18) {
+        return;
+    }
+    if (cmd[3] == 0x35) {
+        idx = PLANT_STREAM_VEL;
+    } else if (cmd[3] == 0x36) {
+        idx = PLANT_STREAM_POS;
+    } else {
+        return;
+    }
+    motor->stream_ms[idx] = ((uint16_t)cmd[4] << 8) | cmd[5];
+    motor->stream_next[idx] = HAL_GetTick() + motor->stream_ms[idx];
+}
+
+/**
+ * @brief 电机执行一条命令，带同步标志的命令保存到同步触发时执行
+ */
+static void GimbalPlant_MotorExecute(PlantMotor_t *motor, const uint8_t *cmd, bool sync)
+{
+    uint8_t len = GimbalPlant_CommandLength(cmd, PLANT_TX_FRAME_MAX);
+    if (!sync && len >= 5 && cmd[1] != 0xF3 && cmd[1] != 0x11 && cmd[len - 2] != 0) {
+        memcpy(motor->sync_cmd, cmd, len);
+        motor->sync_pending = true;
+        return;
+    }
+
+    switch (cmd[1]) {
+        case 0xFD: {
+            int32_t clk = (int32_t)(((uint32_t)cmd[6] << 24) | ((uint32_t)cmd[7] << 16) |
+                                    ((uint32_t)cmd[8] << 8) | cmd[9]);
+            float delta = (cmd[2] != DIR_CW) ? (float)clk : -(float)clk;
+            // 相对运动以上一次的目标位置为基准
+            float base = (motor->mode == PLANT_MOTOR_POS) ? motor->target : motor->pos;
+            motor->target = cmd[10] ? delta : base + delta;
+            motor->cmd_rpm = (float)(((uint16_t)cmd[3] << 8) | cmd[4]);
+            motor->acc_rpm_s = GimbalPlant_AccRpmS(cmd[5]);
+            motor->mode = PLANT_MOTOR_POS;
+            break;
+        }
+        case 0xF6: {
+            float rpm = (float)(((uint16_t)cmd[3] << 8) | cmd[4]);
+            motor->cmd_rpm = (cmd[2] != DIR_CW) ? rpm : -rpm;
+            motor->acc_rpm_s = GimbalPlant_AccRpmS(cmd[5]);
+            motor->mode = PLANT_MOTOR_VEL;
+            break;
+        }
+        case 0xFE:
+            motor->rpm = 0.0f;
+            motor->target = motor->pos;
+            motor->mode = PLANT_MOTOR_IDLE;
+            break;
+        case 0x9A:
+            motor->target = 0.0f;
+            motor->cmd_rpm = PLANT_ORIGIN_RPM;
+            motor->acc_rpm_s = GimbalPlant_AccRpmS(PLANT_ORIGIN_ACC);
+            motor->mode = PLANT_MOTOR_POS;
+            break;
+        case 0x35:
+        case 0x36:
+            GimbalPlant_ReplyParam(motor, cmd[1]);
+            break;
+        case 0x11:
+            GimbalPlant_SetStream(motor, cmd);
+            break;
+        default:
+            break;
+    }
+    plant_stats.commands++;
+}
+
+/**
+ * @brief 执行一条单电机命令或多机同步触发
+ * @return false 命令不支持或长度不符
+ */
+static bool GimbalPlant_Execute(const uint8_t *cmd, uint16_t len)
+{
+    uint8_t cmd_len = GimbalPlant_CommandLength(cmd, len);
+    if (cmd_len == 0 || cmd_len > len || cmd[cmd_len - 1] != 0x6B) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < 2; i++) {
+        PlantMotor_t *motor = &plant_motor[i];
+        if (cmd[0] != 0 && cmd[0] != motor->addr) {
+            continue;
+        }
+        if (cmd[1] == 0xFF) {
+            if (motor->sync_pending) {
+                motor->sync_pending = false;
+                GimbalPlant_MotorExecute(motor, motor->sync_cmd, true);
+            }
+        } else {
+            GimbalPlant_MotorExecute(motor, cmd, false);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 命令帧生效：多电机命令逐条拆开执行
+ */
+static void GimbalPlant_ApplyFrame(const uint8_t *data, uint8_t len)
+{
+    if (len >= 5 && data[0] == 0 && data[1] == 0xAA) {
+        uint16_t total = ((uint16_t)data[2] << 8) | data[3];
+        if (total != len || data[len - 1] != 0x6B) {
+            plant_stats.unknown++;
+            return;
+        }
+        uint16_t pos = 4;
+        while (pos < len - 1) {
+            uint8_t cmd_len = GimbalPlant_CommandLength(data + pos, (uint16_t)(len - 1 - pos));
+            if (!GimbalPlant_Execute(data + pos, (uint16_t)(len - 1 - pos))) {
+                plant_stats.unknown++;
+                return;
+            }
+            pos += cmd_len;
+        }
+        return;
+    }
+    if (!GimbalPlant_Execute(data, len)) {
+        plant_stats.unknown++;
+    }
+}
+
+/**
+ * @brief USART1发送钩子：记录命令帧，按发送完成时刻加总线延迟生效
+ */
+static void GimbalPlant_TxHook(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len)
+{
+    if (huart != &huart1) {
+        return;
+    }
+    plant_stats.bus_frames++;
+    if (len > PLANT_TX_FRAME_MAX || tx_count >= PLANT_TX_QUEUE_LEN) {
+        plant_stats.unknown++;
+        return;
+    }
+    uint32_t baud = (huart->Init.BaudRate != 0) ? huart->Init.BaudRate : 115200U;
+    PlantTxFrame_t *frame = &tx_queue[(tx_head + tx_count) % PLANT_TX_QUEUE_LEN];
+    frame->apply_us = FakeHal_GetTimeUs() + ((uint64_t)len * 10U * 1000000U + baud - 1U) / baud +
+                      plant_config.bus_latency_us;
+    frame->len = (uint8_t)len;
+    memcpy(frame->data, data, len);
+    tx_count++;
+}
+
+/**
+ * @brief 电机前进dt秒：速度按加速度趋近目标速度，位置模式接近目标时按可用减速距离限速
+ */
+static void GimbalPlant_MotorStep(PlantMotor_t *motor, float dt)
+{
+    const float steps_per_rpm = (float)PLANT_STEPS_PER_REV / 60.0f;  // 每RPM的脉冲/s
+    float desired = 0.0f;
+    float remain = motor->target - motor->pos;
+
+    if (motor->mode == PLANT_MOTOR_VEL) {
+        desired = motor->cmd_rpm;
+    } else if (motor->mode == PLANT_MOTOR_POS) {
+        float limit = motor->cmd_rpm;
+        if (motor->acc_rpm_s > 0.0f) {
+            float brake = sqrtf(2.0f * motor->acc_rpm_s * steps_per_rpm * fabsf(remain)) /
+                          steps_per_rpm;
+            if (brake < limit) {
+                limit = brake;
+            }
+        }
+        desired = (remain >= 0.0f) ? limit : -limit;
+    }
+
+    float max_change = motor->acc_rpm_s * dt;
+    if (motor->acc_rpm_s <= 0.0f || fabsf(desired - motor->rpm) <= max_change) {
+        motor->rpm = desired;
+    } else {
+        motor->rpm += (desired > motor->rpm) ? max_change : -max_change;
+    }
+    motor->pos += motor->rpm * steps_per_rpm * dt;
+
+    // 到达或越过目标位置后停在目标处
+    if (motor->mode == PLANT_MOTOR_POS &&
+        (remain * (motor->target - motor->pos) <= 0.0f || fabsf(remain) < 1e-3f)) {
+        motor->pos = motor->target;
+        motor->rpm = 0.0f;
+        motor->mode = PLANT_MOTOR_IDLE;
+    }
+}
+
+/**
+ * @brief 目标方向投影到像素坐标
+ * @return false 目标在相机后方
+ */
+static bool GimbalPlant_Project(float az, float el, float *u, float *v)
+{
+    const float rad_per_step = 2.0f * 3.14159265f / (float)PLANT_STEPS_PER_REV;
+    float pan = plant_motor[PLANT_AXIS_X].pos * rad_per_step;
+    float tilt = plant_motor[PLANT_AXIS_Y].pos * rad_per_step;
+    float roll = plant_config.roll_deg * 3.14159265f / 180.0f;
+
+    // 目标方向（x向右、y向下、z向前），逆向转过水平角再转过俯仰角得到相机坐标
+    float wx = sinf(az) * cosf(el), wy = sinf(el), wz = cosf(az) * cosf(el);
+    float ax = wx * cosf(pan) - wz * sinf(pan);
+    float az_ = wx * sinf(pan) + wz * cosf(pan);
+    float cy = wy * cosf(tilt) - az_ * sinf(tilt);
+    float cz = wy * sinf(tilt) + az_ * cosf(tilt);
+    if (cz <= 0.0f) {
+        return false;
+    }
+
+    float xn = ax / cz, yn = cy / cz;
+    *u = (float)g_sensor_width / 2.0f + plant_config.focal_px * (xn * cosf(roll) - yn * sinf(roll));
+    *v = (float)g_sensor_height / 2.0f + plant_config.focal_px * (xn * sinf(roll) + yn * cosf(roll));
+    return true;
+}
+
+/**
+ * @brief 当前时刻目标的像素坐标
+ * @return false 目标不在视野中
+ */
+static bool GimbalPlant_TargetPixel(float *u, float *v)
+{
+    float az, el;
+    plant_config.target(HAL_GetTick(), &az, &el);
+    if (!GimbalPlant_Project(az, el, u, v)) {
+        return false;
+    }
+    return *u >= 1.0f && *u < (float)g_sensor_width && *v >= 1.0f && *v < (float)g_sensor_height;
+}
+
+static float GimbalPlant_Noise(void)
+{
+    plant_lcg = plant_lcg * 1664525U + 1013904223U;
+    return ((float)(plant_lcg >> 8) / 8388608.0f - 1.0f) * plant_config.noise_px;
+}
+
+/**
+ * @brief 采样一帧，加入送达队列
+ */
+static void GimbalPlant_Capture(uint32_t tick)
+{
+    // 队列已满时丢弃最早的一帧
+    if (frame_count >= PLANT_FRAME_QUEUE_LEN) {
+        frame_head = (frame_head + 1) % PLANT_FRAME_QUEUE_LEN;
+        frame_count--;
+    }
+    PlantVisionFrame_t *frame = &frame_queue[(frame_head + frame_count) % PLANT_FRAME_QUEUE_LEN];
+    float u, v;
+    frame->due_tick = tick + plant_config.latency_ms;
+    frame->x = 0;
+    frame->y = 0;
+    if (GimbalPlant_TargetPixel(&u, &v)) {
+        long x = lrintf(u + GimbalPlant_Noise());
+        long y = lrintf(v + GimbalPlant_Noise());
+        frame->x = (uint16_t)((x < 1) ? 1 : x);
+        frame->y = (uint16_t)((y < 1) ? 1 : y);
+    }
+    frame_count++;
+}
+
+/**
+ * @brief 初始化：两轴位于零点静止，清空命令和视觉帧队列，安装USART1发送钩子
+ */
+void GimbalPlant_Init(const GimbalPlantConfig_t *config)
+{
+    plant_config = *config;
+    memset(plant_motor, 0, sizeof(plant_motor));
+    plant_motor[PLANT_AXIS_X].addr = STEP_MOTOR_X;
+    plant_motor[PLANT_AXIS_Y].addr = STEP_MOTOR_Y;
+    memset(&plant_stats, 0, sizeof(plant_stats));
+    tx_head = tx_count = 0;
+    frame_head = frame_count = 0;
+    plant_last_us = FakeHal_GetTimeUs();
+    plant_next_capture = HAL_GetTick();
+    FakeHal_SetTxHook(GimbalPlant_TxHook);
+}
+
+/**
+ * @brief 推进到当前虚拟时间：执行到期的命令帧、积分电机运动、定时返回、采样并送达视觉帧
+ */
+void GimbalPlant_Update(void)
+{
+    uint64_t now_us = FakeHal_GetTimeUs();
+    while (plant_last_us < now_us) {
+        while (tx_count > 0 && tx_queue[tx_head].apply_us <= plant_last_us) {
+            GimbalPlant_ApplyFrame(tx_queue[tx_head].data, tx_queue[tx_head].len);
+            tx_head = (tx_head + 1) % PLANT_TX_QUEUE_LEN;
+            tx_count--;
+        }
+        uint64_t step = now_us - plant_last_us;
+        if (step > PLANT_SUBSTEP_US) {
+            step = PLANT_SUBSTEP_US;
+        }
+        for (uint8_t i = 0; i < 2; i++) {
+            GimbalPlant_MotorStep(&plant_motor[i], (float)step * 1e-6f);
+        }
+        plant_last_us += step;
+    }
+
+    uint32_t tick = HAL_GetTick();
+    // 定时返回：同一周期先返回转速再返回位置
+    for (uint8_t i = 0; i < 2; i++) {
+        PlantMotor_t *motor = &plant_motor[i];
+        for (uint8_t idx = PLANT_STREAM_VEL; idx <= PLANT_STREAM_POS; idx++) {
+            if (motor->stream_ms[idx] != 0 && (int32_t)(tick - motor->stream_next[idx]) >= 0) {
+                GimbalPlant_ReplyParam(motor, (idx == PLANT_STREAM_VEL) ? 0x35 : 0x36);
+                motor->stream_next[idx] += motor->stream_ms[idx];
+                // 与视觉采样相同，阻塞期间错过的周期不补发
+                if ((int32_t)(tick - motor->stream_next[idx]) >= 0) {
+                    motor->stream_next[idx] = tick + motor->stream_ms[idx];
+                }
+            }
+        }
+    }
+    if ((int32_t)(tick - plant_next_capture) >= 0) {
+        GimbalPlant_Capture(tick);
+        plant_next_capture += plant_config.frame_ms;
+        // 固件中的HAL_Delay等阻塞期间相机照常采样，阻塞结束后不补采，从当前时刻继续
+        if ((int32_t)(tick - plant_next_capture) >= 0) {
+            plant_next_capture = tick + plant_config.frame_ms;
+        }
+    }
+    while (frame_count > 0 && (int32_t)(tick - frame_queue[frame_head].due_tick) >= 0) {
+        uint8_t buf[SIM_FRAME_V1_LEN];
+        SimFrame_V1(buf, frame_queue[frame_head].x, frame_queue[frame_head].y);
+        if (Command_Write(buf, sizeof(buf)) == sizeof(buf)) {
+            plant_stats.frames++;
+        } else {
+            plant_stats.dropped++;
+        }
+        frame_head = (frame_head + 1) % PLANT_FRAME_QUEUE_LEN;
+        frame_count--;
+    }
+}
+
+/**
+ * @brief 当前真实指向误差：目标像素坐标（无噪声、无延迟）减瞄准点
+ * @return false 目标不在视野中
+ */
+bool GimbalPlant_GetError(float *error_x, float *error_y)
+{
+    float u, v;
+    if (!GimbalPlant_TargetPixel(&u, &v)) {
+        return false;
+    }
+    *error_x = u - (float)g_sensor_aim_x;
+    *error_y = v - (float)g_sensor_aim_y;
+    return true;
+}
+
+/**
+ * @brief 根据地址获取电机状态
+ */
+const PlantMotor_t *GimbalPlant_GetMotor(uint8_t addr)
+{
+    return GimbalPlant_FindMotor(addr);
+}
+
+void GimbalPlant_GetStats(GimbalPlantStats_t *stats)
+{
+    *stats = plant_stats;
+}
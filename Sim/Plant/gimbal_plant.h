@@ -0,0 +1,86 @@
+/**
+ * @file gimbal_plant.h
+ * @author Shiki
+ * @brief 云台对象仿真：两台Emm_V5步进电机 + 随云台转动的针孔相机
+ *        电机：解析USART1发出的命令帧（位置、速度、立即停止、回零、多电机命令、多机同步），
+ *              帧发送完成后再经过总线延迟生效；每圈CYCLE_CLK个脉冲，按命令速度和加速度档位
+ *              （每(256-acc)*50us速度变化1RPM）做梯形加减速；
+ *              应答读取实时位置/实时转速命令，按定时返回命令（Y42）的周期主动上报，
+ *              应答经FakeHal_UartReceive()写入USART1接收缓冲区，数值按说明书以顺时针为正。
+ *        相机：按帧间隔采样目标方向，经云台水平/俯仰转动和相机绕光轴的安装角投影到像素坐标，
+ *              加噪声后延迟latency_ms生成0xAA旧格式帧，经Command_Write写入指令缓冲区。
+ *        激光与相机光轴平行，始终照在g_sensor_aim_x/y处，指向误差为目标真实像素坐标与瞄准点之差。
+ *        使用方法：GimbalPlant_Init()后每1ms虚拟时间调用一次GimbalPlant_Update()。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __GIMBAL_PLANT_H
+#define __GIMBAL_PLANT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Emm_V5.h"
+
+#define PLANT_STEPS_PER_REV CYCLE_CLK  // 每圈脉冲数
+#define PLANT_SUBSTEP_US 100U          // 电机积分步长(us)
+#define PLANT_ORIGIN_RPM 60.0f         // 回零速度(RPM)
+#define PLANT_ORIGIN_ACC 200           // 回零加速度档位
+#define PLANT_TX_QUEUE_LEN 32          // 已发出、尚未生效的命令帧数
+#define PLANT_FRAME_QUEUE_LEN 16       // 已采样、尚未送达的视觉帧数
+#define PLANT_STREAM_VEL 0             // 定时返回：实时转速
+#define PLANT_STREAM_POS 1             // 定时返回：实时位置
+
+// 目标方向(rad)：az向右为正，el向下为正，与图像x、y方向一致
+typedef void (*PlantTargetFn_t)(uint32_t tick, float *az, float *el);
+
+typedef struct {
+    float focal_px;           // 焦距(像素)
+    float roll_deg;           // 相机绕光轴相对电机轴的安装角(°)
+    float noise_px;           // 坐标均匀噪声幅度(像素)
+    uint32_t frame_ms;        // 帧间隔(ms)
+    uint32_t latency_ms;      // 采样到数据帧写入的延迟(ms)
+    uint32_t bus_latency_us;  // 命令帧发送完成到电机执行的延迟(us)
+    PlantTargetFn_t target;   // 目标运动
+} GimbalPlantConfig_t;
+
+typedef enum {
+    PLANT_MOTOR_IDLE = 0,  // 静止
+    PLANT_MOTOR_POS,       // 位置模式：向target运动
+    PLANT_MOTOR_VEL        // 速度模式：保持速度
+} PlantMotorMode_t;
+
+typedef struct {
+    uint8_t addr;             // 电机地址
+    PlantMotorMode_t mode;    // 运动模式
+    float pos;                // 当前位置(脉冲，逆时针为正)
+    float rpm;                // 当前速度(RPM，逆时针为正)
+    float target;             // 位置模式目标(脉冲)
+    float cmd_rpm;            // 速度模式为带符号的目标速度，位置模式为最大速度(RPM)
+    float acc_rpm_s;          // 加速度(RPM/s)，0为直接启动
+    uint8_t sync_cmd[16];     // 等待多机同步触发的命令
+    bool sync_pending;        // 是否有等待同步的命令
+    uint16_t stream_ms[2];    // 定时返回周期(ms)，0为关闭，下标为PLANT_STREAM_*
+    uint32_t stream_next[2];  // 下一次定时返回的时刻(ms)
+} PlantMotor_t;
+
+typedef struct {
+    uint32_t bus_frames;   // USART1发出的帧数
+    uint32_t commands;     // 执行的电机命令数（多电机命令中的每条单独计数）
+    uint32_t unknown;      // 无法解析的帧数
+    uint32_t replies;      // 电机经USART1返回的帧数（读取应答和定时返回）
+    uint32_t reply_bytes;  // 电机经USART1返回的字节数
+    uint32_t frames;       // 写入的视觉帧数
+    uint32_t dropped;      // 指令缓冲区已满丢弃的视觉帧数
+} GimbalPlantStats_t;
+
+void GimbalPlant_Init(const GimbalPlantConfig_t *config);
+void GimbalPlant_Update(void);
+bool GimbalPlant_GetError(float *error_x, float *error_y);  // 当前真实指向误差(像素)，目标不在视野中返回false
+const PlantMotor_t *GimbalPlant_GetMotor(uint8_t addr);
+void GimbalPlant_GetStats(GimbalPlantStats_t *stats);
+
+#endif
@@ -0,0 +1,189 @@
+/**
+ * @file bench_command.c
+ * @author Shiki
+ * @brief 指令解析基准：经Command_Write向循环缓冲区写入数MB随机数据和针对帧同步的构造数据，
+ *        每次写入后用Command_GetCommand取完所有指令，报告每字节耗时（ns和主机TSC周期）；
+ *        检查返回的每条指令长度、包头和校验正确，夹在无包头垃圾数据中的有效帧全部被找到
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "command.h"
+#include "fake_hal.h"
+#include "sim_frames.h"
+#include "sim_test.h"
+
+#define BENCH_BYTES (4U * 1024U * 1024U)  // 每种数据的字节数
+#define BENCH_CHUNK_MAX 64U               // 每次写入的最大字节数（与DMA空闲中断一次的数据量相当）
+
+typedef enum {
+    STREAM_RANDOM = 0,      // 均匀随机字节
+    STREAM_HEADER_FLOOD,    // 全是0xAA/0xAB + 最大长度：每个字节都是候选包头，每个候选都扫描到最大长度
+    STREAM_V2_BAD_CRC,      // 最长的v2帧，CRC错误：每帧都扫描完再从下一字节重新同步
+    STREAM_MIXED,           // 无包头字节的随机垃圾中夹着有效帧
+    STREAM_COUNT
+} StreamType_t;
+
+static const char *const stream_name[STREAM_COUNT] = {"random", "header_flood", "v2_bad_crc",
+                                                      "mixed"};
+
+static uint32_t lcg_state = 1;
+
+static uint8_t Bench_Random(void)
+{
+    lcg_state = lcg_state * 1664525U + 1013904223U;
+    return (uint8_t)(lcg_state >> 24);
+}
+
+/**
+ * @brief 生成一段数据，返回其中有效帧的数量
+ */
+static uint32_t Bench_Generate(StreamType_t type, uint8_t *data, uint32_t size)
+{
+    uint32_t valid = 0;
+    uint32_t i = 0;
+    PixelPoint_t points[4] = {{100, 200}, {300, 400}, {500, 600}, {700, 800}};
+    uint8_t frame[64];
+
+    while (i < size) {
+        switch (type) {
+            case STREAM_RANDOM:
+                data[i++] = Bench_Random();
+                break;
+            case STREAM_HEADER_FLOOD:
+                data[i] = (i % 2) ? 32 : ((i % 4) ? 0xAB : 0xAA);
+                i++;
+                break;
+            case STREAM_V2_BAD_CRC: {
+                uint8_t len = SimFrame_V2(frame, (uint16_t)i, i, 200, 1, points, 4);
+                frame[len - 1] ^= 0x5A;
+                for (uint8_t k = 0; k < len && i < size; k++) {
+                    data[i++] = frame[k];
+                }
+                break;
+            }
+            case STREAM_MIXED: {
+                uint8_t garbage = Bench_Random() % 48;
+                for (uint8_t k = 0; k < garbage && i < size; k++) {
+                    uint8_t b = Bench_Random();
+                    data[i++] = ((b & 0xFE) == 0xAA) ? 0x55 : b;
+                }
+                uint8_t len = (Bench_Random() & 1)
+                                  ? SimFrame_V1(frame, Bench_Random(), Bench_Random())
+                                  : SimFrame_V2(frame, (uint16_t)i, i, 200, 1, points,
+                                                (uint8_t)(Bench_Random() % 5));
+                if (i + len > size) {
+                    memset(data + i, 0x55, size - i);
+                    i = size;
+                    break;
+                }
+                memcpy(data + i, frame, len);
+                i += len;
+                valid++;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return valid;
+}
+
+/**
+ * @brief 独立检查一条指令的格式和校验
+ */
+static bool Bench_CheckFrame(const uint8_t *cmd, uint8_t len)
+{
+    if (len < 4 || len > 32 || cmd[1] != len) {
+        return false;
+    }
+    if (cmd[0] == 0xAA) {
+        uint8_t sum = 0;
+        for (uint8_t i = 0; i < len - 1; i++) {
+            sum += cmd[i];
+        }
+        return sum == cmd[len - 1];
+    }
+    if (cmd[0] == 0xAB) {
+        uint16_t crc = SimFrame_Crc16(cmd, (uint8_t)(len - 2));
+        return crc == (((uint16_t)cmd[len - 2] << 8) | cmd[len - 1]);
+    }
+    return false;
+}
+
+static uint8_t stream[BENCH_BYTES];
+
+static void Bench_RunStream(StreamType_t type)
+{
+    uint32_t valid = Bench_Generate(type, stream, BENCH_BYTES);
+    uint8_t cmd[32];
+    uint32_t frames = 0;
+    uint32_t bad = 0;
+
+    CommandStats_t before;
+    Command_GetStats(&before);
+
+    uint64_t t0 = SimTest_NowNs();
+    uint64_t c0 = SimTest_NowCycles();
+    uint32_t pos = 0;
+    while (pos < BENCH_BYTES) {
+        uint32_t chunk = 1U + Bench_Random() % BENCH_CHUNK_MAX;
+        if (chunk > BENCH_BYTES - pos) {
+            chunk = BENCH_BYTES - pos;
+        }
+        if (Command_Write(stream + pos, (uint8_t)chunk) != chunk) {
+            bad++;
+            break;
+        }
+        pos += chunk;
+        uint8_t len;
+        while ((len = Command_GetCommand(cmd)) != 0) {
+            frames++;
+            if (!Bench_CheckFrame(cmd, len)) {
+                bad++;
+            }
+        }
+    }
+    uint64_t c1 = SimTest_NowCycles();
+    uint64_t t1 = SimTest_NowNs();
+
+    CommandStats_t after;
+    Command_GetStats(&after);
+    printf("%-12s %5.2f ns/byte %6.1f cycles/byte %8.1f MB/s frames=%lu\n", stream_name[type],
+           (double)(t1 - t0) / BENCH_BYTES, (double)(c1 - c0) / BENCH_BYTES,
+           (double)BENCH_BYTES / ((double)(t1 - t0) / 1e3), (unsigned long)frames);
+
+    SIM_CHECK_EQ(bad, 0);
+    SIM_CHECK_EQ(after.overruns, before.overruns);
+    switch (type) {
+        case STREAM_HEADER_FLOOD:
+        case STREAM_V2_BAD_CRC:
+            SIM_CHECK_EQ(frames, 0);
+            break;
+        case STREAM_MIXED:
+            SIM_CHECK_EQ(frames, valid);
+            break;
+        default:
+            break;
+    }
+
+    // 清空剩余的不完整候选帧，下一段数据从同步状态开始
+    uint8_t flush[32];
+    memset(flush, 0x00, sizeof(flush));
+    Command_Write(flush, sizeof(flush));
+    while (Command_GetCommand(cmd) != 0) {
+    }
+}
+
+int main(void)
+{
+    FakeHal_Reset();
+    for (uint8_t type = 0; type < STREAM_COUNT; type++) {
+        Bench_RunStream((StreamType_t)type);
+    }
+    return SIM_RESULT();
+}
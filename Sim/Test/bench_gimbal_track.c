@@ -0,0 +1,352 @@
+/**
+ * @file bench_gimbal_track.c
+ * @author Shiki
+ * @brief 云台闭环追踪基准：固件（调度器、TIM6视觉处理、Track_Task、GimbalMotion发送队列）与
+ *        Sim/Plant中的两轴步进电机和针孔相机组成闭环，按场景运行Laser_TrackAimPoint各模式和Q3搜索，
+ *        报告锁定时间、锁定后的RMS/最大指向误差（真实误差，不含视觉噪声和延迟）和电机命令数，
+ *        用于在同一组场景下比较不同版本和参数；设有上限的场景检查在限定时间内锁定且误差不超过上限。
+ *        另外比较每个追踪周期查询两轴位置/转速与使用定时返回时USART1上收发的帧数和字节数。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app_tasks.h"
+#include "aim_calibration.h"
+#include "emm_feedback.h"
+#include "fake_hal.h"
+#include "gimbal_motion.h"
+#include "gimbal_plant.h"
+#include "laser_shot_common.h"
+#include "sim_test.h"
+#include "task_scheduler.h"
+#include "tim.h"
+
+#define BENCH_FOCAL_PX 277.0f      // 320像素宽、水平视场角约60°
+#define BENCH_FRAME_MS 20U         // 相机帧间隔
+#define BENCH_LATENCY_MS 30U       // 采样到数据帧写入的延迟
+#define BENCH_NOISE_PX 1.0f        // 坐标噪声幅度
+#define BENCH_BUS_LATENCY_US 500U  // 电机命令处理延迟
+#define BENCH_WARMUP_MS 500U       // 开始追踪前让滤波器和预测器看到新场景的时间
+#define BENCH_LOCK_PX 5.0f         // 误差小于该值且保持BENCH_LOCK_HOLD_MS认为锁定
+#define BENCH_LOCK_HOLD_MS 300U
+#define BENCH_Q3_PERIOD_MS 20U     // Q3任务执行周期
+#define BENCH_TRAFFIC_CYCLES 100U  // 比较反馈总线流量的追踪周期数
+#define DEG(x) ((x) * 3.14159265f / 180.0f)
+
+typedef enum {
+    BENCH_LASER_TRACK = 0,  // Laser_TrackAimPoint，由Track_Task执行
+    BENCH_Q3_KEY,           // S5~S8键任务：X轴回零、按规划转过按键对应的角度后PID精调，由Track_Task执行
+    BENCH_Q3                // Task_BasicQ3_Execute，固件中未加入调度，按BENCH_Q3_PERIOD_MS调用
+} BenchTask_t;
+
+typedef struct {
+    const char *name;
+    BenchTask_t task;
+    TrackMode_t mode;         // BENCH_LASER_TRACK的控制模式
+    bool calibrate;           // 开始前在当前相机安装角下运行像素-脉冲标定
+    float roll_deg;           // 相机安装角
+    float az_deg, el_deg;     // 目标中心方向
+    float radius_deg;         // 圆周运动半径，0为静止
+    float period_s;           // 圆周运动周期
+    uint32_t duration_ms;     // 场景时长
+    uint32_t max_lock_ms;     // 锁定时间上限，0为只报告不检查
+    float max_rms_px;         // 锁定后RMS误差上限
+    void (*key_start)(void);  // BENCH_Q3_KEY的启动函数
+} BenchScenario_t;
+
+typedef struct {
+    uint32_t lock_ms;     // 锁定时间，未锁定为UINT32_MAX
+    float rms_px;         // 锁定后RMS误差
+    float max_px;         // 锁定后最大误差
+    uint32_t commands;    // 电机命令数
+    uint32_t bus_frames;  // USART1帧数
+    uint32_t replies;     // USART1电机返回帧数
+} BenchResult_t;
+
+typedef struct {
+    uint32_t frames;  // USART1收发帧数
+    uint32_t bytes;   // USART1收发字节数
+} BenchTraffic_t;
+
+static const BenchScenario_t scenarios[] = {
+    {"step_static", BENCH_LASER_TRACK, TRACK_MODE_STEP, false, 0.0f, 8.0f, 5.0f, 0.0f, 0.0f,
+     6000, 1000, 2.0f},
+    {"pid_static", BENCH_LASER_TRACK, TRACK_MODE_PID, false, 0.0f, 8.0f, 5.0f, 0.0f, 0.0f, 4000,
+     2000, 3.0f},
+    {"pid_circle", BENCH_LASER_TRACK, TRACK_MODE_PID, false, 0.0f, 0.0f, 0.0f, 5.0f, 4.0f, 8000,
+     2500, 5.0f},
+    // 自整定完成后切换到PID模式，整定出的增益保留到之后的场景
+    {"autotune_static", BENCH_LASER_TRACK, TRACK_MODE_AUTOTUNE, false, 0.0f, 8.0f, 5.0f, 0.0f,
+     0.0f, 8000, 3500, 3.0f},
+    {"vel_circle", BENCH_LASER_TRACK, TRACK_MODE_VELOCITY, false, 0.0f, 0.0f, 0.0f, 5.0f, 4.0f,
+     8000, 1000, 5.0f},
+    {"snap_static", BENCH_LASER_TRACK, TRACK_MODE_SNAP, true, 0.0f, 8.0f, 5.0f, 0.0f, 0.0f, 4000,
+     500, 3.0f},
+    {"snap_roll25", BENCH_LASER_TRACK, TRACK_MODE_SNAP, true, 25.0f, 8.0f, 5.0f, 0.0f, 0.0f, 4000,
+     500, 3.0f},
+    {"vel_circle_roll25", BENCH_LASER_TRACK, TRACK_MODE_VELOCITY, true, 25.0f, 0.0f, 0.0f, 5.0f,
+     4.0f, 8000, 1000, 5.0f},
+    // 目标在转动90°后的视野中，俯仰与瞄准点一致（S5任务只控制X轴，进入死区且精调转完后停止）
+    {"q3_key_s5", BENCH_Q3_KEY, TRACK_MODE_STEP, false, 0.0f, -84.0f, 2.0f, 0.0f, 0.0f, 6000,
+     2000, 5.0f, Task_Q3_Key_S5_Start},
+    // S7逆时针转90°；S8顺时针转160°，转动距离足够达到最大速度，为带匀速段的梯形曲线
+    {"q3_key_s7", BENCH_Q3_KEY, TRACK_MODE_STEP, false, 0.0f, 84.0f, 2.0f, 0.0f, 0.0f, 6000,
+     2000, 5.0f, Task_Q3_Key_S7_Start},
+    {"q3_key_s8", BENCH_Q3_KEY, TRACK_MODE_STEP, false, 0.0f, -154.0f, 2.0f, 0.0f, 0.0f, 6000,
+     2000, 5.0f, Task_Q3_Key_S8_Start},
+    // 搜索能找到目标，之后每20ms一次的固定步进在视觉延迟下来回振荡，只报告
+    {"q3_search", BENCH_Q3, TRACK_MODE_STEP, false, 0.0f, 40.0f, 3.0f, 0.0f, 0.0f, 6000, 0,
+     0.0f},
+};
+
+static const BenchScenario_t *bench_scenario;
+static uint32_t bench_start_tick;
+
+/**
+ * @brief 目标方向：静止或以场景中心为圆心做圆周运动
+ */
+static void Bench_Target(uint32_t tick, float *az, float *el)
+{
+    float az0 = DEG(bench_scenario->az_deg);
+    float el0 = DEG(bench_scenario->el_deg);
+    if (bench_scenario->radius_deg <= 0.0f) {
+        *az = az0;
+        *el = el0;
+        return;
+    }
+    float phase = 2.0f * 3.14159265f * (float)(tick - bench_start_tick) * 0.001f /
+                  bench_scenario->period_s;
+    *az = az0 + DEG(bench_scenario->radius_deg) * sinf(phase);
+    *el = el0 + DEG(bench_scenario->radius_deg) * (1.0f - cosf(phase));
+}
+
+// 标定时目标静止在瞄准点附近
+static void Bench_CalibrationTarget(uint32_t tick, float *az, float *el)
+{
+    (void)tick;
+    *az = 0.0f;
+    *el = 0.0f;
+}
+
+static void Bench_PlantInit(float roll_deg, PlantTargetFn_t target)
+{
+    const GimbalPlantConfig_t config = {
+        .focal_px = BENCH_FOCAL_PX,
+        .roll_deg = roll_deg,
+        .noise_px = BENCH_NOISE_PX,
+        .frame_ms = BENCH_FRAME_MS,
+        .latency_ms = BENCH_LATENCY_MS,
+        .bus_latency_us = BENCH_BUS_LATENCY_US,
+        .target = target,
+    };
+    GimbalPlant_Init(&config);
+}
+
+/**
+ * @brief 虚拟时间前进1ms：电机和相机更新，主循环运行调度器
+ */
+static void Bench_Tick(void)
+{
+    FakeHal_Advance(1);
+    GimbalPlant_Update();
+    TaskScheduler_Run();
+}
+
+/**
+ * @brief 在当前安装角下运行像素-脉冲标定直到结束
+ */
+static bool Bench_Calibrate(float roll_deg)
+{
+    Bench_PlantInit(roll_deg, Bench_CalibrationTarget);
+    for (uint32_t t = 0; t < BENCH_WARMUP_MS; t++) {
+        Bench_Tick();
+    }
+    Laser_TrackAimPoint_SetMode(TRACK_MODE_CALIBRATE);
+    Laser_TrackAimPoint_Start();
+    for (uint32_t t = 0; t < AIM_CAL_TIMEOUT_MS && AimCal_GetState() == AIM_CAL_RUNNING; t++) {
+        Bench_Tick();
+    }
+    Laser_TrackAimPoint_Stop();
+    while (!GimbalMotion_IsIdle()) {
+        Bench_Tick();
+    }
+    return AimCal_GetState() == AIM_CAL_DONE;
+}
+
+static void Bench_Run(const BenchScenario_t *scenario, BenchResult_t *result)
+{
+    bench_scenario = scenario;
+    if (scenario->calibrate) {
+        SIM_CHECK(Bench_Calibrate(scenario->roll_deg));
+    }
+
+    Bench_PlantInit(scenario->roll_deg, Bench_Target);
+    bench_start_tick = HAL_GetTick();
+    for (uint32_t t = 0; t < BENCH_WARMUP_MS; t++) {
+        Bench_Tick();
+    }
+
+    GimbalPlantStats_t before, after;
+    GimbalPlant_GetStats(&before);
+    bench_start_tick = HAL_GetTick();
+    if (scenario->task == BENCH_LASER_TRACK) {
+        Laser_TrackAimPoint_SetMode(scenario->mode);
+        Laser_TrackAimPoint_Start();
+    } else if (scenario->task == BENCH_Q3_KEY) {
+        scenario->key_start();
+    } else {
+        Task_BasicQ3_Start();
+    }
+
+    uint32_t hold_start = 0;
+    bool holding = false;
+    double sum_sq = 0.0;
+    uint32_t samples = 0;
+    result->lock_ms = UINT32_MAX;
+    result->max_px = 0.0f;
+
+    for (uint32_t t = 0; t < scenario->duration_ms; t++) {
+        Bench_Tick();
+        if (scenario->task == BENCH_Q3 && t % BENCH_Q3_PERIOD_MS == 0) {
+            Task_BasicQ3_Execute();
+        }
+
+        float ex, ey;
+        float error = GimbalPlant_GetError(&ex, &ey) ? hypotf(ex, ey) : INFINITY;
+        if (result->lock_ms == UINT32_MAX) {
+            if (error >= BENCH_LOCK_PX) {
+                holding = false;
+            } else if (!holding) {
+                holding = true;
+                hold_start = t;
+            } else if (t - hold_start >= BENCH_LOCK_HOLD_MS) {
+                result->lock_ms = hold_start;
+            }
+            continue;
+        }
+        sum_sq += (double)error * error;
+        samples++;
+        if (error > result->max_px) {
+            result->max_px = error;
+        }
+    }
+
+    if (scenario->task == BENCH_LASER_TRACK) {
+        Laser_TrackAimPoint_Stop();
+    } else if (scenario->task == BENCH_Q3) {
+        Task_BasicQ3_Stop();
+    }
+    GimbalPlant_GetStats(&after);
+    result->rms_px = (samples > 0) ? (float)sqrt(sum_sq / samples) : INFINITY;
+    result->commands = after.commands - before.commands;
+    result->bus_frames = after.bus_frames - before.bus_frames;
+    result->replies = after.replies - before.replies;
+    SIM_CHECK_EQ(after.unknown, 0);
+    SIM_CHECK_EQ(after.dropped, 0);
+
+    // 两轴停止，下一场景从静止开始
+    for (uint32_t t = 0; t < 200 || !GimbalMotion_IsIdle(); t++) {
+        Bench_Tick();
+    }
+}
+
+static void Test_Scenarios(void)
+{
+    printf("%-18s %8s %8s %8s %9s %9s %9s\n", "scenario", "lock_ms", "rms_px", "max_px",
+           "commands", "frames", "replies");
+    for (uint8_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        BenchResult_t result;
+        Bench_Run(&scenarios[i], &result);
+        if (result.lock_ms == UINT32_MAX) {
+            printf("%-18s %8s %8s %8s %9lu %9lu %9lu\n", scenarios[i].name, "-", "-", "-",
+                   (unsigned long)result.commands, (unsigned long)result.bus_frames,
+                   (unsigned long)result.replies);
+        } else {
+            printf("%-18s %8lu %8.2f %8.2f %9lu %9lu %9lu\n", scenarios[i].name,
+                   (unsigned long)result.lock_ms, result.rms_px, result.max_px,
+                   (unsigned long)result.commands, (unsigned long)result.bus_frames,
+                   (unsigned long)result.replies);
+        }
+        if (scenarios[i].max_lock_ms != 0) {
+            SIM_CHECK(result.lock_ms <= scenarios[i].max_lock_ms);
+            SIM_CHECK(result.rms_px <= scenarios[i].max_rms_px);
+        }
+    }
+}
+
+/**
+ * @brief 两轴静止，运行BENCH_TRAFFIC_CYCLES个追踪周期，统计USART1收发的帧数和字节数
+ * @param poll true 每个周期查询两轴实时位置和实时转速，false 使用定时返回
+ */
+static void Bench_FeedbackTraffic(bool poll, BenchTraffic_t *traffic)
+{
+    Bench_PlantInit(0.0f, Bench_CalibrationTarget);
+    if (!poll) {
+        EmmFeedback_StartStreaming(EMM_FB_STREAM_PERIOD_MS);
+    }
+    // 等待定时返回设置生效
+    for (uint32_t t = 0; t < EMM_FB_STREAM_PERIOD_MS; t++) {
+        Bench_Tick();
+    }
+
+    GimbalPlantStats_t before, after;
+    EmmFeedbackStats_t fb_before, fb_after;
+    GimbalPlant_GetStats(&before);
+    EmmFeedback_GetStats(&fb_before);
+    uint32_t tx_frames = FakeHal_GetTxFrames(&huart1);
+    uint32_t tx_bytes = FakeHal_GetTxTotal(&huart1);
+
+    for (uint32_t cycle = 0; cycle < BENCH_TRAFFIC_CYCLES; cycle++) {
+        if (poll) {
+            Emm_V5_Read_Sys_Params(STEP_MOTOR_X, S_CPOS);
+            Emm_V5_Read_Sys_Params(STEP_MOTOR_X, S_VEL);
+            Emm_V5_Read_Sys_Params(STEP_MOTOR_Y, S_CPOS);
+            Emm_V5_Read_Sys_Params(STEP_MOTOR_Y, S_VEL);
+        }
+        for (uint32_t t = 0; t < EMM_FB_STREAM_PERIOD_MS; t++) {
+            Bench_Tick();
+        }
+    }
+
+    GimbalPlant_GetStats(&after);
+    EmmFeedback_GetStats(&fb_after);
+    traffic->frames = FakeHal_GetTxFrames(&huart1) - tx_frames;
+    traffic->frames += after.replies - before.replies;
+    traffic->bytes = FakeHal_GetTxTotal(&huart1) - tx_bytes;
+    traffic->bytes += after.reply_bytes - before.reply_bytes;
+    // 返回帧全部被固件解析
+    SIM_CHECK_EQ(fb_after.frames - fb_before.frames, after.replies - before.replies);
+    SIM_CHECK_EQ(fb_after.resync, fb_before.resync);
+    EmmFeedback_StopStreaming();
+}
+
+// 每个周期两轴各得到一次位置和转速：查询为4条命令 + 4帧应答，定时返回只有4帧返回
+static void Test_FeedbackTraffic(void)
+{
+    BenchTraffic_t poll, stream;
+    Bench_FeedbackTraffic(true, &poll);
+    Bench_FeedbackTraffic(false, &stream);
+    printf("feedback per %ums cycle: poll %.1f frames %.1f bytes, stream %.1f frames %.1f bytes\n",
+           EMM_FB_STREAM_PERIOD_MS, (double)poll.frames / BENCH_TRAFFIC_CYCLES,
+           (double)poll.bytes / BENCH_TRAFFIC_CYCLES, (double)stream.frames / BENCH_TRAFFIC_CYCLES,
+           (double)stream.bytes / BENCH_TRAFFIC_CYCLES);
+
+    SIM_CHECK_EQ(poll.frames, 8 * BENCH_TRAFFIC_CYCLES);
+    SIM_CHECK_EQ(poll.bytes, 40 * BENCH_TRAFFIC_CYCLES);
+    SIM_CHECK_EQ(stream.frames, 4 * BENCH_TRAFFIC_CYCLES);
+    SIM_CHECK_EQ(stream.bytes, 28 * BENCH_TRAFFIC_CYCLES);
+}
+
+int main(void)
+{
+    FakeHal_Reset();
+    GimbalMotion_Init();
+    EmmFeedback_Init();
+    HAL_TIM_Base_Start_IT(&htim6);
+    AppTasks_Init();
+    SIM_RUN(Test_Scenarios);
+    SIM_RUN(Test_FeedbackTraffic);
+    return SIM_RESULT();
+}
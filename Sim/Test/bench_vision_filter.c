@@ -0,0 +1,135 @@
+/**
+ * @file bench_vision_filter.c
+ * @author Shiki
+ * @brief 视觉坐标滤波基准：同一段带噪声和离群点的运动目标序列分别经中值滤波（X、Y各一个）
+ *        和卡尔曼滤波，报告每次更新的耗时（主机TSC周期）和相对真实位置的RMS误差；
+ *        并检查S3键在中值滤波和卡尔曼滤波之间切换。目标板上的耗时见PROFILER探针Vision_Filter。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "fake_hal.h"
+#include "fake_keypad.h"
+#include "kalman_cv2d.h"
+#include "key.h"
+#include "median_filter.h"
+#include "sim_test.h"
+#include "uart_user.h"
+
+#define BENCH_SAMPLES 100000U
+#define BENCH_FRAME_MS 20U       // 相机帧间隔(ms)
+#define BENCH_NOISE_PX 2         // 均匀噪声幅度(像素)
+#define BENCH_OUTLIER_EVERY 50U  // 每50帧一个离群点
+#define BENCH_OUTLIER_PX 60
+#define BENCH_SETTLE 50U         // 统计误差前跳过的帧数
+
+static PixelPoint_t truth[BENCH_SAMPLES];
+static PixelPoint_t meas[BENCH_SAMPLES];
+
+static uint32_t lcg_state = 12345;
+
+static int32_t Bench_Noise(void)
+{
+    lcg_state = lcg_state * 1664525U + 1013904223U;
+    return (int32_t)((lcg_state >> 16) % (2 * BENCH_NOISE_PX + 1)) - BENCH_NOISE_PX;
+}
+
+/**
+ * @brief 周期2s的椭圆运动，最大速度约470像素/s
+ */
+static void Bench_MakeSequence(void)
+{
+    for (uint32_t k = 0; k < BENCH_SAMPLES; k++) {
+        double t = (double)(k * BENCH_FRAME_MS) / 1000.0;
+        truth[k].x = (uint16_t)(320.0 + 150.0 * sin(M_PI * t) + 0.5);
+        truth[k].y = (uint16_t)(240.0 + 100.0 * cos(M_PI * t) + 0.5);
+        int32_t outlier = (k % BENCH_OUTLIER_EVERY == BENCH_OUTLIER_EVERY - 1) ? BENCH_OUTLIER_PX : 0;
+        meas[k].x = (uint16_t)(truth[k].x + Bench_Noise() + outlier);
+        meas[k].y = (uint16_t)(truth[k].y + Bench_Noise());
+    }
+}
+
+static double Bench_Rms(const PixelPoint_t *out)
+{
+    double sum_sq = 0.0;
+    for (uint32_t k = BENCH_SETTLE; k < BENCH_SAMPLES; k++) {
+        double dx = (double)out[k].x - (double)truth[k].x;
+        double dy = (double)out[k].y - (double)truth[k].y;
+        sum_sq += dx * dx + dy * dy;
+    }
+    return sqrt(sum_sq / (double)(BENCH_SAMPLES - BENCH_SETTLE));
+}
+
+static PixelPoint_t out_median[BENCH_SAMPLES];
+static PixelPoint_t out_kalman[BENCH_SAMPLES];
+
+static void Test_FilterCost(void)
+{
+    Bench_MakeSequence();
+
+    // 与uart_user.c相同的配置：窗口3的中值滤波，默认Q、R的卡尔曼滤波
+    MedianFilter_t median_x, median_y;
+    SIM_CHECK(MedianFilter_Init(&median_x, 3, false, MEDIAN_FILTER_HAMPEL_K));
+    SIM_CHECK(MedianFilter_Init(&median_y, 3, false, MEDIAN_FILTER_HAMPEL_K));
+    KalmanCv2d_t kalman;
+    KalmanCv2d_Init(&kalman, KALMAN_CV2D_Q, KALMAN_CV2D_R);
+
+    uint64_t t0 = SimTest_NowCycles();
+    for (uint32_t k = 0; k < BENCH_SAMPLES; k++) {
+        out_median[k].x = MedianFilter_Update(&median_x, meas[k].x);
+        out_median[k].y = MedianFilter_Update(&median_y, meas[k].y);
+    }
+    uint64_t t1 = SimTest_NowCycles();
+    for (uint32_t k = 0; k < BENCH_SAMPLES; k++) {
+        KalmanCv2d_Update(&kalman, meas[k], 1000U + k * BENCH_FRAME_MS);
+        out_kalman[k] = KalmanCv2d_GetPosition(&kalman);
+    }
+    uint64_t t2 = SimTest_NowCycles();
+
+    double rms_median = Bench_Rms(out_median);
+    double rms_kalman = Bench_Rms(out_kalman);
+    printf("median: %.1f cycles/update rms=%.2fpx\n", (double)(t1 - t0) / BENCH_SAMPLES,
+           rms_median);
+    printf("kalman: %.1f cycles/update rms=%.2fpx outliers=%lu\n",
+           (double)(t2 - t1) / BENCH_SAMPLES, rms_kalman, (unsigned long)kalman.outliers);
+    SIM_CHECK(rms_median < 20.0);
+    SIM_CHECK(rms_kalman < 20.0);
+    // 离群点全部被门限拒绝
+    SIM_CHECK(kalman.outliers >= BENCH_SAMPLES / BENCH_OUTLIER_EVERY);
+}
+
+/**
+ * @brief 按下并松开一个按键，按键任务每10ms运行一次
+ */
+static void Bench_PressKey(uint8_t key)
+{
+    FakeKeypad_Press(key);
+    for (uint8_t i = 0; i < 5; i++) {
+        FakeHal_Advance(10);
+        Key_Proc();
+    }
+    FakeKeypad_Release();
+    for (uint8_t i = 0; i < 5; i++) {
+        FakeHal_Advance(10);
+        Key_Proc();
+    }
+}
+
+static void Test_KeyS3Toggle(void)
+{
+    FakeHal_Reset();
+    SIM_CHECK_EQ(Uart_GetFilterMode(), UART_FILTER_MEDIAN);
+    Bench_PressKey(3);
+    SIM_CHECK_EQ(Uart_GetFilterMode(), UART_FILTER_KALMAN);
+    Bench_PressKey(3);
+    SIM_CHECK_EQ(Uart_GetFilterMode(), UART_FILTER_MEDIAN);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_FilterCost);
+    SIM_RUN(Test_KeyS3Toggle);
+    return SIM_RESULT();
+}
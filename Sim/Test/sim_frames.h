@@ -0,0 +1,88 @@
+/**
+ * @file sim_frames.h
+ * @author Shiki
+ * @brief 构造视觉数据帧（与command.c、vision_packet.c的格式一致），供测试和仿真使用
+ *        旧格式：0xAA + 长度 + X(2) + Y(2) + 累加和
+ *        v2格式：0xAB + 长度 + 0x02 + 帧序号(2) + 时间戳(4) + 置信度 + 标志 + 点数 + 点 + CRC-16
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __SIM_FRAMES_H
+#define __SIM_FRAMES_H
+
+#include <stdint.h>
+
+#include "laser_shot_common.h"
+
+#define SIM_FRAME_V1_LEN 7
+
+static inline uint16_t SimFrame_Crc16(const uint8_t *data, uint8_t len)
+{
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 旧格式帧，(0,0)表示未检测到目标
+ * @return 帧长度
+ */
+static inline uint8_t SimFrame_V1(uint8_t *buf, uint16_t x, uint16_t y)
+{
+    buf[0] = 0xAA;
+    buf[1] = SIM_FRAME_V1_LEN;
+    buf[2] = (uint8_t)(x >> 8);
+    buf[3] = (uint8_t)x;
+    buf[4] = (uint8_t)(y >> 8);
+    buf[5] = (uint8_t)y;
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < SIM_FRAME_V1_LEN - 1; i++) {
+        sum += buf[i];
+    }
+    buf[6] = sum;
+    return SIM_FRAME_V1_LEN;
+}
+
+/**
+ * @brief v2格式帧，count可超过VISION_MAX_POINTS（用于测试解析器拒绝）
+ * @return 帧长度
+ */
+static inline uint8_t SimFrame_V2(uint8_t *buf, uint16_t seq, uint32_t timestamp,
+                                  uint8_t confidence, uint8_t flags, const PixelPoint_t *points,
+                                  uint8_t count)
+{
+    uint8_t len = (uint8_t)(12 + count * 4 + 2);
+    buf[0] = 0xAB;
+    buf[1] = len;
+    buf[2] = 0x02;
+    buf[3] = (uint8_t)(seq >> 8);
+    buf[4] = (uint8_t)seq;
+    buf[5] = (uint8_t)(timestamp >> 24);
+    buf[6] = (uint8_t)(timestamp >> 16);
+    buf[7] = (uint8_t)(timestamp >> 8);
+    buf[8] = (uint8_t)timestamp;
+    buf[9] = confidence;
+    buf[10] = flags;
+    buf[11] = count;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t *p = &buf[12 + i * 4];
+        p[0] = (uint8_t)(points[i].x >> 8);
+        p[1] = (uint8_t)points[i].x;
+        p[2] = (uint8_t)(points[i].y >> 8);
+        p[3] = (uint8_t)points[i].y;
+    }
+    uint16_t crc = SimFrame_Crc16(buf, (uint8_t)(len - 2));
+    buf[len - 2] = (uint8_t)(crc >> 8);
+    buf[len - 1] = (uint8_t)crc;
+    return len;
+}
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file sim_test.h
+ * @author Shiki
+ * @brief 主机测试的断言和计时工具
+ *        SIM_CHECK系列失败时打印位置并计数，测试函数继续执行；main最后返回SIM_RESULT()。
+ *        SimTest_NowNs()为单调时钟，基准测试用它计算每次调用的耗时；SimTest_NowCycles()为时间戳计数器。
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef __SIM_TEST_H
+#define __SIM_TEST_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static int sim_test_failures = 0;
+
+#define SIM_CHECK(cond)                                                               \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);          \
+            sim_test_failures++;                                                      \
+        }                                                                             \
+    } while (0)
+
+#define SIM_CHECK_EQ(actual, expected)                                                \
+    do {                                                                              \
+        long long sim_a = (long long)(actual);                                        \
+        long long sim_e = (long long)(expected);                                      \
+        if (sim_a != sim_e) {                                                         \
+            printf("%s:%d: %s == %lld, expected %lld\n", __FILE__, __LINE__, #actual, \
+                   sim_a, sim_e);                                                     \
+            sim_test_failures++;                                                      \
+        }                                                                             \
+    } while (0)
+
+#define SIM_CHECK_NEAR(actual, expected, tol)                                          \
+    do {                                                                               \
+        double sim_a = (double)(actual);                                               \
+        double sim_e = (double)(expected);                                             \
+        if (!(fabs(sim_a - sim_e) <= (double)(tol))) {                                 \
+            printf("%s:%d: %s == %g, expected %g +/- %g\n", __FILE__, __LINE__, #actual, \
+                   sim_a, sim_e, (double)(tol));                                       \
+            sim_test_failures++;                                                       \
+        }                                                                              \
+    } while (0)
+
+#define SIM_RUN(test)                \
+    do {                             \
+        printf("[ RUN ] %s\n", #test); \
+        test();                      \
+    } while (0)
+
+#define SIM_RESULT()                                                     \
+    (printf(sim_test_failures ? "FAILED (%d)\n" : "OK\n", sim_test_failures), \
+     sim_test_failures ? 1 : 0)
+
+static inline uint64_t SimTest_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 主机时间戳计数器（x86-64为TSC，其他平台返回纳秒），基准测试报告每次调用的周期数
+ *        TSC按标称频率计数，与CPU实际频率无关，只用于比较同一台机器上的实现
+ */
+static inline uint64_t SimTest_NowCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return SimTest_NowNs();
+#endif
+}
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file test_aim_calibration.c
+ * @author Shiki
+ * @brief 标定模型换算测试：图像速度经2x2模型的逆换算为两轴转速，未标定时与原来按主方向换算的结果一致，
+ *        带符号、旋转和交叉耦合的模型下换算出的转动恰好抵消图像速度（只取主方向绝对值时方向和大小都错），
+ *        奇异模型拒绝计算
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "aim_calibration.h"
+#include "sim_test.h"
+
+static const float velocities[][2] = {
+    {80.0f, 0.0f}, {0.0f, -120.0f}, {-55.0f, 35.0f}, {300.0f, 210.0f}, {0.0f, 0.0f}};
+
+/**
+ * @brief 转速(脉冲/s)在图像中引起的速度
+ */
+static void Model_Apply(const float clk_vel[2], float image_vel[2])
+{
+    const float(*k)[2] = g_aim_cal_model.px_per_clk;
+    image_vel[0] = k[0][0] * clk_vel[0] + k[0][1] * clk_vel[1];
+    image_vel[1] = k[1][0] * clk_vel[0] + k[1][1] * clk_vel[1];
+}
+
+// 未标定：默认模型两轴独立，转速 = 图像速度/每脉冲像素位移
+static void Test_DefaultModel(void)
+{
+    SIM_CHECK(!g_aim_cal_model.valid);
+    for (uint8_t i = 0; i < sizeof(velocities) / sizeof(velocities[0]); i++) {
+        float clk_vel[2];
+        SIM_CHECK(AimCal_PixelVelToClkVel(-velocities[i][0], -velocities[i][1], clk_vel));
+        SIM_CHECK_NEAR(clk_vel[0], velocities[i][0] / AIM_CAL_DEFAULT_PX_PER_CLK, 1e-3f);
+        SIM_CHECK_NEAR(clk_vel[1], velocities[i][1] / AIM_CAL_DEFAULT_PX_PER_CLK, 1e-3f);
+    }
+}
+
+// 相机相对电机轴旋转30°，X轴方向与图像x相反，两轴每脉冲位移不同
+static void Test_CoupledModel(void)
+{
+    const float c = cosf(30.0f * 3.14159265f / 180.0f);
+    const float s = sinf(30.0f * 3.14159265f / 180.0f);
+    const AimCalModel_t saved = g_aim_cal_model;
+    g_aim_cal_model.px_per_clk[0][0] = -0.42f * c;
+    g_aim_cal_model.px_per_clk[1][0] = -0.42f * s;
+    g_aim_cal_model.px_per_clk[0][1] = -0.31f * s;
+    g_aim_cal_model.px_per_clk[1][1] = 0.31f * c;
+    g_aim_cal_model.valid = true;
+
+    float worst_diag = 0.0f;
+    for (uint8_t i = 0; i < sizeof(velocities) / sizeof(velocities[0]); i++) {
+        float clk_vel[2], cancel[2];
+        SIM_CHECK(AimCal_PixelVelToClkVel(-velocities[i][0], -velocities[i][1], clk_vel));
+        Model_Apply(clk_vel, cancel);
+        SIM_CHECK_NEAR(cancel[0], -velocities[i][0], 1e-3f);
+        SIM_CHECK_NEAR(cancel[1], -velocities[i][1], 1e-3f);
+
+        // 只用主方向绝对值换算时剩余的图像速度
+        float diag[2] = {velocities[i][0] / fabsf(g_aim_cal_model.px_per_clk[0][0]),
+                         velocities[i][1] / fabsf(g_aim_cal_model.px_per_clk[1][1])};
+        float diag_image[2];
+        Model_Apply(diag, diag_image);
+        float residual = hypotf(diag_image[0] + velocities[i][0], diag_image[1] + velocities[i][1]);
+        if (residual > worst_diag) {
+            worst_diag = residual;
+        }
+    }
+    printf("diagonal-only feed-forward leaves up to %.1f px/s\n", worst_diag);
+    SIM_CHECK(worst_diag > 100.0f);
+
+    g_aim_cal_model = saved;
+}
+
+static void Test_SingularModel(void)
+{
+    const AimCalModel_t saved = g_aim_cal_model;
+    // 两轴在图像中的运动方向相同
+    g_aim_cal_model.px_per_clk[0][0] = 0.4f;
+    g_aim_cal_model.px_per_clk[1][0] = 0.2f;
+    g_aim_cal_model.px_per_clk[0][1] = 0.8f;
+    g_aim_cal_model.px_per_clk[1][1] = 0.4f;
+    float clk_vel[2];
+    SIM_CHECK(!AimCal_PixelVelToClkVel(10.0f, 10.0f, clk_vel));
+    SIM_CHECK(!AimCal_PixelVelToClkVel(10.0f, 10.0f, NULL));
+    g_aim_cal_model = saved;
+}
+
+int main(void)
+{
+    SIM_RUN(Test_DefaultModel);
+    SIM_RUN(Test_CoupledModel);
+    SIM_RUN(Test_SingularModel);
+    return SIM_RESULT();
+}
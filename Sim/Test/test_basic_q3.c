@@ -0,0 +1,98 @@
+/**
+ * @file test_basic_q3.c
+ * @author Shiki
+ * @brief Q3任务测试：Task_BasicQ3_Execute不阻塞（虚拟时间不在任务中推进），
+ *        回零、步进搜索、找到目标后停止并进入追踪，电机命令经发送队列发出
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "Emm_V5.h"
+#include "command.h"
+#include "fake_hal.h"
+#include "gimbal_motion.h"
+#include "laser_shot_common.h"
+#include "sim_frames.h"
+#include "sim_test.h"
+#include "tim.h"
+
+#define Q3_TASK_PERIOD_MS 20
+
+/**
+ * @brief 在USART1发送记录中查找一帧命令
+ * @return 帧在记录中的偏移，找不到返回-1
+ */
+static int32_t Find_TxFrame(const uint8_t *frame, uint32_t frame_len, uint32_t from)
+{
+    uint32_t len = 0;
+    const uint8_t *tx = FakeHal_GetTxData(&huart1, &len);
+    for (uint32_t i = from; i + frame_len <= len; i++) {
+        if (memcmp(tx + i, frame, frame_len) == 0) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 按任务周期运行Q3任务，检查每次执行都不推进虚拟时间
+ * @param x,y 每个周期发送的目标坐标，(0,0)表示不发送
+ */
+static void Run_Q3(uint32_t ms, uint16_t x, uint16_t y)
+{
+    uint8_t frame[SIM_FRAME_V1_LEN];
+    for (uint32_t t = 0; t < ms; t += Q3_TASK_PERIOD_MS) {
+        if (x != 0 || y != 0) {
+            SimFrame_V1(frame, x, y);
+            FakeHal_UartReceive(&huart2, frame, sizeof(frame));
+        }
+        uint64_t before = FakeHal_GetTimeUs();
+        Task_BasicQ3_Execute();
+        SIM_CHECK_EQ(FakeHal_GetTimeUs(), before);
+        FakeHal_Advance(Q3_TASK_PERIOD_MS);
+    }
+}
+
+static void Test_SearchStopTrack(void)
+{
+    FakeHal_Reset();
+    GimbalMotion_Init();
+    Command_StartReceive(&huart2);
+    HAL_TIM_Base_Start_IT(&htim6);
+    FakeHal_Advance(100);
+
+    Task_BasicQ3_Start();
+    // 初始检测期内没有目标：X轴回零，回零等待结束后开始步进搜索
+    Run_Q3(600, 0, 0);
+    const uint8_t origin[5] = {STEP_MOTOR_X, 0x9A, 1, 0x00, 0x6B};
+    SIM_CHECK(Find_TxFrame(origin, sizeof(origin), 0) >= 0);
+    const uint8_t first_step[13] = {STEP_MOTOR_X, 0xFD, DIR_CCW, 0x00, 20, 10,
+                                    0x00,         0x00, 0x00, 100, 0x00, 0x00, 0x6B};
+    SIM_CHECK(Find_TxFrame(first_step, sizeof(first_step), 0) >= 0);
+    SIM_CHECK(Task_BasicQ3_IsRunning());
+
+    // 目标出现：X轴立即停止，等待后进入追踪，发出双轴运动命令
+    uint32_t before_stop = FakeHal_GetTxTotal(&huart1);
+    Run_Q3(40, g_sensor_aim_x + 100, g_sensor_aim_y + 100);
+    const uint8_t stop[5] = {STEP_MOTOR_X, 0xFE, 0x98, 0x00, 0x6B};
+    int32_t stop_pos = Find_TxFrame(stop, sizeof(stop), 0);
+    SIM_CHECK(stop_pos >= (int32_t)before_stop);
+
+    uint32_t after_stop = FakeHal_GetTxTotal(&huart1);
+    Run_Q3(100, g_sensor_aim_x + 100, g_sensor_aim_y + 100);
+    SIM_CHECK(FakeHal_GetTxTotal(&huart1) > after_stop);
+    SIM_CHECK(Task_BasicQ3_IsRunning());
+
+    Task_BasicQ3_Stop();
+    HAL_TIM_Base_Stop_IT(&htim6);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_SearchStopTrack);
+    return SIM_RESULT();
+}
@@ -0,0 +1,261 @@
+/**
+ * @file test_emm_feedback.c
+ * @author Shiki
+ * @brief 电机应答解析测试：经FakeHal_UartReceive()写入USART1 DMA循环缓冲区，
+ *        按地址分发快照、逐字节到达的分包、帧尾错误后重新同步、跨越缓冲区末尾的帧、
+ *        定时返回历史样本的顺序和新鲜度
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "emm_feedback.h"
+#include "fake_hal.h"
+#include "sim_test.h"
+#include "usart.h"
+
+/**
+ * @brief 实时位置应答：地址 + 0x36 + 符号 + 位置(4) + 0x6B
+ */
+static uint8_t Frame_Position(uint8_t *buf, uint8_t addr, int32_t position)
+{
+    uint32_t mag = (uint32_t)((position < 0) ? -position : position);
+    buf[0] = addr;
+    buf[1] = 0x36;
+    buf[2] = (position < 0) ? 1 : 0;
+    buf[3] = (uint8_t)(mag >> 24);
+    buf[4] = (uint8_t)(mag >> 16);
+    buf[5] = (uint8_t)(mag >> 8);
+    buf[6] = (uint8_t)mag;
+    buf[7] = 0x6B;
+    return 8;
+}
+
+/**
+ * @brief 实时转速应答：地址 + 0x35 + 符号 + 转速(2) + 0x6B
+ */
+static uint8_t Frame_Velocity(uint8_t *buf, uint8_t addr, int16_t rpm)
+{
+    uint16_t mag = (uint16_t)((rpm < 0) ? -rpm : rpm);
+    buf[0] = addr;
+    buf[1] = 0x35;
+    buf[2] = (rpm < 0) ? 1 : 0;
+    buf[3] = (uint8_t)(mag >> 8);
+    buf[4] = (uint8_t)mag;
+    buf[5] = 0x6B;
+    return 6;
+}
+
+static void Receive(const uint8_t *data, uint16_t len)
+{
+    SIM_CHECK(FakeHal_UartReceive(&huart1, data, len));
+}
+
+static void Setup(void)
+{
+    FakeHal_Reset();
+    FakeHal_SetTick(1000);
+    EmmFeedback_Init();
+}
+
+// 不同地址的应答写入各自的快照，状态标志和控制命令应答一并解析
+static void Test_DemuxByAddress(void)
+{
+    Setup();
+    uint8_t buf[64];
+    uint8_t len = 0;
+    len += Frame_Position(buf + len, STEP_MOTOR_X, 123456);
+    len += Frame_Position(buf + len, STEP_MOTOR_Y, -65536);
+    len += Frame_Velocity(buf + len, STEP_MOTOR_X, -42);
+    const uint8_t flags_y[4] = {STEP_MOTOR_Y, 0x3A, EMM_FB_FLAG_ENABLED | EMM_FB_FLAG_IN_POSITION,
+                                0x6B};
+    memcpy(buf + len, flags_y, sizeof(flags_y));
+    len += sizeof(flags_y);
+    const uint8_t ack_x[4] = {STEP_MOTOR_X, 0xFD, 0x02, 0x6B};
+    memcpy(buf + len, ack_x, sizeof(ack_x));
+    len += sizeof(ack_x);
+    Receive(buf, len);
+
+    EmmFeedback_t x, y;
+    SIM_CHECK(EmmFeedback_Get(STEP_MOTOR_X, &x));
+    SIM_CHECK(EmmFeedback_Get(STEP_MOTOR_Y, &y));
+    SIM_CHECK_EQ(x.position, 123456);
+    SIM_CHECK_EQ(x.velocity, -42);
+    SIM_CHECK_EQ(x.last_ack, 0x02);
+    SIM_CHECK_EQ(x.valid, EMM_FB_VALID_POS | EMM_FB_VALID_VEL);
+    SIM_CHECK_EQ(y.position, -65536);
+    SIM_CHECK_EQ(y.flags, EMM_FB_FLAG_ENABLED | EMM_FB_FLAG_IN_POSITION);
+    SIM_CHECK_EQ(y.valid, EMM_FB_VALID_POS | EMM_FB_VALID_FLAG);
+    SIM_CHECK_EQ(y.update_tick, 1000);
+
+    // 没有收到过应答的地址和无效地址
+    EmmFeedback_t other;
+    SIM_CHECK(!EmmFeedback_Get(3, &other));
+    SIM_CHECK(!EmmFeedback_Get(0, &other));
+    SIM_CHECK(!EmmFeedback_Get(EMM_FB_MAX_ADDR + 1, &other));
+
+    EmmFeedbackStats_t stats;
+    EmmFeedback_GetStats(&stats);
+    SIM_CHECK_EQ(stats.frames, 5);
+    SIM_CHECK_EQ(stats.resync, 0);
+}
+
+// 逐字节到达（每个字节触发一次空闲事件），帧完整前不解析
+static void Test_SplitFrame(void)
+{
+    Setup();
+    uint8_t buf[8];
+    uint8_t len = Frame_Position(buf, STEP_MOTOR_X, 777);
+    for (uint8_t i = 0; i < len; i++) {
+        EmmFeedbackStats_t stats;
+        EmmFeedback_GetStats(&stats);
+        SIM_CHECK_EQ(stats.frames, 0);
+        Receive(&buf[i], 1);
+    }
+
+    EmmFeedback_t x;
+    SIM_CHECK(EmmFeedback_Get(STEP_MOTOR_X, &x));
+    SIM_CHECK_EQ(x.position, 777);
+    EmmFeedbackStats_t stats;
+    EmmFeedback_GetStats(&stats);
+    SIM_CHECK_EQ(stats.frames, 1);
+    SIM_CHECK_EQ(stats.resync, 0);
+}
+
+// 帧尾不是0x6B的帧逐字节丢弃，其后的正确帧仍被解析，错误帧的数据不写入快照
+static void Test_BadChecksum(void)
+{
+    Setup();
+    uint8_t buf[32];
+    uint8_t len = Frame_Position(buf, STEP_MOTOR_X, 5000);
+    buf[len - 1] = 0x6A;
+    len += Frame_Velocity(buf + len, STEP_MOTOR_X, 15);
+    Receive(buf, len);
+
+    EmmFeedback_t x;
+    SIM_CHECK(EmmFeedback_Get(STEP_MOTOR_X, &x));
+    SIM_CHECK_EQ(x.valid, EMM_FB_VALID_VEL);
+    SIM_CHECK_EQ(x.position, 0);
+    SIM_CHECK_EQ(x.velocity, 15);
+
+    EmmFeedbackStats_t stats;
+    EmmFeedback_GetStats(&stats);
+    SIM_CHECK_EQ(stats.frames, 1);
+    SIM_CHECK_EQ(stats.resync, 8);
+
+    // 未知地址、未知功能码同样重新同步
+    const uint8_t junk[3] = {0x09, 0x36, 0x00};
+    Receive(junk, sizeof(junk));
+    len = Frame_Position(buf, STEP_MOTOR_Y, 42);
+    Receive(buf, len);
+    EmmFeedback_t y;
+    SIM_CHECK(EmmFeedback_Get(STEP_MOTOR_Y, &y));
+    SIM_CHECK_EQ(y.position, 42);
+}
+
+// 累计写入超过缓冲区大小，其中一帧跨越缓冲区末尾，分两段到达
+static void Test_Wraparound(void)
+{
+    Setup();
+    uint8_t buf[8];
+    // 6字节的转速帧，第22帧（126~131字节）跨越128字节的末尾
+    for (int16_t n = 0; n < 21; n++) {
+        uint8_t len = Frame_Velocity(buf, (n % 2) ? STEP_MOTOR_Y : STEP_MOTOR_X, n);
+        Receive(buf, len);
+    }
+    uint8_t len = Frame_Position(buf, STEP_MOTOR_X, -31415);
+    Receive(buf, 3);
+    EmmFeedback_t x;
+    EmmFeedback_Get(STEP_MOTOR_X, &x);
+    SIM_CHECK(!(x.valid & EMM_FB_VALID_POS));
+    Receive(buf + 3, (uint16_t)(len - 3));
+
+    SIM_CHECK(EmmFeedback_Get(STEP_MOTOR_X, &x));
+    SIM_CHECK_EQ(x.position, -31415);
+    SIM_CHECK_EQ(x.velocity, 20);
+    EmmFeedback_t y;
+    SIM_CHECK(EmmFeedback_Get(STEP_MOTOR_Y, &y));
+    SIM_CHECK_EQ(y.velocity, 19);
+
+    // 再写满一圈，解析位置始终跟随DMA写入位置
+    for (int16_t n = 0; n < 30; n++) {
+        len = Frame_Velocity(buf, STEP_MOTOR_Y, (int16_t)(-n));
+        Receive(buf, len);
+    }
+    SIM_CHECK(EmmFeedback_Get(STEP_MOTOR_Y, &y));
+    SIM_CHECK_EQ(y.velocity, -29);
+
+    EmmFeedbackStats_t stats;
+    EmmFeedback_GetStats(&stats);
+    SIM_CHECK_EQ(stats.frames, 21 + 1 + 30);
+    SIM_CHECK_EQ(stats.resync, 0);
+}
+
+// 位置样本按地址存入历史，最新的在前，超过EMM_FB_HISTORY_LEN时覆盖最旧的
+static void Test_History(void)
+{
+    Setup();
+    uint8_t buf[16];
+    for (int32_t n = 0; n < EMM_FB_HISTORY_LEN + 3; n++) {
+        uint8_t len = Frame_Velocity(buf, STEP_MOTOR_X, (int16_t)(10 + n));
+        len += Frame_Position(buf + len, STEP_MOTOR_X, n * 100);
+        Receive(buf, len);
+        len = Frame_Position(buf, STEP_MOTOR_Y, -n);
+        Receive(buf, len);
+        FakeHal_Advance(30);
+    }
+
+    EmmFeedbackSample_t samples[EMM_FB_HISTORY_LEN + 2];
+    uint8_t count = EmmFeedback_GetHistory(STEP_MOTOR_X, samples, EMM_FB_HISTORY_LEN + 2);
+    SIM_CHECK_EQ(count, EMM_FB_HISTORY_LEN);
+    int32_t last = EMM_FB_HISTORY_LEN + 2;
+    for (uint8_t i = 0; i < count; i++) {
+        SIM_CHECK_EQ(samples[i].position, (last - i) * 100);
+        SIM_CHECK_EQ(samples[i].velocity, 10 + last - i);
+        SIM_CHECK_EQ(samples[i].tick, 1000 + (uint32_t)(last - i) * 30);
+    }
+
+    SIM_CHECK_EQ(EmmFeedback_GetHistory(STEP_MOTOR_Y, samples, 2), 2);
+    SIM_CHECK_EQ(samples[0].position, -last);
+    SIM_CHECK_EQ(samples[1].position, -(last - 1));
+    SIM_CHECK_EQ(EmmFeedback_GetHistory(3, samples, 2), 0);
+
+    // 最新样本在30ms前
+    SIM_CHECK(EmmFeedback_IsFresh(STEP_MOTOR_X, 30));
+    SIM_CHECK(!EmmFeedback_IsFresh(STEP_MOTOR_X, 29));
+    SIM_CHECK(!EmmFeedback_IsFresh(3, 1000));
+}
+
+// 接收错误后重新启动接收，之后的帧从缓冲区起点开始解析
+static void Test_ErrorRestart(void)
+{
+    Setup();
+    uint8_t buf[8];
+    uint8_t len = Frame_Position(buf, STEP_MOTOR_X, 1);
+    Receive(buf, 5);
+    FakeHal_UartError(&huart1);
+    len = Frame_Position(buf, STEP_MOTOR_X, 2);
+    Receive(buf, len);
+
+    EmmFeedback_t x;
+    SIM_CHECK(EmmFeedback_Get(STEP_MOTOR_X, &x));
+    SIM_CHECK_EQ(x.position, 2);
+    EmmFeedbackStats_t stats;
+    EmmFeedback_GetStats(&stats);
+    SIM_CHECK_EQ(stats.rx_errors, 1);
+    SIM_CHECK_EQ(stats.frames, 1);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_DemuxByAddress);
+    SIM_RUN(Test_SplitFrame);
+    SIM_RUN(Test_BadChecksum);
+    SIM_RUN(Test_Wraparound);
+    SIM_RUN(Test_History);
+    SIM_RUN(Test_ErrorRestart);
+    return SIM_RESULT();
+}
@@ -0,0 +1,163 @@
+/**
+ * @file test_fake_hal.c
+ * @author Shiki
+ * @brief HAL替身自测：虚拟时间下的调度器、USART1发送捕获与队列、USART2 DMA循环接收、矩阵键盘
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "Emm_V5.h"
+#include "command.h"
+#include "fake_hal.h"
+#include "fake_keypad.h"
+#include "key.h"
+#include "sim_frames.h"
+#include "sim_test.h"
+#include "task_scheduler.h"
+#include "tim.h"
+#include "vision_packet.h"
+
+static uint32_t fast_runs = 0;
+static uint32_t slow_runs = 0;
+
+static void Fast_Task(void)
+{
+    fast_runs++;
+}
+
+static void Slow_Task(void)
+{
+    slow_runs++;
+}
+
+static void Test_TickAndDelay(void)
+{
+    FakeHal_Reset();
+    SIM_CHECK_EQ(HAL_GetTick(), 0);
+    FakeHal_Advance(5);
+    SIM_CHECK_EQ(HAL_GetTick(), 5);
+    // 与HAL库相同，HAL_Delay(n)至少等待n+1ms
+    HAL_Delay(10);
+    SIM_CHECK_EQ(HAL_GetTick(), 16);
+    FakeHal_AdvanceUs(999);
+    SIM_CHECK_EQ(HAL_GetTick(), 16);
+    FakeHal_AdvanceUs(1);
+    SIM_CHECK_EQ(HAL_GetTick(), 17);
+}
+
+static void Test_SchedulerVirtualTime(void)
+{
+    FakeHal_Reset();
+    TaskScheduler_SetTickSource(NULL);
+    TaskScheduler_Init();
+    fast_runs = 0;
+    slow_runs = 0;
+    SIM_CHECK_EQ(TaskScheduler_AddTask(Fast_Task, 10, TASK_PRIORITY_NORMAL, "Fast"), HAL_OK);
+    SIM_CHECK_EQ(TaskScheduler_AddTask(Slow_Task, 30, TASK_PRIORITY_HIGH, "Slow"), HAL_OK);
+
+    // 虚拟时间下运行1s，主循环每次推进1ms
+    for (uint32_t i = 0; i < 1000; i++) {
+        TaskScheduler_Run();
+        FakeHal_Advance(1);
+    }
+    SIM_CHECK_NEAR(fast_runs, 100, 1);
+    SIM_CHECK_NEAR(slow_runs, 33, 1);
+
+    TaskScheduler_DeleteTask("Fast");
+    TaskScheduler_DeleteTask("Slow");
+}
+
+static void Test_UartTxCapture(void)
+{
+    FakeHal_Reset();
+
+    Emm_V5_Pos_Control(STEP_MOTOR_X, DIR_CCW, 300, 10, 0x01020304, false, false);
+    Emm_V5_Stop_Now(STEP_MOTOR_Y, false);
+
+    // 第一帧已启动DMA，第二帧在队列中等待发送完成
+    uint32_t len = 0;
+    const uint8_t *tx = FakeHal_GetTxData(&huart1, &len);
+    SIM_CHECK_EQ(len, 13);
+    SIM_CHECK_EQ(FakeHal_GetTxFrames(&huart1), 1);
+    const uint8_t pos_frame[13] = {STEP_MOTOR_X, 0xFD, DIR_CCW, 0x01, 0x2C, 10, 0x01,
+                                   0x02,         0x03, 0x04,    0x00, 0x00, 0x6B};
+    SIM_CHECK(memcmp(tx, pos_frame, sizeof(pos_frame)) == 0);
+    SIM_CHECK_EQ(huart1.gState, HAL_UART_STATE_BUSY_TX);
+
+    // 13字节在115200波特率下约1.13ms
+    FakeHal_AdvanceUs(1000);
+    SIM_CHECK_EQ(FakeHal_GetTxFrames(&huart1), 1);
+    FakeHal_AdvanceUs(200);
+    tx = FakeHal_GetTxData(&huart1, &len);
+    SIM_CHECK_EQ(FakeHal_GetTxFrames(&huart1), 2);
+    SIM_CHECK_EQ(len, 18);
+    const uint8_t stop_frame[5] = {STEP_MOTOR_Y, 0xFE, 0x98, 0x00, 0x6B};
+    SIM_CHECK(memcmp(tx + 13, stop_frame, sizeof(stop_frame)) == 0);
+
+    FakeHal_Advance(1);
+    SIM_CHECK_EQ(huart1.gState, HAL_UART_STATE_READY);
+    Emm_V5_TxStats_t stats;
+    Emm_V5_TxQueue_GetStats(&stats);
+    SIM_CHECK_EQ(stats.pending, 0);
+}
+
+static void Test_UartRxDma(void)
+{
+    FakeHal_Reset();
+    Command_StartReceive(&huart2);
+    HAL_TIM_Base_Start_IT(&htim6);
+
+    uint8_t frame[SIM_FRAME_V1_LEN];
+    SimFrame_V1(frame, 120, 95);
+    FakeHal_Advance(3);
+    SIM_CHECK(FakeHal_UartReceive(&huart2, frame, sizeof(frame)));
+    SIM_CHECK_EQ(Command_GetRxTick(), 3);
+
+    // TIM6中断中的Uart_DataProcess解析数据包
+    FakeHal_Advance(25);
+    SIM_CHECK(VisionPacket_TargetDetected());
+    SIM_CHECK_EQ(g_vision_packet.points[0].x, 120);
+    SIM_CHECK_EQ(g_vision_packet.points[0].y, 95);
+    SIM_CHECK_EQ(g_vision_packet.rx_tick, 3);
+
+    // 循环缓冲区回绕后仍能解析
+    for (uint16_t i = 0; i < 100; i++) {
+        SimFrame_V1(frame, (uint16_t)(i + 1), 50);
+        FakeHal_UartReceive(&huart2, frame, sizeof(frame));
+        FakeHal_Advance(10);
+    }
+    SIM_CHECK_EQ(g_vision_packet.points[0].x, 100);
+    CommandStats_t stats;
+    Command_GetStats(&stats);
+    SIM_CHECK_EQ(stats.overruns, 0);
+    HAL_TIM_Base_Stop_IT(&htim6);
+}
+
+static void Test_Keypad(void)
+{
+    FakeHal_Reset();
+    SIM_CHECK_EQ(Matrix_Key_Scan(), KEY_NONE);
+    FakeKeypad_Press(7);
+    SIM_CHECK_EQ(Matrix_Key_Scan(), KEY_S7);
+    FakeKeypad_Press(16);
+    SIM_CHECK_EQ(Matrix_Key_Scan(), KEY_S16);
+    FakeKeypad_Release();
+    SIM_CHECK_EQ(Matrix_Key_Scan(), KEY_NONE);
+    // 扫描结束后所有行恢复高电平
+    SIM_CHECK_EQ(FakeHal_GetOutput(ROW1_GPIO_Port, ROW1_Pin), GPIO_PIN_SET);
+    SIM_CHECK_EQ(FakeHal_GetOutput(ROW4_GPIO_Port, ROW4_Pin), GPIO_PIN_SET);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_TickAndDelay);
+    SIM_RUN(Test_SchedulerVirtualTime);
+    SIM_RUN(Test_UartTxCapture);
+    SIM_RUN(Test_UartRxDma);
+    SIM_RUN(Test_Keypad);
+    return SIM_RESULT();
+}
@@ -0,0 +1,133 @@
+/**
+ * @file test_gimbal_motion.c
+ * @author Shiki
+ * @brief 双轴同步运动测试：相对运动时脉冲数0的轴不发送（只发单轴命令），
+ *        绝对值运动时脉冲数0是回到零点的有效目标，两轴总是打包为一帧多电机命令并触发同步
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "Emm_V5.h"
+#include "fake_hal.h"
+#include "gimbal_motion.h"
+#include "sim_test.h"
+
+#define MOVE_VEL 300
+#define MOVE_ACC 20
+
+/**
+ * @brief 生成一条位置模式命令（13字节）
+ */
+static uint8_t Frame_Pos(uint8_t *buf, uint8_t addr, uint8_t dir, uint32_t clk, bool raF, bool snF)
+{
+    const uint8_t frame[13] = {addr,
+                               0xFD,
+                               dir,
+                               (uint8_t)(MOVE_VEL >> 8),
+                               (uint8_t)MOVE_VEL,
+                               MOVE_ACC,
+                               (uint8_t)(clk >> 24),
+                               (uint8_t)(clk >> 16),
+                               (uint8_t)(clk >> 8),
+                               (uint8_t)clk,
+                               raF,
+                               snF,
+                               0x6B};
+    memcpy(buf, frame, sizeof(frame));
+    return sizeof(frame);
+}
+
+/**
+ * @brief 生成双轴同步运动的发送内容：多电机命令（X、Y带同步标志的位置命令）+ 多机同步触发
+ */
+static uint8_t Frame_Pair(uint8_t *buf, uint8_t dir_x, uint32_t clk_x, uint8_t dir_y,
+                          uint32_t clk_y, bool raF)
+{
+    uint8_t len = 0;
+    buf[len++] = 0x00;
+    buf[len++] = 0xAA;
+    buf[len++] = 0x00;
+    buf[len++] = 2 * 13 + 5;
+    len += Frame_Pos(buf + len, STEP_MOTOR_X, dir_x, clk_x, raF, true);
+    len += Frame_Pos(buf + len, STEP_MOTOR_Y, dir_y, clk_y, raF, true);
+    buf[len++] = 0x6B;
+    const uint8_t sync[4] = {0x00, 0xFF, 0x66, 0x6B};
+    memcpy(buf + len, sync, sizeof(sync));
+    return (uint8_t)(len + sizeof(sync));
+}
+
+/**
+ * @brief 清空发送记录，调用MoveXY并等待发送完成
+ * @return MoveXY的返回值
+ */
+static bool Move(uint8_t dir_x, uint32_t clk_x, uint8_t dir_y, uint32_t clk_y, bool raF)
+{
+    FakeHal_ClearTx(&huart1);
+    bool ok = GimbalMotion_MoveXY(dir_x, clk_x, dir_y, clk_y, MOVE_VEL, MOVE_ACC, raF);
+    FakeHal_Advance(5);
+    SIM_CHECK(GimbalMotion_IsIdle());
+    return ok;
+}
+
+static void Check_Tx(const uint8_t *expected, uint32_t expected_len)
+{
+    uint32_t len = 0;
+    const uint8_t *tx = FakeHal_GetTxData(&huart1, &len);
+    SIM_CHECK_EQ(len, expected_len);
+    SIM_CHECK(len == expected_len && memcmp(tx, expected, len) == 0);
+}
+
+// 相对运动：脉冲数0的轴不动，只发另一轴的单轴命令；两轴均为0时不发送
+static void Test_RelativeZeroAxis(void)
+{
+    uint8_t expected[64];
+    uint8_t len;
+
+    SIM_CHECK(Move(DIR_CCW, 1200, DIR_CW, 0, false));
+    len = Frame_Pos(expected, STEP_MOTOR_X, DIR_CCW, 1200, false, false);
+    Check_Tx(expected, len);
+
+    SIM_CHECK(Move(DIR_CW, 0, DIR_CW, 800, false));
+    len = Frame_Pos(expected, STEP_MOTOR_Y, DIR_CW, 800, false, false);
+    Check_Tx(expected, len);
+
+    SIM_CHECK(Move(DIR_CCW, 300, DIR_CW, 400, false));
+    len = Frame_Pair(expected, DIR_CCW, 300, DIR_CW, 400, false);
+    Check_Tx(expected, len);
+
+    SIM_CHECK(!Move(DIR_CW, 0, DIR_CW, 0, false));
+    Check_Tx(expected, 0);
+}
+
+// 绝对值运动：脉冲数0表示回到零点，两轴都要发送
+static void Test_AbsoluteZeroTarget(void)
+{
+    uint8_t expected[64];
+    uint8_t len;
+
+    SIM_CHECK(Move(DIR_CCW, 1500, DIR_CW, 0, true));
+    len = Frame_Pair(expected, DIR_CCW, 1500, DIR_CW, 0, true);
+    Check_Tx(expected, len);
+
+    SIM_CHECK(Move(DIR_CW, 0, DIR_CCW, 700, true));
+    len = Frame_Pair(expected, DIR_CW, 0, DIR_CCW, 700, true);
+    Check_Tx(expected, len);
+
+    // 两轴都回到零点
+    SIM_CHECK(Move(DIR_CW, 0, DIR_CW, 0, true));
+    len = Frame_Pair(expected, DIR_CW, 0, DIR_CW, 0, true);
+    Check_Tx(expected, len);
+}
+
+int main(void)
+{
+    FakeHal_Reset();
+    GimbalMotion_Init();
+    SIM_RUN(Test_RelativeZeroAxis);
+    SIM_RUN(Test_AbsoluteZeroTarget);
+    return SIM_RESULT();
+}
@@ -0,0 +1,201 @@
+/**
+ * @file test_median_filter.c
+ * @author Shiki
+ * @brief 中值滤波 / Hampel测试：窗口1~15（奇数）的随机序列与每步对窗口排序取中值的参考实现逐个比较；
+ *        MAD为0时的最小门限；串口2上位机指令修改窗口大小和模式
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "command.h"
+#include "host_command.h"
+#include "median_filter.h"
+#include "sim_frames.h"
+#include "sim_test.h"
+#include "uart_user.h"
+
+#define COMPARE_STEPS 20000U
+
+// MAD换算为标准差的系数，与median_filter.c相同
+#define REF_MAD_SCALE 1.4826f
+
+static uint32_t lcg_state = 11;
+
+static uint32_t Random(uint32_t range)
+{
+    lcg_state = lcg_state * 1664525U + 1013904223U;
+    return (lcg_state >> 8) % range;
+}
+
+static int CompareU16(const void *a, const void *b)
+{
+    return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+/**
+ * @brief 参考实现：对最近window个样本排序取中值，Hampel模式再对偏差排序取MAD
+ * @param history 最近window个样本（顺序任意）
+ */
+static uint16_t Reference(const uint16_t *history, uint8_t window, bool hampel, uint16_t value)
+{
+    uint16_t sorted[MEDIAN_FILTER_MAX_WINDOW];
+    memcpy(sorted, history, window * sizeof(uint16_t));
+    qsort(sorted, window, sizeof(uint16_t), CompareU16);
+    uint16_t median = sorted[window / 2];
+    if (!hampel) {
+        return median;
+    }
+
+    uint16_t dev[MEDIAN_FILTER_MAX_WINDOW];
+    for (uint8_t i = 0; i < window; i++) {
+        dev[i] = (history[i] > median) ? history[i] - median : median - history[i];
+    }
+    qsort(dev, window, sizeof(uint16_t), CompareU16);
+    float limit = MEDIAN_FILTER_HAMPEL_K * REF_MAD_SCALE * (float)dev[window / 2];
+    if (limit < MEDIAN_FILTER_HAMPEL_MIN) {
+        limit = MEDIAN_FILTER_HAMPEL_MIN;
+    }
+    uint16_t d = (value > median) ? value - median : median - value;
+    return ((float)d > limit) ? median : value;
+}
+
+/**
+ * @brief 随机游走坐标加小噪声，约5%的样本为离群值，部分区段为常数（MAD为0）
+ */
+static void Compare(uint8_t window, bool hampel)
+{
+    MedianFilter_t filter;
+    SIM_CHECK(MedianFilter_Init(&filter, window, hampel, MEDIAN_FILTER_HAMPEL_K));
+
+    uint16_t history[MEDIAN_FILTER_MAX_WINDOW];
+    uint32_t mismatches = 0;
+    uint32_t replaced = 0;
+    int32_t base = 300;
+    for (uint32_t k = 0; k < COMPARE_STEPS; k++) {
+        base += (int32_t)Random(5) - 2;
+        base = (base < 20) ? 20 : (base > 600) ? 600 : base;
+        uint16_t value;
+        if ((k / 200) % 4 == 3) {
+            value = (uint16_t)base;  // 常数区段
+        } else if (Random(20) == 0) {
+            value = (uint16_t)Random(640);  // 离群值
+        } else {
+            value = (uint16_t)(base + (int32_t)Random(7) - 3);
+        }
+
+        history[k % window] = value;
+        uint16_t out = MedianFilter_Update(&filter, value);
+        uint16_t ref = (k + 1 < window) ? value : Reference(history, window, hampel, value);
+        if (out != ref) {
+            mismatches++;
+        }
+        if (k + 1 >= window && hampel && ref != value) {
+            replaced++;
+        }
+    }
+    SIM_CHECK_EQ(mismatches, 0);
+    if (hampel) {
+        SIM_CHECK_EQ(filter.replaced, replaced);
+    }
+}
+
+static void Test_MedianMatchesSort(void)
+{
+    for (uint8_t window = 1; window <= MEDIAN_FILTER_MAX_WINDOW; window += 2) {
+        Compare(window, false);
+    }
+}
+
+static void Test_HampelMatchesSort(void)
+{
+    for (uint8_t window = 1; window <= MEDIAN_FILTER_MAX_WINDOW; window += 2) {
+        Compare(window, true);
+    }
+}
+
+static void Test_InvalidWindow(void)
+{
+    MedianFilter_t filter;
+    SIM_CHECK(!MedianFilter_Init(&filter, 0, false, MEDIAN_FILTER_HAMPEL_K));
+    SIM_CHECK(!MedianFilter_Init(&filter, 4, false, MEDIAN_FILTER_HAMPEL_K));
+    SIM_CHECK(!MedianFilter_Init(&filter, MEDIAN_FILTER_MAX_WINDOW + 2, false,
+                                 MEDIAN_FILTER_HAMPEL_K));
+}
+
+// 窗口中过半样本相同（MAD为0）时，偏离中值不超过最小门限的样本原样输出，大的离群值仍被替换
+static void Test_HampelZeroMad(void)
+{
+    MedianFilter_t filter;
+    SIM_CHECK(MedianFilter_Init(&filter, 7, true, MEDIAN_FILTER_HAMPEL_K));
+    for (uint8_t i = 0; i < 7; i++) {
+        MedianFilter_Update(&filter, 200);
+    }
+    SIM_CHECK_EQ(MedianFilter_Update(&filter, 201), 201);
+    SIM_CHECK_EQ(MedianFilter_Update(&filter, 198), 198);
+    SIM_CHECK_EQ(MedianFilter_Update(&filter, 260), 200);
+    SIM_CHECK_EQ(filter.replaced, 1);
+}
+
+/**
+ * @brief 构造上位机控制指令帧
+ * @return 帧长度
+ */
+static uint8_t HostFrame(uint8_t *buf, uint8_t id, const uint8_t *param, uint8_t param_len)
+{
+    uint8_t len = HOST_COMMAND_HEAD_LEN + param_len + HOST_COMMAND_CRC_LEN;
+    buf[0] = HOST_COMMAND_HEADER;
+    buf[1] = len;
+    buf[2] = HOST_COMMAND_TYPE;
+    buf[3] = id;
+    memcpy(&buf[HOST_COMMAND_HEAD_LEN], param, param_len);
+    uint16_t crc = SimFrame_Crc16(buf, (uint8_t)(len - 2));
+    buf[len - 2] = (uint8_t)(crc >> 8);
+    buf[len - 1] = (uint8_t)crc;
+    return len;
+}
+
+// 串口2指令修改窗口大小和模式，不合法的参数被拒绝且保持原设置
+static void Test_HostCommand(void)
+{
+    uint8_t frame[16];
+    HostCommandStats_t stats;
+    bool hampel = true;
+    SIM_CHECK_EQ(Uart_GetMedianWindow(&hampel), 3);
+    SIM_CHECK(!hampel);
+
+    const uint8_t set_hampel_9[2] = {9, 1};
+    uint8_t len = HostFrame(frame, HOST_CMD_MEDIAN_WINDOW, set_hampel_9, 2);
+    SIM_CHECK_EQ(Command_Write(frame, len), len);
+    Uart_DataProcess();
+    SIM_CHECK_EQ(Uart_GetMedianWindow(&hampel), 9);
+    SIM_CHECK(hampel);
+
+    const uint8_t even_window[2] = {8, 0};
+    len = HostFrame(frame, HOST_CMD_MEDIAN_WINDOW, even_window, 2);
+    SIM_CHECK_EQ(Command_Write(frame, len), len);
+    Uart_DataProcess();
+    SIM_CHECK_EQ(Uart_GetMedianWindow(&hampel), 9);
+
+    len = HostFrame(frame, 0x7F, even_window, 2);
+    SIM_CHECK_EQ(Command_Write(frame, len), len);
+    Uart_DataProcess();
+
+    HostCommand_GetStats(&stats);
+    SIM_CHECK_EQ(stats.accepted, 1);
+    SIM_CHECK_EQ(stats.rejected, 2);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_MedianMatchesSort);
+    SIM_RUN(Test_HampelMatchesSort);
+    SIM_RUN(Test_InvalidWindow);
+    SIM_RUN(Test_HampelZeroMad);
+    SIM_RUN(Test_HostCommand);
+    return SIM_RESULT();
+}
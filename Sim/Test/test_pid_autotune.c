@@ -0,0 +1,169 @@
+/**
+ * @file test_pid_autotune.c
+ * @author Shiki
+ * @brief 继电反馈自整定测试：对象为K/(τs+1)^3，临界增益Ku=8/K、临界周期Pu=2πτ/√3有解析解，
+ *        检查整定得到的Ku、Pu（描述函数法的近似误差在10%以内），按整定参数闭环阶跃响应稳定、无稳态误差，
+ *        Tyreus–Luyben比Ziegler–Nichols超调小；滞环过大或对象不响应时超时失败
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "pid_autotune.h"
+#include "pid_controller.h"
+#include "sim_test.h"
+
+#define PLANT_GAIN 2.0f
+#define PLANT_TAU 0.1f              // 每一阶的时间常数(s)
+#define PLANT_SUBSTEPS 20           // 每个控制周期内的积分步数
+#define CONTROL_PERIOD_MS 5U
+#define CONTROL_PERIOD_S 0.005f
+#define TUNE_TOLERANCE 0.10f        // Ku、Pu与解析值的相对误差上限
+#define STEP_DURATION_MS 6000U
+#define STEP_TARGET 1.0f
+
+typedef struct {
+    float x[3];  // 三个一阶环节的输出，x[2]为对象输出
+} Plant_t;
+
+/**
+ * @brief 对象前进一个控制周期（零阶保持输入u，欧拉法细分积分）
+ */
+static float Plant_Step(Plant_t *plant, float u)
+{
+    const float h = CONTROL_PERIOD_S / PLANT_SUBSTEPS;
+    for (uint8_t s = 0; s < PLANT_SUBSTEPS; s++) {
+        plant->x[0] += h / PLANT_TAU * (PLANT_GAIN * u - plant->x[0]);
+        plant->x[1] += h / PLANT_TAU * (plant->x[0] - plant->x[1]);
+        plant->x[2] += h / PLANT_TAU * (plant->x[1] - plant->x[2]);
+    }
+    return plant->x[2];
+}
+
+static float Expected_Ku(void)
+{
+    return 8.0f / PLANT_GAIN;
+}
+
+static float Expected_Pu(void)
+{
+    return 2.0f * 3.14159265f * PLANT_TAU / sqrtf(3.0f);
+}
+
+/**
+ * @brief 在对象上运行继电整定直到结束
+ * @param noise 测量噪声幅度（确定性三角波）
+ */
+static AutotuneState_t Run_Autotune(PidAutotune_t *at, AutotuneRule_t rule, float hysteresis,
+                                    float noise, float plant_gain_scale)
+{
+    Plant_t plant = {{0}};
+    uint32_t tick = 1000;
+    float y = 0.0f;
+    PidAutotune_Start(at, 1.0f, hysteresis, rule, tick);
+    while (PidAutotune_GetState(at) == AUTOTUNE_RUNNING) {
+        float measured = y + noise * (float)((int32_t)(tick % 7U) - 3) / 3.0f;
+        float u = PidAutotune_Update(at, 0.0f - measured, tick);  // 目标值为0
+        y = Plant_Step(&plant, u * plant_gain_scale);
+        tick += CONTROL_PERIOD_MS;
+    }
+    return PidAutotune_GetState(at);
+}
+
+/**
+ * @brief 按整定参数闭环单位阶跃响应
+ * @param overshoot 超调量（相对目标值）
+ * @return 最后1s的最大绝对误差
+ */
+static float Run_Step(float kp, float ki, float kd, float *overshoot)
+{
+    PidController_t pid;
+    PID_Init(&pid, PID_TYPE_POSITIONAL);
+    PID_SetParam(&pid, kp, ki, kd);
+    PID_SetOutputLimit(&pid, -10.0f, 10.0f);
+    PID_SetIntegralLimit(&pid, -1000.0f, 1000.0f);
+    PID_SetTarget(&pid, STEP_TARGET);
+
+    Plant_t plant = {{0}};
+    float y = 0.0f;
+    float peak = 0.0f;
+    float tail_error = 0.0f;
+    for (uint32_t t = 0; t < STEP_DURATION_MS; t += CONTROL_PERIOD_MS) {
+        y = Plant_Step(&plant, PID_Compute(&pid, y));
+        if (y > peak) {
+            peak = y;
+        }
+        if (t >= STEP_DURATION_MS - 1000U && fabsf(STEP_TARGET - y) > tail_error) {
+            tail_error = fabsf(STEP_TARGET - y);
+        }
+    }
+    *overshoot = (peak - STEP_TARGET) / STEP_TARGET;
+    return tail_error;
+}
+
+static void Test_KuPu(void)
+{
+    PidAutotune_t at;
+    SIM_CHECK_EQ(Run_Autotune(&at, AUTOTUNE_RULE_ZN, 0.005f, 0.0f, 1.0f), AUTOTUNE_DONE);
+    printf("Ku=%.3f (exact %.3f) Pu=%.4fs (exact %.4fs)\n", at.ku, Expected_Ku(), at.pu,
+           Expected_Pu());
+    SIM_CHECK_NEAR(at.ku, Expected_Ku(), Expected_Ku() * TUNE_TOLERANCE);
+    SIM_CHECK_NEAR(at.pu, Expected_Pu(), Expected_Pu() * TUNE_TOLERANCE);
+
+    // 测量噪声小于滞环时继电不抖动，结果仍在容差内
+    PidAutotune_t noisy;
+    SIM_CHECK_EQ(Run_Autotune(&noisy, AUTOTUNE_RULE_ZN, 0.01f, 0.005f, 1.0f), AUTOTUNE_DONE);
+    printf("noisy: Ku=%.3f Pu=%.4fs\n", noisy.ku, noisy.pu);
+    SIM_CHECK_NEAR(noisy.ku, Expected_Ku(), Expected_Ku() * TUNE_TOLERANCE);
+    SIM_CHECK_NEAR(noisy.pu, Expected_Pu(), Expected_Pu() * TUNE_TOLERANCE);
+}
+
+static void Test_Gains(void)
+{
+    float overshoot[2];
+    for (uint8_t rule = AUTOTUNE_RULE_ZN; rule <= AUTOTUNE_RULE_TL; rule++) {
+        PidAutotune_t at;
+        SIM_CHECK_EQ(Run_Autotune(&at, (AutotuneRule_t)rule, 0.005f, 0.0f, 1.0f), AUTOTUNE_DONE);
+
+        float kp, ki, kd;
+        SIM_CHECK(PidAutotune_GetGains(&at, CONTROL_PERIOD_S, &kp, &ki, &kd));
+        // 每采样周期的增益：ki = Kp*Ts/Ti，kd = Kp*Td/Ts
+        float gain = (rule == AUTOTUNE_RULE_TL) ? at.ku / 2.2f : 0.6f * at.ku;
+        float ti = (rule == AUTOTUNE_RULE_TL) ? 2.2f * at.pu : 0.5f * at.pu;
+        float td = (rule == AUTOTUNE_RULE_TL) ? at.pu / 6.3f : 0.125f * at.pu;
+        SIM_CHECK_NEAR(kp, gain, 1e-5f);
+        SIM_CHECK_NEAR(ki, gain * CONTROL_PERIOD_S / ti, 1e-6f);
+        SIM_CHECK_NEAR(kd, gain * td / CONTROL_PERIOD_S, 1e-3f);
+
+        float tail = Run_Step(kp, ki, kd, &overshoot[rule]);
+        printf("%s: kp=%.3f ki=%.5f kd=%.3f overshoot=%.1f%% final error=%.4f\n",
+               (rule == AUTOTUNE_RULE_TL) ? "TL" : "ZN", kp, ki, kd, overshoot[rule] * 100.0f,
+               tail);
+        SIM_CHECK(tail < 0.02f);
+        SIM_CHECK(overshoot[rule] < 0.8f);
+    }
+    SIM_CHECK(overshoot[AUTOTUNE_RULE_TL] < overshoot[AUTOTUNE_RULE_ZN]);
+}
+
+static void Test_Failures(void)
+{
+    PidAutotune_t at;
+    float kp, ki, kd;
+
+    // 滞环大于对象能产生的误差，继电输出不切换，超时
+    SIM_CHECK_EQ(Run_Autotune(&at, AUTOTUNE_RULE_ZN, 5.0f, 0.0f, 1.0f), AUTOTUNE_FAILED);
+    SIM_CHECK(!PidAutotune_GetGains(&at, CONTROL_PERIOD_S, &kp, &ki, &kd));
+
+    // 对象不响应（输入增益为0），超时
+    SIM_CHECK_EQ(Run_Autotune(&at, AUTOTUNE_RULE_ZN, 0.005f, 0.0f, 0.0f), AUTOTUNE_FAILED);
+    SIM_CHECK_EQ(at.cycles, 0);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_KuPu);
+    SIM_RUN(Test_Gains);
+    SIM_RUN(Test_Failures);
+    return SIM_RESULT();
+}
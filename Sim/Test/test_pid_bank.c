@@ -0,0 +1,169 @@
+/**
+ * @file test_pid_bank.c
+ * @author Shiki
+ * @brief PID控制器组测试：各通道与相同配置的位置式PID_Compute()/PID_ComputeDt()逐位一致
+ *        （随机目标、反馈和采样周期，包含输出和积分限幅；默认配置和设定值权重、微分滤波、反算抗饱和），
+ *        并比较整组计算与逐个调用PID_Compute()的耗时
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "pid_bank.h"
+#include "pid_controller.h"
+#include "sim_test.h"
+
+#define COMPARE_STEPS 200000U
+#define BENCH_UPDATES 1000000U
+
+static const float gains[PID_BANK_MAX][3] = {
+    {1.5f, 0.02f, 0.15f},
+    {0.8f, 0.1f, 0.0f},
+    {2.3f, 0.0f, 0.7f},
+    {0.37f, 0.013f, 1.1f},
+};
+
+// 各通道的设定值权重b、c，微分滤波系数，反算抗饱和系数
+static const float options[PID_BANK_MAX][4] = {
+    {0.5f, 0.0f, 0.0f, 0.0f},
+    {1.0f, 1.0f, 0.7f, 0.0f},
+    {1.0f, 1.0f, 0.0f, 0.5f},
+    {0.8f, 0.0f, 0.4f, 1.0f},
+};
+
+static uint32_t lcg_state = 7;
+
+/**
+ * @brief 均匀随机数[-range, range)
+ */
+static float Random(float range)
+{
+    lcg_state = lcg_state * 1664525U + 1013904223U;
+    return ((float)(lcg_state >> 8) / 8388608.0f - 1.0f) * range;
+}
+
+/**
+ * @brief 按相同参数初始化控制器组和N个独立的位置式控制器
+ * @param with_options 为true时各通道按options设置权重、微分滤波和抗饱和，否则保持默认配置
+ */
+static void Setup(PidBank_t *bank, PidController_t *pid, uint8_t size, float sample_time,
+                  bool with_options)
+{
+    PidBank_Init(bank, size);
+    PidBank_SetSampleTime(bank, sample_time);
+    for (uint8_t i = 0; i < size; i++) {
+        PID_Init(&pid[i], PID_TYPE_POSITIONAL);
+        PID_SetSampleTime(&pid[i], sample_time);
+        PID_SetParam(&pid[i], gains[i][0], gains[i][1], gains[i][2]);
+        PidBank_SetParam(bank, i, gains[i][0], gains[i][1], gains[i][2]);
+        // 较小的限制使输出和积分限幅经常生效
+        PID_SetOutputLimit(&pid[i], -300.0f, 250.0f);
+        PidBank_SetOutputLimit(bank, i, -300.0f, 250.0f);
+        PID_SetIntegralLimit(&pid[i], -40.0f, 60.0f);
+        PidBank_SetIntegralLimit(bank, i, -40.0f, 60.0f);
+        if (with_options) {
+            PID_SetSetpointWeight(&pid[i], options[i][0], options[i][1]);
+            PidBank_SetSetpointWeight(bank, i, options[i][0], options[i][1]);
+            PID_SetDerivativeFilter(&pid[i], options[i][2]);
+            PidBank_SetDerivativeFilter(bank, i, options[i][2]);
+            PID_SetAntiWindup(&pid[i], options[i][3]);
+            PidBank_SetAntiWindup(bank, i, options[i][3]);
+        }
+    }
+}
+
+static void Compare(bool use_dt, bool with_options)
+{
+    PidBank_t bank;
+    PidController_t pid[PID_BANK_MAX];
+    Setup(&bank, pid, PID_BANK_MAX, use_dt ? 0.01f : 0.0f, with_options);
+
+    uint32_t mismatches = 0;
+    float current[PID_BANK_MAX];
+    for (uint32_t k = 0; k < COMPARE_STEPS; k++) {
+        // 每隔一段时间改变目标，反馈带噪声
+        if (k % 97 == 0) {
+            for (uint8_t i = 0; i < PID_BANK_MAX; i++) {
+                float target = Random(200.0f);
+                PID_SetTarget(&pid[i], target);
+                PidBank_SetTarget(&bank, i, target);
+            }
+        }
+        for (uint8_t i = 0; i < PID_BANK_MAX; i++) {
+            current[i] = Random(250.0f);
+        }
+        // 包含dt <= 0（第一次计算）和超出PID_DT_RATIO范围的周期
+        float dt = (k % 50 == 0) ? 0.0f : 0.01f + Random(0.03f);
+
+        const float *out = use_dt ? PidBank_ComputeDt(&bank, current, dt)
+                                  : PidBank_Compute(&bank, current);
+        for (uint8_t i = 0; i < PID_BANK_MAX; i++) {
+            float ref = use_dt ? PID_ComputeDt(&pid[i], current[i], dt)
+                               : PID_Compute(&pid[i], current[i]);
+            if (memcmp(&ref, &out[i], sizeof(float)) != 0 ||
+                memcmp(&pid[i].error_sum, &bank.error_sum[i], sizeof(float)) != 0) {
+                mismatches++;
+            }
+        }
+    }
+    SIM_CHECK_EQ(mismatches, 0);
+    SIM_CHECK_EQ(bank.dt_stats.count, pid[0].dt_stats.count);
+}
+
+static void Test_BitExactCompute(void)
+{
+    Compare(false, false);
+}
+
+static void Test_BitExactComputeDt(void)
+{
+    Compare(true, false);
+}
+
+static void Test_BitExactOptions(void)
+{
+    Compare(false, true);
+    Compare(true, true);
+}
+
+// 每次整组计算与逐个调用PID_Compute()的耗时（主机TSC周期）
+static void Test_Cost(void)
+{
+    for (uint8_t size = 1; size <= PID_BANK_MAX; size++) {
+        PidBank_t bank;
+        PidController_t pid[PID_BANK_MAX];
+        Setup(&bank, pid, size, 0.0f, false);
+        float current[PID_BANK_MAX] = {0};
+        volatile float sink = 0.0f;
+
+        uint64_t t0 = SimTest_NowCycles();
+        for (uint32_t k = 0; k < BENCH_UPDATES; k++) {
+            current[0] = (float)(k & 0xFF);
+            sink = PidBank_Compute(&bank, current)[0];
+        }
+        uint64_t t1 = SimTest_NowCycles();
+        for (uint32_t k = 0; k < BENCH_UPDATES; k++) {
+            current[0] = (float)(k & 0xFF);
+            for (uint8_t i = 0; i < size; i++) {
+                sink = PID_Compute(&pid[i], current[i]);
+            }
+        }
+        uint64_t t2 = SimTest_NowCycles();
+        (void)sink;
+
+        printf("channels=%u bank %.1f cycles/update, PID_Compute x%u %.1f cycles/update\n", size,
+               (double)(t1 - t0) / BENCH_UPDATES, size, (double)(t2 - t1) / BENCH_UPDATES);
+    }
+}
+
+int main(void)
+{
+    SIM_RUN(Test_BitExactCompute);
+    SIM_RUN(Test_BitExactComputeDt);
+    SIM_RUN(Test_BitExactOptions);
+    SIM_RUN(Test_Cost);
+    return SIM_RESULT();
+}
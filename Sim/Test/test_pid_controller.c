@@ -0,0 +1,268 @@
+/**
+ * @file test_pid_controller.c
+ * @author Shiki
+ * @brief PID控制器测试：增量式e(k-1)/e(k-2)历史不受积分限幅和PID_Enable(false)影响；
+ *        测量值微分在设定值阶跃时没有微分冲击；反算抗饱和使积分在输出饱和后立即退出；
+ *        PID_ComputeDt()在30ms和60ms周期下积分、微分项相同，周期比限幅，周期统计与两遍法参考值一致
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "pid_controller.h"
+#include "sim_test.h"
+
+#define INC_KP 0.7f
+#define INC_KI 0.2f
+#define INC_KD 0.3f
+
+#define DT_TS 0.03f     // 整定参数时的周期(s)
+#define DT_STEPS 10     // 60ms周期的计算次数
+#define DT_SLOPE 50.0f  // 斜坡测量值的斜率(/s)
+#define DT_ERROR 2.0f   // 恒定误差，积分和不超过默认积分限幅
+
+static const float inc_current[] = {0.0f, 12.0f, 25.0f, 31.0f, 28.0f, 40.0f, 47.0f, 52.0f};
+
+/**
+ * @brief 增量式参考实现：按未限幅的误差历史计算Δu
+ */
+static float IncrementalDelta(float e, float e1, float e2)
+{
+    return INC_KP * (e - e1) + INC_KI * e + INC_KD * (e - 2.0f * e1 + e2);
+}
+
+// 误差远大于积分限幅，且中途禁用再使能，每步输出仍与按完整误差历史计算的结果一致
+static void Test_IncrementalHistory(void)
+{
+    PidController_t pid;
+    PID_Init(&pid, PID_TYPE_INCREMENTAL);
+    PID_SetParam(&pid, INC_KP, INC_KI, INC_KD);
+    PID_SetIntegralLimit(&pid, -0.5f, 0.5f);
+    PID_SetTarget(&pid, 60.0f);
+
+    float e1 = 0.0f, e2 = 0.0f, output = 0.0f;
+    for (uint8_t k = 0; k < sizeof(inc_current) / sizeof(inc_current[0]); k++) {
+        if (k == 4) {
+            // 禁用期间输出为0，误差历史保留
+            PID_Enable(&pid, false);
+            SIM_CHECK_EQ(PID_Compute(&pid, 100.0f), 0);
+            SIM_CHECK_NEAR(pid.error_prev, e1, 1e-6);
+            SIM_CHECK_NEAR(pid.error_prev2, e2, 1e-6);
+            PID_Enable(&pid, true);
+            output = 0.0f;  // 禁用时清零输出，使能后从0开始累加
+        }
+
+        float e = 60.0f - inc_current[k];
+        output += IncrementalDelta(e, e1, e2);
+        SIM_CHECK_NEAR(PID_Compute(&pid, inc_current[k]), output, 1e-4);
+        e2 = e1;
+        e1 = e;
+    }
+    SIM_CHECK_NEAR(pid.error_prev, e1, 1e-6);
+    SIM_CHECK_NEAR(pid.error_prev2, e2, 1e-6);
+}
+
+// 纯微分控制器，反馈不变时目标从0跳到100：c=1产生Kd*100的冲击，c=0（测量值微分）输出为0
+static void Test_DerivativeOnMeasurement(void)
+{
+    PidController_t pid_error, pid_meas;
+    PID_Init(&pid_error, PID_TYPE_POSITIONAL);
+    PID_Init(&pid_meas, PID_TYPE_POSITIONAL);
+    PID_SetParam(&pid_error, 0.0f, 0.0f, 2.0f);
+    PID_SetParam(&pid_meas, 0.0f, 0.0f, 2.0f);
+    PID_SetSetpointWeight(&pid_meas, 1.0f, 0.0f);
+
+    for (uint8_t k = 0; k < 5; k++) {
+        PID_Compute(&pid_error, 5.0f);
+        PID_Compute(&pid_meas, 5.0f);
+    }
+
+    PID_SetTarget(&pid_error, 100.0f);
+    PID_SetTarget(&pid_meas, 100.0f);
+    SIM_CHECK_NEAR(PID_Compute(&pid_error, 5.0f), 200.0f, 1e-4);
+    SIM_CHECK_NEAR(PID_Compute(&pid_meas, 5.0f), 0.0f, 1e-6);
+
+    // 测量值变化时两者的微分项相同
+    SIM_CHECK_NEAR(PID_Compute(&pid_error, 8.0f), -6.0f, 1e-4);
+    SIM_CHECK_NEAR(PID_Compute(&pid_meas, 8.0f), -6.0f, 1e-4);
+
+    // 比例项权重b=0.5：u = Kp*(b*r - y)
+    PidController_t pid_weight;
+    PID_Init(&pid_weight, PID_TYPE_POSITIONAL);
+    PID_SetParam(&pid_weight, 1.0f, 0.0f, 0.0f);
+    PID_SetSetpointWeight(&pid_weight, 0.5f, 1.0f);
+    PID_SetTarget(&pid_weight, 100.0f);
+    SIM_CHECK_NEAR(PID_Compute(&pid_weight, 20.0f), 30.0f, 1e-4);
+}
+
+/**
+ * @brief 误差为+50的饱和阶段后误差变为-5，返回输出仍停在上限的步数
+ */
+static uint32_t SaturatedSteps(float kaw, float *sum_saturated)
+{
+    PidController_t pid;
+    PID_Init(&pid, PID_TYPE_POSITIONAL);
+    PID_SetParam(&pid, 1.0f, 0.5f, 0.0f);
+    PID_SetOutputLimit(&pid, -10.0f, 10.0f);
+    PID_SetIntegralLimit(&pid, -1000.0f, 1000.0f);
+    PID_SetAntiWindup(&pid, kaw);
+
+    for (uint8_t k = 0; k < 40; k++) {
+        SIM_CHECK_NEAR(PID_Compute(&pid, -50.0f), 10.0f, 1e-6);
+    }
+    *sum_saturated = pid.error_sum;
+
+    uint32_t steps = 0;
+    while (steps < 1000 && PID_Compute(&pid, 5.0f) >= 10.0f) {
+        steps++;
+    }
+    return steps;
+}
+
+// 只有积分限幅时积分累加到上限，误差反向后输出仍饱和约两百步；
+// 反算系数为1时积分保持在Ki*∑e = 上限 - Kp*e，误差反向后立即退出饱和
+static void Test_BackCalculationUnwind(void)
+{
+    float sum_plain, sum_aw;
+    uint32_t plain = SaturatedSteps(0.0f, &sum_plain);
+    uint32_t aw = SaturatedSteps(1.0f, &sum_aw);
+    printf("saturated steps after reversal: clamp only %u, back-calculation %u\n", plain, aw);
+
+    SIM_CHECK_NEAR(sum_plain, 1000.0f, 1e-3);
+    SIM_CHECK_NEAR(sum_aw, (10.0f - 50.0f) / 0.5f, 1e-3);
+    SIM_CHECK(plain >= 100);
+    SIM_CHECK_EQ(aw, 0);
+}
+
+/**
+ * @brief 按Ts=30ms整定的控制器以period周期运行，记录每60ms时刻的输出
+ * @param scaled true 使用PID_ComputeDt()，false 使用PID_Compute()
+ * @param slope 测量值y(t) = -slope*t，0时误差恒为DT_ERROR
+ */
+static void DtRun(float period, bool scaled, float ki, float kd, float slope, float *out)
+{
+    PidController_t pid;
+    PID_Init(&pid, PID_TYPE_POSITIONAL);
+    PID_SetParam(&pid, 0.0f, ki, kd);
+    PID_SetSampleTime(&pid, DT_TS);
+
+    uint32_t per_out = (uint32_t)lrintf(0.06f / period);
+    for (uint32_t k = 0; k <= DT_STEPS * per_out; k++) {
+        float t = (float)k * period;
+        float current = (slope != 0.0f) ? -slope * t : -DT_ERROR;
+        // 第一次计算没有上次时刻，dt为0
+        float dt = (k == 0) ? 0.0f : period;
+        float output = scaled ? PID_ComputeDt(&pid, current, dt) : PID_Compute(&pid, current);
+        if (k % per_out == 0) {
+            out[k / per_out] = output;
+        }
+    }
+}
+
+// 误差恒定时积分项、斜坡测量值时微分项：60ms周期与30ms周期在相同时刻的输出相同，
+// 等于按Ts整定的连续时间控制器；不按周期缩放时积分减半、微分加倍
+static void Test_DtScaling(void)
+{
+    float out30[DT_STEPS + 1], out60[DT_STEPS + 1], raw60[DT_STEPS + 1];
+
+    DtRun(0.03f, true, 0.1f, 0.0f, 0.0f, out30);
+    DtRun(0.06f, true, 0.1f, 0.0f, 0.0f, out60);
+    DtRun(0.06f, false, 0.1f, 0.0f, 0.0f, raw60);
+    for (uint8_t k = 0; k <= DT_STEPS; k++) {
+        // Ki/Ts * ∫e dt，第一次计算按一个标称周期累加
+        float expect = 0.1f * DT_ERROR * (1.0f + 2.0f * k);
+        SIM_CHECK_NEAR(out30[k], expect, 1e-4);
+        SIM_CHECK_NEAR(out60[k], expect, 1e-4);
+        SIM_CHECK_NEAR(raw60[k], 0.1f * DT_ERROR * (1.0f + k), 1e-4);
+    }
+
+    DtRun(0.03f, true, 0.0f, 0.4f, DT_SLOPE, out30);
+    DtRun(0.06f, true, 0.0f, 0.4f, DT_SLOPE, out60);
+    DtRun(0.06f, false, 0.0f, 0.4f, DT_SLOPE, raw60);
+    for (uint8_t k = 1; k <= DT_STEPS; k++) {
+        // Kd*Ts * de/dt
+        SIM_CHECK_NEAR(out30[k], 0.4f * DT_SLOPE * DT_TS, 1e-4);
+        SIM_CHECK_NEAR(out60[k], 0.4f * DT_SLOPE * DT_TS, 1e-4);
+        SIM_CHECK_NEAR(raw60[k], 2.0f * 0.4f * DT_SLOPE * DT_TS, 1e-4);
+    }
+}
+
+// 周期比限制在PID_DT_RATIO_MIN~PID_DT_RATIO_MAX：长时间停顿后积分只按5个标称周期累加
+static void Test_DtRatioClamp(void)
+{
+    SIM_CHECK_NEAR(PID_DtRatio(0.045f, DT_TS), 1.5f, 1e-6);
+    SIM_CHECK_NEAR(PID_DtRatio(0.001f, DT_TS), PID_DT_RATIO_MIN, 1e-6);
+    SIM_CHECK_NEAR(PID_DtRatio(1.0f, DT_TS), PID_DT_RATIO_MAX, 1e-6);
+    SIM_CHECK_NEAR(PID_DtRatio(0.0f, DT_TS), 1.0f, 1e-6);
+    SIM_CHECK_NEAR(PID_DtRatio(0.06f, 0.0f), 1.0f, 1e-6);
+
+    PidController_t pid;
+    PID_Init(&pid, PID_TYPE_POSITIONAL);
+    PID_SetParam(&pid, 0.0f, 1.0f, 0.0f);
+    PID_SetSampleTime(&pid, DT_TS);
+    PID_SetTarget(&pid, 2.0f);
+    SIM_CHECK_NEAR(PID_ComputeDt(&pid, 0.0f, 0.0f), 2.0f, 1e-6);
+    SIM_CHECK_NEAR(PID_ComputeDt(&pid, 0.0f, 1.0f), 2.0f + 2.0f * PID_DT_RATIO_MAX, 1e-5);
+
+    // 周期极短时微分量最多放大到1/PID_DT_RATIO_MIN倍
+    PidController_t pid_d;
+    PID_Init(&pid_d, PID_TYPE_POSITIONAL);
+    PID_SetParam(&pid_d, 0.0f, 0.0f, 1.0f);
+    PID_SetSampleTime(&pid_d, DT_TS);
+    PID_ComputeDt(&pid_d, 0.0f, 0.0f);
+    SIM_CHECK_NEAR(PID_ComputeDt(&pid_d, -1.0f, 0.0001f), 1.0f / PID_DT_RATIO_MIN, 1e-4);
+}
+
+// 周期统计：最小/最大/平均值和样本标准差与两遍法的double参考值一致，dt为0时不计入
+static void Test_DtJitter(void)
+{
+    PidController_t pid;
+    PID_Init(&pid, PID_TYPE_POSITIONAL);
+    PID_SetSampleTime(&pid, DT_TS);
+
+    float dt[200];
+    const uint32_t n = sizeof(dt) / sizeof(dt[0]);
+    uint32_t lcg = 5;
+    PID_ComputeDt(&pid, 0.0f, 0.0f);
+    for (uint32_t k = 0; k < n; k++) {
+        lcg = lcg * 1664525U + 1013904223U;
+        // 30ms ± 4ms抖动，偶尔被长任务推迟到45ms
+        dt[k] = 0.026f + 0.008f * (float)(lcg >> 8) / 16777216.0f + ((k % 37 == 0) ? 0.015f : 0.0f);
+        PID_ComputeDt(&pid, 0.0f, dt[k]);
+    }
+
+    double mean = 0.0, min = dt[0], max = dt[0];
+    for (uint32_t k = 0; k < n; k++) {
+        mean += dt[k];
+        min = (dt[k] < min) ? dt[k] : min;
+        max = (dt[k] > max) ? dt[k] : max;
+    }
+    mean /= n;
+    double m2 = 0.0;
+    for (uint32_t k = 0; k < n; k++) {
+        m2 += (dt[k] - mean) * (dt[k] - mean);
+    }
+    double jitter = sqrt(m2 / (n - 1));
+
+    const PidDtStats_t *stats = &pid.dt_stats;
+    SIM_CHECK_EQ(stats->count, n);
+    SIM_CHECK_NEAR(stats->min, min, 1e-9);
+    SIM_CHECK_NEAR(stats->max, max, 1e-9);
+    SIM_CHECK_NEAR(stats->mean, mean, 1e-6);
+    SIM_CHECK_NEAR(stats->jitter, jitter, jitter * 1e-3);
+
+    PID_Reset(&pid);
+    SIM_CHECK_EQ(pid.dt_stats.count, 0);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_IncrementalHistory);
+    SIM_RUN(Test_DerivativeOnMeasurement);
+    SIM_RUN(Test_BackCalculationUnwind);
+    SIM_RUN(Test_DtScaling);
+    SIM_RUN(Test_DtRatioClamp);
+    SIM_RUN(Test_DtJitter);
+    return SIM_RESULT();
+}
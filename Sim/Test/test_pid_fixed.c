@@ -0,0 +1,183 @@
+/**
+ * @file test_pid_fixed.c
+ * @author Shiki
+ * @brief 定点PID测试：满量程误差、满量程输出限制下Q31不回绕；
+ *        与增量式PID_Compute()在同一闭环上比较（容差见PID_FIXED_TOL_Q31/Q15），并报告每次更新的耗时
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "pid_controller.h"
+#include "pid_fixed.h"
+#include "sim_test.h"
+
+#define COMPARE_STEPS 4000
+#define COMPARE_KP 1.2f  // Kp+2Kd=1.8，gain_shift为1
+#define COMPARE_KI 0.1f
+#define COMPARE_KD 0.3f
+#define PLANT_GAIN 0.1f  // 一阶对象 y(k+1) = y(k) + a*(u(k) - y(k))
+
+// 容差（满量程=1）：Q31的量化误差(2^-31)远小于float的舍入，差异由float一侧决定（实测约1.2e-7）；
+// Q15的输入、状态和增益都只有15位小数，闭环中累积到十几个LSB（1 LSB = 3.05e-5，实测约4.3e-4）
+#define PID_FIXED_TOL_Q31 1e-6
+#define PID_FIXED_TOL_Q15 2e-3
+
+#define BENCH_UPDATES 2000000U
+
+static float Setpoint(uint32_t k)
+{
+    return ((k / 500U) % 2U) ? -0.5f : 0.5f;
+}
+
+static q31_t ToQ31(float value)
+{
+    return (q31_t)(value * 2147483648.0f);
+}
+
+static q15_t ToQ15(float value)
+{
+    return (q15_t)(value * 32768.0f);
+}
+
+// gain_shift为0、输出限制为整个Q31范围时，满量程误差下输出饱和而不回绕变号
+static void Test_Q31FullScaleNoWrap(void)
+{
+    PidQ31_t pid;
+    PidQ31_Init(&pid);
+    SIM_CHECK(PidQ31_SetParam(&pid, 0.9f, 0.05f, 0.0f));
+    SIM_CHECK_EQ(pid.gain_shift, 0);
+
+    PidQ31_SetTarget(&pid, INT32_MAX);
+    q31_t prev = 0;
+    for (uint8_t i = 0; i < 10; i++) {
+        q31_t out = PidQ31_Compute(&pid, INT32_MIN);
+        SIM_CHECK(out >= prev);
+        prev = out;
+    }
+    SIM_CHECK_EQ(prev, INT32_MAX);
+
+    // 反向满量程误差：从上限直接向下，不因积分饱和而停留
+    PidQ31_SetTarget(&pid, INT32_MIN);
+    q31_t out = PidQ31_Compute(&pid, INT32_MAX);
+    SIM_CHECK(out < INT32_MAX);
+    for (uint8_t i = 0; i < 10; i++) {
+        out = PidQ31_Compute(&pid, INT32_MAX);
+        SIM_CHECK(out <= prev);
+        prev = out;
+    }
+    SIM_CHECK_EQ(prev, INT32_MIN);
+}
+
+// gain_shift不为0时，还原后的输出在限制之外也不回绕
+static void Test_Q31ShiftedGainSaturates(void)
+{
+    PidQ31_t pid;
+    PidQ31_Init(&pid);
+    SIM_CHECK(PidQ31_SetParam(&pid, 3.0f, 0.5f, 0.0f));
+    SIM_CHECK_EQ(pid.gain_shift, 2);
+
+    PidQ31_SetTarget(&pid, INT32_MAX);
+    for (uint8_t i = 0; i < 10; i++) {
+        SIM_CHECK(PidQ31_Compute(&pid, INT32_MIN) > 0);
+    }
+    SIM_CHECK_EQ(pid.output, INT32_MAX);
+}
+
+static void Test_FloatVsFixed(void)
+{
+    PidController_t ref;
+    PID_Init(&ref, PID_TYPE_INCREMENTAL);
+    PID_SetParam(&ref, COMPARE_KP, COMPARE_KI, COMPARE_KD);
+    PID_SetOutputLimit(&ref, -1.0f, 0.999f);
+
+    PidQ31_t q31;
+    PidQ31_Init(&q31);
+    SIM_CHECK(PidQ31_SetParam(&q31, COMPARE_KP, COMPARE_KI, COMPARE_KD));
+    PidQ31_SetOutputLimit(&q31, ToQ31(-1.0f), ToQ31(0.999f));
+
+    PidQ15_t q15;
+    PidQ15_Init(&q15);
+    SIM_CHECK(PidQ15_SetParam(&q15, COMPARE_KP, COMPARE_KI, COMPARE_KD));
+    PidQ15_SetOutputLimit(&q15, ToQ15(-1.0f), ToQ15(0.999f));
+
+    // 各控制器驱动各自的对象，比较输出和对象状态
+    float y_ref = 0.0f;
+    float y_q31 = 0.0f;
+    float y_q15 = 0.0f;
+    double err_q31 = 0.0;
+    double err_q15 = 0.0;
+    for (uint32_t k = 0; k < COMPARE_STEPS; k++) {
+        float r = Setpoint(k);
+        PID_SetTarget(&ref, r);
+        PidQ31_SetTarget(&q31, ToQ31(r));
+        PidQ15_SetTarget(&q15, ToQ15(r));
+
+        float u_ref = PID_Compute(&ref, y_ref);
+        float u_q31 = (float)PidQ31_Compute(&q31, ToQ31(y_q31)) / 2147483648.0f;
+        float u_q15 = (float)PidQ15_Compute(&q15, ToQ15(y_q15)) / 32768.0f;
+        err_q31 = fmax(err_q31, fabs((double)u_q31 - (double)u_ref));
+        err_q15 = fmax(err_q15, fabs((double)u_q15 - (double)u_ref));
+
+        y_ref += PLANT_GAIN * (u_ref - y_ref);
+        y_q31 += PLANT_GAIN * (u_q31 - y_q31);
+        y_q15 += PLANT_GAIN * (u_q15 - y_q15);
+    }
+    printf("max |u_fixed - u_float|: q31 %.3g (tol %.0e), q15 %.3g (tol %.0e)\n", err_q31,
+           PID_FIXED_TOL_Q31, err_q15, PID_FIXED_TOL_Q15);
+    SIM_CHECK(err_q31 <= PID_FIXED_TOL_Q31);
+    SIM_CHECK(err_q15 <= PID_FIXED_TOL_Q15);
+}
+
+// 每次更新的耗时：主机上只用于比较三种实现的相对开销，目标板上的周期数用PROFILER测量
+static void Test_UpdateCost(void)
+{
+    PidController_t ref;
+    PID_Init(&ref, PID_TYPE_INCREMENTAL);
+    PID_SetParam(&ref, COMPARE_KP, COMPARE_KI, COMPARE_KD);
+    PID_SetOutputLimit(&ref, -1.0f, 0.999f);
+    PID_SetTarget(&ref, 0.25f);
+    PidQ31_t q31;
+    PidQ31_Init(&q31);
+    PidQ31_SetParam(&q31, COMPARE_KP, COMPARE_KI, COMPARE_KD);
+    PidQ31_SetTarget(&q31, ToQ31(0.25f));
+    PidQ15_t q15;
+    PidQ15_Init(&q15);
+    PidQ15_SetParam(&q15, COMPARE_KP, COMPARE_KI, COMPARE_KD);
+    PidQ15_SetTarget(&q15, ToQ15(0.25f));
+
+    volatile float sink_f = 0.0f;
+    volatile q31_t sink_q31 = 0;
+    volatile q15_t sink_q15 = 0;
+
+    uint64_t t0 = SimTest_NowCycles();
+    for (uint32_t i = 0; i < BENCH_UPDATES; i++) {
+        sink_f = PID_Compute(&ref, (float)(i & 0xFF) * (1.0f / 512.0f));
+    }
+    uint64_t t1 = SimTest_NowCycles();
+    for (uint32_t i = 0; i < BENCH_UPDATES; i++) {
+        sink_q31 = PidQ31_Compute(&q31, (q31_t)((i & 0xFF) << 22));
+    }
+    uint64_t t2 = SimTest_NowCycles();
+    for (uint32_t i = 0; i < BENCH_UPDATES; i++) {
+        sink_q15 = PidQ15_Compute(&q15, (q15_t)((i & 0xFF) << 6));
+    }
+    uint64_t t3 = SimTest_NowCycles();
+    (void)sink_f;
+    (void)sink_q31;
+    (void)sink_q15;
+
+    printf("cycles/update (host TSC): float %.1f, q31 %.1f, q15 %.1f\n",
+           (double)(t1 - t0) / BENCH_UPDATES, (double)(t2 - t1) / BENCH_UPDATES,
+           (double)(t3 - t2) / BENCH_UPDATES);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_Q31FullScaleNoWrap);
+    SIM_RUN(Test_Q31ShiftedGainSaturates);
+    SIM_RUN(Test_FloatVsFixed);
+    SIM_RUN(Test_UpdateCost);
+    return SIM_RESULT();
+}
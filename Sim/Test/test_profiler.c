@@ -0,0 +1,168 @@
+/**
+ * @file test_profiler.c
+ * @author Shiki
+ * @brief 耗时统计测试：以PROFILER_GET_CYCLES()替换DWT，每次读取计数器固定前进若干周期，
+ *        检查探针开销扣除、最小/最大/平均值、直方图档位、清零，以及串口2打印指令的请求标志
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "sim_frames.h"
+#include "sim_test.h"
+
+// 每次读取计数器的开销（周期）
+#define READ_COST 7U
+
+static uint32_t fake_cycles = 0;
+
+static uint32_t Test_ReadCycles(void)
+{
+    uint32_t now = fake_cycles;
+    fake_cycles += READ_COST;
+    return now;
+}
+
+// 替换DWT和CMSIS实现后直接编译profiler.c，与bsp_host中的版本相互独立
+#define PROFILER_GET_CYCLES() Test_ReadCycles()
+#define PROFILER_CLZ(x) __builtin_clz(x)
+#define PROFILER_ENTER_CRITICAL() ((void)0)
+#define PROFILER_EXIT_CRITICAL() ((void)0)
+#define PROFILER_CYCLES_PER_US 168U
+#include "profiler.c"
+
+#include "host_command.h"
+
+/**
+ * @brief 用探针宏记录一段耗时work个周期的代码
+ */
+static void Run(uint32_t work)
+{
+    PROFILER_BEGIN(KEY_PROC);
+    fake_cycles += work;
+    PROFILER_END(KEY_PROC);
+}
+
+// Profiler_Init测得的开销为一次读取的周期数，记录时扣除，结果等于代码本身的周期数
+static void Test_OverheadSubtracted(void)
+{
+    Profiler_Init();
+    SIM_CHECK_EQ(profiler_overhead, READ_COST);
+
+    Run(100);
+    ProfilerProbe_t probe;
+    SIM_CHECK(Profiler_GetProbe(PROFILER_PROBE_KEY_PROC, &probe));
+    SIM_CHECK_EQ(probe.count, 1);
+    SIM_CHECK_EQ(probe.min, 100);
+    SIM_CHECK_EQ(probe.max, 100);
+
+    // 比开销还短的记录为0，不回绕
+    Profiler_Record(PROFILER_PROBE_PID_COMPUTE, READ_COST - 2);
+    SIM_CHECK(Profiler_GetProbe(PROFILER_PROBE_PID_COMPUTE, &probe));
+    SIM_CHECK_EQ(probe.max, 0);
+    SIM_CHECK_EQ(probe.hist[0], 1);
+}
+
+static void Test_MinMaxMean(void)
+{
+    Profiler_Init();
+    const uint32_t work[] = {300, 50, 100, 1000, 50};
+    uint64_t sum = 0;
+    for (uint8_t i = 0; i < sizeof(work) / sizeof(work[0]); i++) {
+        Run(work[i]);
+        sum += work[i];
+    }
+
+    ProfilerProbe_t probe;
+    SIM_CHECK(Profiler_GetProbe(PROFILER_PROBE_KEY_PROC, &probe));
+    SIM_CHECK_EQ(probe.count, 5);
+    SIM_CHECK_EQ(probe.min, 50);
+    SIM_CHECK_EQ(probe.max, 1000);
+    SIM_CHECK_EQ(probe.sum, sum);
+    SIM_CHECK_EQ(probe.sum / probe.count, 300);
+
+    // 其他探针不受影响
+    SIM_CHECK(Profiler_GetProbe(PROFILER_PROBE_UART_PROCESS, &probe));
+    SIM_CHECK_EQ(probe.count, 0);
+}
+
+// 第i档为[2^i, 2^(i+1))，0和1计入第0档，超出范围的计入最后一档
+static void Test_HistogramBins(void)
+{
+    Profiler_Init();
+    const struct {
+        uint32_t cycles;
+        uint8_t bin;
+    } cases[] = {
+        {0, 0}, {1, 0}, {2, 1}, {3, 1}, {64, 6}, {127, 6}, {128, 7},
+        {(1U << (PROFILER_HIST_BINS - 1)), PROFILER_HIST_BINS - 1},
+        {UINT32_MAX - READ_COST, PROFILER_HIST_BINS - 1},
+    };
+
+    for (uint8_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        Profiler_Reset();
+        // 记录值包含开销
+        Profiler_Record(PROFILER_PROBE_VISION_FILTER, cases[i].cycles + READ_COST);
+        ProfilerProbe_t probe;
+        Profiler_GetProbe(PROFILER_PROBE_VISION_FILTER, &probe);
+        for (uint8_t bin = 0; bin < PROFILER_HIST_BINS; bin++) {
+            SIM_CHECK_EQ(probe.hist[bin], (bin == cases[i].bin) ? 1 : 0);
+        }
+    }
+}
+
+static void Test_Reset(void)
+{
+    Profiler_Init();
+    Run(500);
+    Profiler_Reset();
+
+    ProfilerProbe_t probe;
+    SIM_CHECK(Profiler_GetProbe(PROFILER_PROBE_KEY_PROC, &probe));
+    SIM_CHECK_EQ(probe.count, 0);
+    SIM_CHECK_EQ(probe.sum, 0);
+    SIM_CHECK_EQ(probe.max, 0);
+    SIM_CHECK_EQ(probe.min, UINT32_MAX);
+    for (uint8_t bin = 0; bin < PROFILER_HIST_BINS; bin++) {
+        SIM_CHECK_EQ(probe.hist[bin], 0);
+    }
+
+    // 无效编号被忽略
+    Profiler_Record(PROFILER_PROBE_COUNT, 100);
+    SIM_CHECK(!Profiler_GetProbe(PROFILER_PROBE_COUNT, &probe));
+    Profiler_Print();
+}
+
+// 串口2打印指令只置位请求，由主循环（Key_Proc）读取一次后清除
+static void Test_DumpCommand(void)
+{
+    uint8_t frame[HOST_COMMAND_HEAD_LEN + HOST_COMMAND_CRC_LEN + 1] = {
+        HOST_COMMAND_HEADER, HOST_COMMAND_HEAD_LEN + HOST_COMMAND_CRC_LEN, HOST_COMMAND_TYPE,
+        HOST_CMD_PROFILER_DUMP};
+    uint16_t crc = SimFrame_Crc16(frame, HOST_COMMAND_HEAD_LEN);
+    frame[4] = (uint8_t)(crc >> 8);
+    frame[5] = (uint8_t)crc;
+
+    SIM_CHECK(!HostCommand_TakeDumpRequest());
+    SIM_CHECK(HostCommand_Handle(frame, HOST_COMMAND_HEAD_LEN + HOST_COMMAND_CRC_LEN));
+    SIM_CHECK(HostCommand_TakeDumpRequest());
+    SIM_CHECK(!HostCommand_TakeDumpRequest());
+
+    // 带参数的打印指令不合法
+    frame[1] = sizeof(frame);
+    SIM_CHECK(HostCommand_Handle(frame, sizeof(frame)));
+    SIM_CHECK(!HostCommand_TakeDumpRequest());
+}
+
+int main(void)
+{
+    SIM_RUN(Test_OverheadSubtracted);
+    SIM_RUN(Test_MinMaxMean);
+    SIM_RUN(Test_HistogramBins);
+    SIM_RUN(Test_Reset);
+    SIM_RUN(Test_DumpCommand);
+    return SIM_RESULT();
+}
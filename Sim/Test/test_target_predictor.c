@@ -0,0 +1,205 @@
+/**
+ * @file test_target_predictor.c
+ * @author Shiki
+ * @brief 预测器测试：同一接收时刻的多个数据包只修正位置；
+ *        回放匀速目标的数据包序列（相机50Hz，部分帧被延迟到与下一帧同一次轮询中接收），
+ *        检查速度估计不被同时到达的数据包扰动，外推位置的RMS误差小于直接使用最近测量值的滞后；
+ *        记录的云台转动（Predictor_AddMotion）从测量中扣除，不被当作目标速度，外推时计入尚未测到的转动
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "aim_calibration.h"
+#include "sim_test.h"
+#include "target_predictor.h"
+
+#define REPLAY_FRAME_MS 20      // 相机帧间隔(ms)
+#define REPLAY_FRAMES 200
+#define REPLAY_SPEED 0.2f       // 目标速度(像素/ms)
+#define REPLAY_BURST_EVERY 5    // 每5帧有一帧延迟到与下一帧一起接收
+#define REPLAY_SETTLE_FRAMES 20 // 收敛后才统计误差
+
+static float Replay_TrueX(uint32_t tick)
+{
+    return 100.0f + REPLAY_SPEED * (float)tick;
+}
+
+static PixelPoint_t Replay_Point(uint32_t tick)
+{
+    PixelPoint_t point = {(uint16_t)(Replay_TrueX(tick) + 0.5f), 240};
+    return point;
+}
+
+// 第一次测量后同一时刻再到达一个数据包：不初始化速度，仍需下一个时刻的测量
+static void Test_SameTickBeforeVelocity(void)
+{
+    Predictor_t pred;
+    Predictor_Init(&pred, PREDICTOR_ALPHA, PREDICTOR_BETA, PREDICTOR_LATENCY_MS);
+
+    Predictor_Update(&pred, (PixelPoint_t){100, 100}, 1000);
+    Predictor_Update(&pred, (PixelPoint_t){110, 100}, 1000);
+    SIM_CHECK_EQ(pred.samples, 1);
+    SIM_CHECK_NEAR(pred.vx, 0.0f, 1e-6f);
+    SIM_CHECK_NEAR(pred.x, 100.0f + PREDICTOR_ALPHA * 10.0f, 1e-4f);
+
+    Predictor_Update(&pred, (PixelPoint_t){115, 100}, 1010);
+    SIM_CHECK_EQ(pred.samples, 2);
+    SIM_CHECK_NEAR(pred.vx, (115.0f - 105.0f) / 10.0f, 1e-4f);
+}
+
+// 已有速度估计时，同一时刻的数据包只修正位置，速度不变
+static void Test_SameTickKeepsVelocity(void)
+{
+    Predictor_t pred;
+    Predictor_Init(&pred, PREDICTOR_ALPHA, PREDICTOR_BETA, PREDICTOR_LATENCY_MS);
+
+    Predictor_Update(&pred, (PixelPoint_t){100, 100}, 1000);
+    Predictor_Update(&pred, (PixelPoint_t){104, 100}, 1020);
+    Predictor_Update(&pred, (PixelPoint_t){108, 100}, 1040);
+    float vx = pred.vx;
+    float vy = pred.vy;
+    uint32_t last_tick = pred.last_tick;
+
+    Predictor_Update(&pred, (PixelPoint_t){118, 90}, 1040);
+    SIM_CHECK_NEAR(pred.vx, vx, 1e-6f);
+    SIM_CHECK_NEAR(pred.vy, vy, 1e-6f);
+    SIM_CHECK_EQ(pred.last_tick, last_tick);
+    SIM_CHECK_NEAR(pred.x, 108.0f + PREDICTOR_ALPHA * 10.0f, 1e-4f);
+    SIM_CHECK_NEAR(pred.y, 100.0f - PREDICTOR_ALPHA * 10.0f, 1e-4f);
+}
+
+static void Test_ReplayMovingTarget(void)
+{
+    Predictor_t pred;
+    Predictor_Init(&pred, PREDICTOR_ALPHA, PREDICTOR_BETA, PREDICTOR_LATENCY_MS);
+
+    float max_vel_err = 0.0f;
+    double sum_sq = 0.0, raw_sum_sq = 0.0;
+    uint32_t n = 0;
+    for (uint32_t k = 0; k < REPLAY_FRAMES; k++) {
+        uint32_t capture = 1000U + k * REPLAY_FRAME_MS;
+        uint32_t rx_tick = capture + PREDICTOR_LATENCY_MS;
+        if (k % REPLAY_BURST_EVERY == REPLAY_BURST_EVERY - 1) {
+            continue;  // 与下一帧一起接收
+        }
+        if (k % REPLAY_BURST_EVERY == 0 && k > 0) {
+            // 被延迟的上一帧和本帧在同一次轮询中处理，接收时刻相同
+            Predictor_Update(&pred, Replay_Point(capture - REPLAY_FRAME_MS), rx_tick);
+        }
+        Predictor_Update(&pred, Replay_Point(capture), rx_tick);
+
+        if (k < REPLAY_SETTLE_FRAMES) {
+            continue;
+        }
+        float vel_err = fabsf(pred.vx - REPLAY_SPEED);
+        if (vel_err > max_vel_err) {
+            max_vel_err = vel_err;
+        }
+        // 在下一帧到达前的每个追踪周期外推到当前时刻
+        for (uint32_t now = rx_tick; now < rx_tick + REPLAY_FRAME_MS; now += 5) {
+            PixelPoint_t target;
+            SIM_CHECK(Predictor_Predict(&pred, now, &target));
+            double err = (double)target.x - (double)Replay_TrueX(now);
+            sum_sq += err * err;
+            // 不预测：追踪任务直接使用最近接收的测量值
+            double raw_err = (double)Replay_Point(capture).x - (double)Replay_TrueX(now);
+            raw_sum_sq += raw_err * raw_err;
+            n++;
+        }
+    }
+
+    double rms = sqrt(sum_sq / (double)n);
+    double raw_rms = sqrt(raw_sum_sq / (double)n);
+    printf("max |vx - v| = %.4f px/ms, rms prediction error = %.2f px, raw lag = %.2f px\n",
+           (double)max_vel_err, rms, raw_rms);
+    // 量化误差（±0.5像素）和延迟帧的旧位置引起的速度波动远小于目标速度
+    SIM_CHECK(max_vel_err < 0.05f);
+    SIM_CHECK(rms < 2.0);
+    // 直接使用测量值滞后一个延迟加最多一帧（约10像素），外推后至少减小到五分之一
+    SIM_CHECK(rms < raw_rms / 5.0);
+}
+
+// 静止目标，云台转动使目标在图像中移动：记录的转动从测量中扣除，不被当作目标速度，
+// 外推时计入已发出但还没有反映在测量中的转动
+static void Test_GimbalMotionCompensation(void)
+{
+    const float k = g_aim_cal_model.px_per_clk[0][0];  // 默认模型：X轴每脉冲的像素位移
+    const int32_t clk[2] = {120, 0};
+    // 1000时发出转动，200ms内匀速转过120脉冲
+    const PredictorMotion_t motion = {.start_tick = 1000, .duration_ms = {200, 0}, .clk = {120, 0}};
+
+    Predictor_t pred;
+    Predictor_Init(&pred, PREDICTOR_ALPHA, PREDICTOR_BETA, PREDICTOR_LATENCY_MS);
+
+    Predictor_AddMotion(&pred, &motion);
+    SIM_CHECK_EQ(pred.motion_count, 1);
+
+    float max_vel = 0.0f;
+    for (uint32_t capture = 900; capture <= 1400; capture += REPLAY_FRAME_MS) {
+        uint32_t rx_tick = capture + PREDICTOR_LATENCY_MS;
+        float moved = (capture <= 1000) ? 0.0f
+                      : (capture >= 1200) ? (float)clk[0]
+                                          : (float)clk[0] * (float)(capture - 1000) / 200.0f;
+        Predictor_Update(&pred, (PixelPoint_t){(uint16_t)lrintf(200.0f + k * moved), 120}, rx_tick);
+        if (fabsf(pred.vx) > max_vel) {
+            max_vel = fabsf(pred.vx);
+        }
+
+        // 接收时刻的图像位置包括测量之后的转动
+        float now_moved = (rx_tick <= 1000)   ? 0.0f
+                          : (rx_tick >= 1200) ? (float)clk[0]
+                                              : (float)clk[0] * (float)(rx_tick - 1000) / 200.0f;
+        PixelPoint_t target;
+        SIM_CHECK(Predictor_Predict(&pred, rx_tick, &target));
+        SIM_CHECK_NEAR(target.x, 200.0f + k * now_moved, 1.0f);
+    }
+    printf("max |vx| with motion compensation = %.4f px/ms\n", (double)max_vel);
+    // 取整误差引起的速度估计远小于转动引起的图像速度(0.3像素/ms)
+    SIM_CHECK(max_vel < 0.02f);
+
+    // 对照：不记录转动时云台引起的图像速度被当作目标速度
+    Predictor_t free_pred;
+    Predictor_Init(&free_pred, PREDICTOR_ALPHA, PREDICTOR_BETA, PREDICTOR_LATENCY_MS);
+    for (uint32_t capture = 1000; capture <= 1200; capture += REPLAY_FRAME_MS) {
+        float moved = (float)clk[0] * (float)(capture - 1000) / 200.0f;
+        Predictor_Update(&free_pred, (PixelPoint_t){(uint16_t)lrintf(200.0f + k * moved), 120},
+                         capture + PREDICTOR_LATENCY_MS);
+    }
+    SIM_CHECK(free_pred.vx < -0.2f);
+}
+
+// 记录满后最早的命令计入累计脉冲数，位移不变
+static void Test_MotionHistoryFold(void)
+{
+    Predictor_t pred;
+    Predictor_Init(&pred, PREDICTOR_ALPHA, PREDICTOR_BETA, PREDICTOR_LATENCY_MS);
+    Predictor_Update(&pred, (PixelPoint_t){160, 120}, 1000);
+
+    for (uint32_t n = 0; n < PREDICTOR_MOTION_LEN + 3; n++) {
+        const PredictorMotion_t motion = {
+            .start_tick = 1000 + n * 5, .duration_ms = {20, 20}, .ramp_ms = {5, 5}, .clk = {10, -4}};
+        Predictor_AddMotion(&pred, &motion);
+    }
+    SIM_CHECK_EQ(pred.motion_count, PREDICTOR_MOTION_LEN);
+    SIM_CHECK_NEAR(pred.motion_base[0], 30.0f, 1e-6f);
+    SIM_CHECK_NEAR(pred.motion_base[1], -12.0f, 1e-6f);
+
+    // 所有转动结束后：X轴110脉冲、Y轴-44脉冲
+    PixelPoint_t target;
+    SIM_CHECK(Predictor_Predict(&pred, 1100, &target));
+    const float(*k)[2] = g_aim_cal_model.px_per_clk;
+    SIM_CHECK_NEAR(target.x, 160.0f + k[0][0] * 110.0f + k[0][1] * -44.0f, 0.5f);
+    SIM_CHECK_NEAR(target.y, 120.0f + k[1][0] * 110.0f + k[1][1] * -44.0f, 0.5f);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_SameTickBeforeVelocity);
+    SIM_RUN(Test_SameTickKeepsVelocity);
+    SIM_RUN(Test_ReplayMovingTarget);
+    SIM_RUN(Test_GimbalMotionCompensation);
+    SIM_RUN(Test_MotionHistoryFold);
+    return SIM_RESULT();
+}
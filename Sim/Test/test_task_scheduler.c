@@ -0,0 +1,215 @@
+/**
+ * @file test_task_scheduler.c
+ * @author Shiki
+ * @brief 调度器测试：首次释放时刻、同一轮按优先级执行所有到期任务、挂起/恢复、任务中删除任务、
+ *        错过释放与执行超时的统计
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "fake_hal.h"
+#include "sim_test.h"
+#include "task_scheduler.h"
+
+static char run_log[16];
+static uint8_t run_len = 0;
+static uint32_t first_run_tick[3];
+
+static void Log_Run(char c, uint8_t id)
+{
+    if (run_len < sizeof(run_log) - 1) {
+        run_log[run_len++] = c;
+        run_log[run_len] = '\0';
+    }
+    if (first_run_tick[id] == 0) {
+        first_run_tick[id] = HAL_GetTick();
+    }
+}
+
+static void Task_A(void)
+{
+    Log_Run('A', 0);
+}
+
+static void Task_B(void)
+{
+    Log_Run('B', 1);
+}
+
+static void Task_C(void)
+{
+    Log_Run('C', 2);
+}
+
+static void Task_DeleteB(void)
+{
+    Log_Run('D', 2);
+    TaskScheduler_DeleteTask("B");
+}
+
+static uint32_t block_ms = 0;  // 下次执行时阻塞的时间
+
+static void Task_Block(void)
+{
+    Log_Run('X', 2);
+    if (block_ms > 0) {
+        HAL_Delay(block_ms - 1);
+        block_ms = 0;
+    }
+}
+
+/**
+ * @brief 从统计快照中读取任务记录的u16字段
+ * @param offset 字段在记录中的偏移
+ */
+static uint16_t Snapshot_Get16(uint8_t task, uint8_t offset)
+{
+    uint8_t snapshot[TASK_STATS_SNAPSHOT_SIZE];
+    uint16_t len = TaskScheduler_GetStatsSnapshot(snapshot, sizeof(snapshot));
+    uint16_t pos = TASK_STATS_HEADER_SIZE + task * TASK_STATS_RECORD_SIZE + offset;
+    if (pos + 2 > len) {
+        return UINT16_MAX;
+    }
+    return (uint16_t)(snapshot[pos] | (snapshot[pos + 1] << 8));
+}
+
+#define SNAPSHOT_LATE_MAX 16
+#define SNAPSHOT_DEADLINE_MISSES 20
+#define SNAPSHOT_EXEC_OVERRUNS 22
+
+static void Reset_Log(void)
+{
+    run_len = 0;
+    run_log[0] = '\0';
+    memset(first_run_tick, 0, sizeof(first_run_tick));
+}
+
+static void Run_For(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++) {
+        FakeHal_Advance(1);
+        TaskScheduler_Run();
+    }
+}
+
+// 启动时已经过去的时间不应使任务在第一次调用时全部释放
+static void Test_FirstReleaseAfterOnePeriod(void)
+{
+    FakeHal_Reset();
+    FakeHal_SetTick(1300);
+    TaskScheduler_SetTickSource(NULL);
+    TaskScheduler_Init();
+    Reset_Log();
+    TaskScheduler_AddTask(Task_A, 20, TASK_PRIORITY_NORMAL, "A");
+    TaskScheduler_AddTask(Task_B, 30, TASK_PRIORITY_HIGH, "B");
+
+    TaskScheduler_Run();
+    SIM_CHECK_EQ(run_len, 0);
+    Run_For(60);
+    SIM_CHECK_EQ(first_run_tick[0], 1320);
+    SIM_CHECK_EQ(first_run_tick[1], 1330);
+    SIM_CHECK(strcmp(run_log, "ABABA") == 0);
+}
+
+// 同一时刻到期的任务在一轮中全部执行，高优先级在前
+static void Test_PriorityOrderInOnePass(void)
+{
+    FakeHal_Reset();
+    TaskScheduler_SetTickSource(NULL);
+    TaskScheduler_Init();
+    Reset_Log();
+    TaskScheduler_AddTask(Task_A, 10, TASK_PRIORITY_LOW, "A");
+    TaskScheduler_AddTask(Task_B, 10, TASK_PRIORITY_NORMAL, "B");
+    TaskScheduler_AddTask(Task_C, 10, TASK_PRIORITY_CRITICAL, "C");
+
+    FakeHal_Advance(10);
+    TaskScheduler_Run();
+    SIM_CHECK(strcmp(run_log, "CBA") == 0);
+    TaskScheduler_Run();
+    SIM_CHECK_EQ(run_len, 3);
+}
+
+static void Test_SuspendResume(void)
+{
+    FakeHal_Reset();
+    TaskScheduler_SetTickSource(NULL);
+    TaskScheduler_Init();
+    Reset_Log();
+    TaskScheduler_AddTask(Task_A, 10, TASK_PRIORITY_NORMAL, "A");
+
+    TaskScheduler_SuspendTask("A");
+    Run_For(50);
+    SIM_CHECK_EQ(run_len, 0);
+    // 恢复后从恢复时刻起经过一个周期释放
+    TaskScheduler_ResumeTask("A");
+    Run_For(9);
+    SIM_CHECK_EQ(run_len, 0);
+    Run_For(1);
+    SIM_CHECK_EQ(run_len, 1);
+    SIM_CHECK_EQ(first_run_tick[0], 60);
+}
+
+// 任务中删除其他任务后，堆重建，剩余任务不再使用失效的索引
+static void Test_DeleteFromTask(void)
+{
+    FakeHal_Reset();
+    TaskScheduler_SetTickSource(NULL);
+    TaskScheduler_Init();
+    Reset_Log();
+    TaskScheduler_AddTask(Task_A, 10, TASK_PRIORITY_NORMAL, "A");
+    TaskScheduler_AddTask(Task_B, 10, TASK_PRIORITY_LOW, "B");
+    TaskScheduler_AddTask(Task_DeleteB, 10, TASK_PRIORITY_HIGH, "D");
+
+    Run_For(30);
+    SIM_CHECK_EQ(TaskScheduler_GetTaskCount(), 2);
+    SIM_CHECK(strchr(run_log, 'B') == NULL);
+    SIM_CHECK(strncmp(run_log, "DADA", 4) == 0);
+}
+
+// 一次超过周期的执行只计一次执行超时；主循环被其他任务阻塞超过一个周期时计为错过释放
+static void Test_OverrunAccounting(void)
+{
+    FakeHal_Reset();
+    FakeHal_SetTick(1300);
+    TaskScheduler_SetTickSource(NULL);
+    TaskScheduler_Init();
+    Reset_Log();
+    TaskScheduler_AddTask(Task_A, 20, TASK_PRIORITY_NORMAL, "A");
+    TaskScheduler_AddTask(Task_Block, 30, TASK_PRIORITY_HIGH, "X");
+
+    // 启动前经过的时间不产生释放延迟和超限
+    Run_For(100);
+    SIM_CHECK_EQ(Snapshot_Get16(0, SNAPSHOT_LATE_MAX), 0);
+    SIM_CHECK_EQ(Snapshot_Get16(0, SNAPSHOT_DEADLINE_MISSES), 0);
+    SIM_CHECK_EQ(Snapshot_Get16(1, SNAPSHOT_DEADLINE_MISSES), 0);
+    SIM_CHECK_EQ(Snapshot_Get16(1, SNAPSHOT_EXEC_OVERRUNS), 0);
+
+    // X执行45ms（周期30ms）：X自身计一次执行超时，A等待超过一个周期计一次错过释放
+    block_ms = 45;
+    Run_For(100);
+    SIM_CHECK_EQ(Snapshot_Get16(1, SNAPSHOT_EXEC_OVERRUNS), 1);
+    SIM_CHECK_EQ(Snapshot_Get16(1, SNAPSHOT_DEADLINE_MISSES), 0);
+    SIM_CHECK_EQ(Snapshot_Get16(0, SNAPSHOT_EXEC_OVERRUNS), 0);
+    SIM_CHECK_EQ(Snapshot_Get16(0, SNAPSHOT_DEADLINE_MISSES), 1);
+
+    uint8_t header[TASK_STATS_HEADER_SIZE];
+    SIM_CHECK_EQ(TaskScheduler_GetStatsSnapshot(header, sizeof(header)), TASK_STATS_HEADER_SIZE);
+    SIM_CHECK_EQ(header[0], TASK_STATS_MAGIC);
+    SIM_CHECK_EQ(header[1], TASK_STATS_VERSION);
+    SIM_CHECK_EQ(header[2], 0);
+    SIM_CHECK_EQ(header[3], TASK_STATS_RECORD_SIZE);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_FirstReleaseAfterOnePeriod);
+    SIM_RUN(Test_PriorityOrderInOnePass);
+    SIM_RUN(Test_SuspendResume);
+    SIM_RUN(Test_DeleteFromTask);
+    SIM_RUN(Test_OverrunAccounting);
+    return SIM_RESULT();
+}
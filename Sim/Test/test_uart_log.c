@@ -0,0 +1,167 @@
+/**
+ * @file test_uart_log.c
+ * @author Shiki
+ * @brief 日志输出测试：关闭发送自动完成，逐段检查DMA发送的内容；
+ *        跨越缓冲区末尾的数据分两段发送、缓冲区满时整段丢弃并计数、high_water、
+ *        DMA发送错误后从读取位置重新发送
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "fake_hal.h"
+#include "sim_test.h"
+#include "uart_log.h"
+#include "usart.h"
+
+static uint8_t pattern[UART_LOG_BUFFER_SIZE];
+
+static void Setup(void)
+{
+    FakeHal_Reset();
+    FakeHal_SetTxAutoComplete(false);
+    UartLog_Init();
+    for (uint32_t i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 7 + 3);
+    }
+}
+
+/**
+ * @brief 检查正在发送的数据段：自上次ClearTx以来只发起一次发送，内容为expect
+ */
+static void CheckSegment(const uint8_t *expect, uint32_t len)
+{
+    uint32_t captured;
+    const uint8_t *data = FakeHal_GetTxData(&huart2, &captured);
+    SIM_CHECK_EQ(captured, len);
+    SIM_CHECK(memcmp(data, expect, len) == 0);
+    FakeHal_ClearTx(&huart2);
+}
+
+// 写入位置越过缓冲区末尾，末尾和开头的两段依次发送，内容连续
+static void Test_Wraparound(void)
+{
+    Setup();
+    SIM_CHECK(UartLog_Write(pattern, 4000));
+    CheckSegment(pattern, 4000);
+    FakeHal_CompleteTx(&huart2);
+    SIM_CHECK(UartLog_IsIdle());
+
+    const uint32_t tail = UART_LOG_BUFFER_SIZE - 4000;  // 缓冲区末尾剩余的字节数
+    SIM_CHECK(UartLog_Write(pattern + 100, 200));
+    CheckSegment(pattern + 100, tail);
+    // 第一段发送中写入的数据排在其后
+    SIM_CHECK(UartLog_Write(pattern + 300, 50));
+    FakeHal_CompleteTx(&huart2);
+    CheckSegment(pattern + 100 + tail, 200 - tail + 50);
+    FakeHal_CompleteTx(&huart2);
+    SIM_CHECK(UartLog_IsIdle());
+    SIM_CHECK_EQ(FakeHal_GetTxFrames(&huart2), 3);
+
+    UartLogStats_t stats;
+    UartLog_GetStats(&stats);
+    SIM_CHECK_EQ(stats.written, 4250);
+    SIM_CHECK_EQ(stats.sent, 4250);
+    SIM_CHECK_EQ(stats.pending, 0);
+    SIM_CHECK_EQ(stats.dropped, 0);
+}
+
+// 剩余空间不足时整段丢弃（不写入一部分），按字节数计入dropped；发送完成释放空间后可再写入
+static void Test_DropWhenFull(void)
+{
+    Setup();
+    SIM_CHECK(UartLog_Write(pattern, 4000));
+    SIM_CHECK(UartLog_Write(pattern, UART_LOG_BUFFER_SIZE - 4000 - 10));
+    SIM_CHECK(!UartLog_Write(pattern, 11));
+    SIM_CHECK(UartLog_Write(pattern + 500, 10));
+    SIM_CHECK(!UartLog_Write(pattern, 1));
+
+    UartLogStats_t stats;
+    UartLog_GetStats(&stats);
+    SIM_CHECK_EQ(stats.written, UART_LOG_BUFFER_SIZE);
+    SIM_CHECK_EQ(stats.dropped, 12);
+    SIM_CHECK_EQ(stats.pending, UART_LOG_BUFFER_SIZE);
+
+    FakeHal_ClearTx(&huart2);
+    FakeHal_CompleteTx(&huart2);
+    // 丢弃的数据不出现在输出中：最后一段的末尾是第二次成功写入的10字节
+    uint32_t captured;
+    const uint8_t *data = FakeHal_GetTxData(&huart2, &captured);
+    SIM_CHECK_EQ(captured, UART_LOG_BUFFER_SIZE - 4000);
+    SIM_CHECK(memcmp(data + captured - 10, pattern + 500, 10) == 0);
+
+    SIM_CHECK(UartLog_Write(pattern, 4000));
+    SIM_CHECK(!UartLog_Write(pattern, 1));
+    UartLog_GetStats(&stats);
+    SIM_CHECK_EQ(stats.dropped, 13);
+}
+
+// high_water为缓冲区中（含正在发送的）字节数的最大值，清零统计后重新记录
+static void Test_HighWater(void)
+{
+    Setup();
+    SIM_CHECK(UartLog_Write(pattern, 300));
+    SIM_CHECK(UartLog_Write(pattern, 200));
+    FakeHal_CompleteTx(&huart2);  // 释放300字节，开始发送200字节
+    SIM_CHECK(UartLog_Write(pattern, 100));
+
+    UartLogStats_t stats;
+    UartLog_GetStats(&stats);
+    SIM_CHECK_EQ(stats.high_water, 500);
+    SIM_CHECK_EQ(stats.pending, 300);
+
+    UartLog_ResetStats();
+    UartLog_GetStats(&stats);
+    SIM_CHECK_EQ(stats.high_water, 0);
+    SIM_CHECK_EQ(stats.written, 0);
+    SIM_CHECK_EQ(stats.pending, 300);
+
+    FakeHal_CompleteTx(&huart2);
+    SIM_CHECK(UartLog_Write(pattern, 50));
+    UartLog_GetStats(&stats);
+    SIM_CHECK_EQ(stats.high_water, 150);
+    SIM_CHECK_EQ(stats.sent, 200);
+}
+
+// DMA发送出错被中止后，从读取位置重新发送（被中止的一段和其后写入的数据一起发送）；
+// 发送中的接收错误（串口仍忙于发送）不影响日志
+static void Test_ErrorRestart(void)
+{
+    Setup();
+    SIM_CHECK(UartLog_Write(pattern, 120));
+    SIM_CHECK(UartLog_Write(pattern + 120, 30));
+    CheckSegment(pattern, 120);
+
+    FakeHal_UartError(&huart2);
+    SIM_CHECK_EQ(FakeHal_GetTxFrames(&huart2), 1);
+
+    FakeHal_UartTxError(&huart2);
+    CheckSegment(pattern, 150);
+    SIM_CHECK_EQ(FakeHal_GetTxFrames(&huart2), 2);
+
+    FakeHal_CompleteTx(&huart2);
+    SIM_CHECK(UartLog_IsIdle());
+
+    UartLogStats_t stats;
+    UartLog_GetStats(&stats);
+    SIM_CHECK_EQ(stats.tx_errors, 1);
+    SIM_CHECK_EQ(stats.sent, 150);
+
+    // DMA空闲时的错误不重发
+    FakeHal_UartTxError(&huart2);
+    SIM_CHECK_EQ(FakeHal_GetTxFrames(&huart2), 2);
+    UartLog_GetStats(&stats);
+    SIM_CHECK_EQ(stats.tx_errors, 1);
+}
+
+int main(void)
+{
+    SIM_RUN(Test_Wraparound);
+    SIM_RUN(Test_DropWhenFull);
+    SIM_RUN(Test_HighWater);
+    SIM_RUN(Test_ErrorRestart);
+    return SIM_RESULT();
+}
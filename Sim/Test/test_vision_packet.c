@@ -0,0 +1,202 @@
+/**
+ * @file test_vision_packet.c
+ * @author Shiki
+ * @brief 视觉数据包测试：旧格式与v2格式经Command_Write、Command_GetCommand、VisionPacket_Update完整解析，
+ *        逐字节到达的分包、校验错误、点数为0、点数超过VISION_MAX_POINTS、长度与点数不一致、帧序号丢失统计
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "command.h"
+#include "fake_hal.h"
+#include "sim_frames.h"
+#include "sim_test.h"
+#include "vision_packet.h"
+
+static const PixelPoint_t corners[VISION_MAX_POINTS] = {
+    {100, 50}, {200, 50}, {200, 150}, {100, 150}};
+
+/**
+ * @brief 写入数据并解析所有完整指令
+ * @return 解析成功的数据包数
+ */
+static uint8_t Feed(const uint8_t *data, uint8_t length)
+{
+    uint8_t cmd[32];
+    uint8_t len;
+    uint8_t parsed = 0;
+    SIM_CHECK_EQ(Command_Write((uint8_t *)data, length), length);
+    while ((len = Command_GetCommand(cmd)) != 0) {
+        if (VisionPacket_Update(cmd, len, Command_GetRxTick())) {
+            parsed++;
+        }
+    }
+    return parsed;
+}
+
+/**
+ * @brief 修改v2帧内容后重新计算CRC
+ */
+static void Resign_V2(uint8_t *frame, uint8_t len)
+{
+    uint16_t crc = SimFrame_Crc16(frame, (uint8_t)(len - 2));
+    frame[len - 2] = (uint8_t)(crc >> 8);
+    frame[len - 1] = (uint8_t)crc;
+}
+
+static void Test_V1(void)
+{
+    FakeHal_Advance(5);
+    uint8_t frame[SIM_FRAME_V1_LEN];
+    SimFrame_V1(frame, 320, 240);
+    SIM_CHECK_EQ(Feed(frame, sizeof(frame)), 1);
+    SIM_CHECK_EQ(g_vision_packet.version, 1);
+    SIM_CHECK(VisionPacket_TargetDetected());
+    SIM_CHECK_EQ(g_vision_packet.points[0].x, 320);
+    SIM_CHECK_EQ(g_vision_packet.points[0].y, 240);
+    SIM_CHECK_EQ(g_vision_packet.rx_tick, HAL_GetTick());
+
+    // (0,0)表示未检测到目标
+    SimFrame_V1(frame, 0, 0);
+    SIM_CHECK_EQ(Feed(frame, sizeof(frame)), 1);
+    SIM_CHECK(!VisionPacket_TargetDetected());
+    PixelPoint_t center = {1, 1};
+    SIM_CHECK(!VisionPacket_GetCenter(&g_vision_packet, &center));
+    SIM_CHECK_EQ(center.x, 1);
+}
+
+static void Test_V2Corners(void)
+{
+    uint8_t frame[64];
+    uint8_t len = SimFrame_V2(frame, 10, 123456, 200, VISION_FLAG_VALID | VISION_FLAG_CORNERS,
+                              corners, VISION_MAX_POINTS);
+    SIM_CHECK_EQ(len, 30);
+    SIM_CHECK_EQ(Feed(frame, len), 1);
+    SIM_CHECK_EQ(g_vision_packet.version, 2);
+    SIM_CHECK_EQ(g_vision_packet.seq, 10);
+    SIM_CHECK_EQ(g_vision_packet.timestamp, 123456);
+    SIM_CHECK_EQ(g_vision_packet.confidence, 200);
+    SIM_CHECK_EQ(g_vision_packet.point_count, VISION_MAX_POINTS);
+    PixelPoint_t center;
+    SIM_CHECK(VisionPacket_GetCenter(&g_vision_packet, &center));
+    SIM_CHECK_EQ(center.x, 150);
+    SIM_CHECK_EQ(center.y, 100);
+
+    // 帧序号11、12丢失
+    VisionPacketStats_t before, after;
+    VisionPacket_GetStats(&before);
+    len = SimFrame_V2(frame, 13, 123516, 200, VISION_FLAG_VALID, corners, 1);
+    SIM_CHECK_EQ(Feed(frame, len), 1);
+    VisionPacket_GetStats(&after);
+    SIM_CHECK_EQ(after.seq_gaps - before.seq_gaps, 2);
+    SIM_CHECK(VisionPacket_GetCenter(&g_vision_packet, &center));
+    SIM_CHECK_EQ(center.x, corners[0].x);
+}
+
+// 数据逐字节到达，最后一个字节（CRC低字节）到达前不能解析出指令
+static void Test_SplitFrames(void)
+{
+    uint8_t frame[64];
+    uint8_t len = SimFrame_V2(frame, 20, 0, 255, VISION_FLAG_VALID, corners, 2);
+    for (uint8_t i = 0; i < len - 1; i++) {
+        SIM_CHECK_EQ(Feed(&frame[i], 1), 0);
+    }
+    SIM_CHECK_EQ(Feed(&frame[len - 1], 1), 1);
+    SIM_CHECK_EQ(g_vision_packet.seq, 20);
+
+    // 两帧首尾相连，从第一帧中间分开写入
+    uint8_t pair[SIM_FRAME_V1_LEN * 2];
+    SimFrame_V1(pair, 11, 22);
+    SimFrame_V1(pair + SIM_FRAME_V1_LEN, 33, 44);
+    SIM_CHECK_EQ(Feed(pair, 3), 0);
+    SIM_CHECK_EQ(Feed(pair + 3, sizeof(pair) - 3), 2);
+    SIM_CHECK_EQ(g_vision_packet.points[0].x, 33);
+}
+
+// 校验错误的帧被丢弃，不影响紧随其后的有效帧
+static void Test_BadChecksum(void)
+{
+    VisionPacket_t last = g_vision_packet;
+    uint8_t frame[64];
+    uint8_t len = SimFrame_V2(frame, 30, 0, 255, VISION_FLAG_VALID, corners, 3);
+    frame[len - 1] ^= 0x01;
+    SIM_CHECK_EQ(Feed(frame, len), 0);
+    SIM_CHECK_EQ(g_vision_packet.seq, last.seq);
+
+    uint8_t v1[SIM_FRAME_V1_LEN];
+    SimFrame_V1(v1, 55, 66);
+    v1[SIM_FRAME_V1_LEN - 1]++;
+    SIM_CHECK_EQ(Feed(v1, sizeof(v1)), 0);
+
+    len = SimFrame_V2(frame, 31, 0, 255, VISION_FLAG_VALID, corners, 1);
+    SIM_CHECK_EQ(Feed(frame, len), 1);
+    SIM_CHECK_EQ(g_vision_packet.seq, 31);
+}
+
+// 点数为0：即使设置了有效标志也不认为检测到目标
+static void Test_ZeroCount(void)
+{
+    uint8_t frame[64];
+    uint8_t len = SimFrame_V2(frame, 40, 0, 255, VISION_FLAG_VALID, corners, 0);
+    SIM_CHECK_EQ(len, VISION_PACKET_V2_HEAD_LEN + VISION_PACKET_V2_CRC_LEN);
+    SIM_CHECK_EQ(Feed(frame, len), 1);
+    SIM_CHECK_EQ(g_vision_packet.point_count, 0);
+    SIM_CHECK(!VisionPacket_TargetDetected());
+    PixelPoint_t center;
+    SIM_CHECK(!VisionPacket_GetCenter(&g_vision_packet, &center));
+}
+
+static void Test_CountTooLarge(void)
+{
+    VisionPacketStats_t before, after;
+    PixelPoint_t points[VISION_MAX_POINTS + 1] = {{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
+    uint8_t frame[64];
+
+    // 5个点的帧长34字节，超过指令最大长度，帧同步时已丢弃
+    uint8_t len = SimFrame_V2(frame, 50, 0, 255, VISION_FLAG_VALID, points, VISION_MAX_POINTS + 1);
+    SIM_CHECK_EQ(len, 34);
+    SIM_CHECK_EQ(Feed(frame, len), 0);
+    // 直接解析同样拒绝
+    VisionPacket_t packet;
+    SIM_CHECK(!VisionPacket_Parse(frame, len, &packet));
+
+    // 点数字节大于VISION_MAX_POINTS但帧长合法：校验通过，内容不合法
+    VisionPacket_GetStats(&before);
+    len = SimFrame_V2(frame, 51, 0, 255, VISION_FLAG_VALID, points, VISION_MAX_POINTS);
+    frame[11] = VISION_MAX_POINTS + 1;
+    Resign_V2(frame, len);
+    SIM_CHECK_EQ(Feed(frame, len), 0);
+    VisionPacket_GetStats(&after);
+    SIM_CHECK_EQ(after.invalid - before.invalid, 1);
+    SIM_CHECK(g_vision_packet.seq != 51);
+
+    // 点数与帧长不一致
+    len = SimFrame_V2(frame, 52, 0, 255, VISION_FLAG_VALID, points, 3);
+    frame[11] = 2;
+    Resign_V2(frame, len);
+    SIM_CHECK_EQ(Feed(frame, len), 0);
+    VisionPacket_GetStats(&after);
+    SIM_CHECK_EQ(after.invalid - before.invalid, 2);
+
+    // 版本字节错误
+    len = SimFrame_V2(frame, 53, 0, 255, VISION_FLAG_VALID, points, 1);
+    frame[2] = 0x03;
+    Resign_V2(frame, len);
+    SIM_CHECK_EQ(Feed(frame, len), 0);
+}
+
+int main(void)
+{
+    FakeHal_Reset();
+    SIM_RUN(Test_V1);
+    SIM_RUN(Test_V2Corners);
+    SIM_RUN(Test_SplitFrames);
+    SIM_RUN(Test_BadChecksum);
+    SIM_RUN(Test_ZeroCount);
+    SIM_RUN(Test_CountTooLarge);
+    return SIM_RESULT();
+}